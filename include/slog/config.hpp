@@ -0,0 +1,102 @@
+#ifndef __SLOG_CONFIG_H__
+#define __SLOG_CONFIG_H__
+
+/**
+ * @file config.hpp
+ * @author LiuChuansen (179712066@qq.com)
+ * @brief 日志配置文件（INI 格式）加载与热更新
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <functional>
+#include <string>
+
+#include "slog/slog.hpp"
+
+namespace slog {
+
+/**
+ * @brief 从配置文件加载 sink、logger 和日志等级规则
+ *
+ * 配置文件为 INI 格式，行首或空白之后的 '#'、';' 开始注释：
+ * @code
+ * [rules]                      # 全局等级规则，同 apply_logger_rules()
+ * net_*  = debug
+ * ^db_.* = trace
+ *
+ * [sink.console]
+ * type  = stdout               # stdout / file / json_file / syslog / journal / none
+ * level = info
+ *
+ * [sink.main]
+ * type      = file
+ * path      = /var/log/app-%Y%m%d.log   # 支持 format_log_filename() 的占位符
+ * level     = debug
+ * max_size  = 10M              # 轮转大小，支持 K/M/G 后缀，0 表示不轮转
+ * max_files = 5
+ * flush     = true
+ * index     = true             # 写入时间索引 <path>.idx，供 slog_cat 按时间段读取
+ * isolated  = true             # 在独立线程中输出（sink::Isolated），可用 queue_size 设置队列长度
+ *
+ * [logger.app]
+ * sinks   = console, main
+ * level   = info               # 等价于规则 app = info
+ * default = true               # 设为默认 logger
+ * @endcode
+ *
+ * 整个文件先完整解析和校验，有任何错误都不会应用任何内容。加载成功后：
+ * - [rules] 与各 logger 的 level 通过 update_logger_level_rules() 替换上一次加载的配置规则，
+ *   SLOG_LEVEL、--slog-level 和控制端点设置的规则保留（与配置中 pattern 相同的规则以后设置的为准）；
+ * - 尚不存在的 logger 按声明创建并注册；已存在的 logger 保留原有 sink，只接受新的等级；
+ * - 多个 logger 引用同一个 [sink.x] 时，各 logger 得到该 sink 的 clone()，等级各自独立；
+ *   写入同一文件的 sink 共享文件状态，sink::Net 的克隆共享连接，isolated 的 sink 每个 logger 一个队列。
+ *
+ * 因此重新加载可以随时调整等级，修改 sink 或轮转参数只对新创建的 logger 生效。
+ *
+ * @param path 配置文件路径
+ * @return true 加载成功
+ * @return false 文件无法读取或格式错误（错误信息输出到 stderr）
+ */
+bool load_config(std::string const & path);
+
+/**
+ * @brief 从字符串加载配置，格式同 load_config()
+ *
+ * @param text 配置内容
+ * @return true 加载成功
+ */
+bool load_config_text(std::string const & text);
+
+#if defined(__linux__)
+/**
+ * @brief 监视配置文件，文件被修改或替换时自动重新加载
+ *
+ * 使用 inotify 监视文件所在目录，因此编辑器“写临时文件再重命名”的保存方式同样能被发现。
+ * 短时间内的多次修改合并为一次加载。只监视，不做首次加载：
+ * @code
+ * slog::load_config("/etc/app/slog.conf");
+ * slog::watch_config("/etc/app/slog.conf");
+ * @endcode
+ *
+ * 同一时刻只监视一个文件，再次调用会替换之前的监视。
+ *
+ * @param path 配置文件路径
+ * @param on_reload 每次重新加载后在监视线程中调用，参数为加载是否成功
+ * @return true 开始监视
+ * @return false inotify 不可用或目录不存在
+ */
+bool watch_config(std::string const & path, std::function<void(bool)> on_reload = nullptr);
+
+/**
+ * @brief 停止监视配置文件
+ */
+void unwatch_config();
+#endif // __linux__
+
+} // namespace slog
+
+#endif // __SLOG_CONFIG_H__
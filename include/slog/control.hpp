@@ -0,0 +1,80 @@
+#ifndef __SLOG_CONTROL_H__
+#define __SLOG_CONTROL_H__
+
+/**
+ * @file control.hpp
+ * @author LiuChuansen (179712066@qq.com)
+ * @brief 运行时控制端点（Unix 域套接字），配合 slogctl 在不重启进程的情况下查看和调整日志
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <string>
+
+#include "slog/slog.hpp"
+
+namespace slog {
+
+/**
+ * @brief 默认的控制套接字路径
+ *
+ * $XDG_RUNTIME_DIR/slog-<pid>.sock，未设置 XDG_RUNTIME_DIR 时为 /tmp/slog-<pid>.sock
+ *
+ * @param pid 进程号
+ */
+std::string default_control_socket_path(long pid);
+
+/**
+ * @brief 启动控制端点
+ *
+ * 在后台线程中监听 Unix 域流套接字（权限 0600，只允许同一用户访问），每个连接发送一行命令，
+ * 收到以 "OK" 或 "ERR <原因>" 开头的文本回复后连接关闭。支持的命令：
+ *
+ * | 命令 | 说明 |
+ * |------|------|
+ * | `list` | 列出所有 logger 及其生效等级 |
+ * | `get <name>` | 查询 logger 的生效等级 |
+ * | `set <pattern> <level>` | 设置等级规则，同 set_logger_level() |
+ * | `apply <rules>` | 应用规则文本，同 apply_logger_rules() |
+ * | `rules` | 列出全部规则 |
+ * | `clear-rules` | 清除全部规则（已生效的等级不变） |
+ * | `flush [name]` | 刷新指定或全部 logger |
+ * | `stats [name]` | 列出 logger 的各个 sink、等级和运行统计 |
+ *
+ * 不启动时没有任何开销；启动后只有一个阻塞在 poll() 上的线程，日志路径不受影响。
+ *
+ * @code
+ * slog::start_control_server();   // 使用 default_control_socket_path(getpid())
+ * @endcode
+ * @code{.sh}
+ * slogctl -p 1234 set "net_*" debug
+ * @endcode
+ *
+ * @param socket_path 套接字路径，为空时使用默认路径；路径上已存在的套接字文件会被替换
+ * @return true 启动成功（已在运行时先停止旧的端点）
+ * @return false 创建或绑定套接字失败
+ */
+bool start_control_server(std::string const & socket_path = std::string());
+
+/**
+ * @brief 停止控制端点并删除套接字文件
+ */
+void stop_control_server();
+
+/**
+ * @brief 向控制端点发送一条命令（slogctl 使用）
+ *
+ * @param socket_path 套接字路径
+ * @param command 命令行，不含换行
+ * @param response 完整回复
+ * @return true 收到回复（回复本身可能是 ERR）
+ * @return false 连接或通信失败
+ */
+bool control_request(std::string const & socket_path, std::string const & command, std::string *response);
+
+} // namespace slog
+
+#endif // __SLOG_CONTROL_H__
@@ -12,6 +12,8 @@
  * 
  */
 
+#include <chrono>
+#include <cstdint>
 #include <fstream>
 #include <memory>
 #include <string>
@@ -21,6 +23,27 @@
 namespace slog {
 namespace sink {
 
+/**
+ * @brief 时间索引文件的一条记录：日志文件中 offset 之前各行的日志时间都不晚于 timestamp_ms
+ *
+ * 晚写入的日志（Batch、Isolated 队列积压、等锁的线程）时间可能早于它前面的行，
+ * 写入时比当时已写入的最晚日志时间早多少记为滞后，max_lag_ms 是到这条记录为止的最大滞后。
+ * 滞后变大时总会新增一条记录，因此文件最后一条记录的 max_lag_ms 覆盖整个文件：
+ * timestamp_ms 超过 T + max_lag_ms 的记录之后不再有时间不晚于 T 的行。
+ *
+ * 索引文件（日志文件名加 ".idx"）以 8 字节的 kTimeIndexMagic 开头，之后是定长记录，
+ * 只追加、不修改，按本机字节序存储
+ */
+struct TimeIndexEntry
+{
+    int64_t timestamp_ms;   ///< offset 处及之前各行日志时间的最大值，system_clock 自 epoch 起的毫秒数，不减
+    uint64_t offset;        ///< 日志行在日志文件中的字节偏移
+    int64_t max_lag_ms;     ///< 当前文件中到 offset 处这一块为止各行的最大滞后毫秒数，不减
+};
+
+/// 索引文件头
+constexpr char kTimeIndexMagic[8] = {'S', 'L', 'O', 'G', 'I', 'D', 'X', '2'};
+
 /**
  * @brief 共享的文件状态，所有写入同一文件的sink共享此对象
  */
@@ -32,6 +55,15 @@ struct SharedFileState
     size_t max_files = 0;
     bool flush_on_write = true;
     std::string filepath;
+
+    // 时间索引，index_every_bytes 为 0 表示未开启
+    std::ofstream index;
+    size_t index_every_bytes = 0;
+    int64_t index_every_ms = 0;
+    size_t last_index_offset = 0;
+    int64_t last_index_ms = -1;     ///< -1 表示当前文件还没有索引记录
+    int64_t latest_ms = -1;         ///< 已写入各行日志时间的最大值
+    int64_t max_lag_ms = 0;         ///< 当前文件各行的最大滞后，见 TimeIndexEntry
     
     SharedFileState(std::string const & path, size_t max_size, size_t max_file_count, bool flush);
 };
@@ -78,18 +110,73 @@ public:
 
     const char* name() const override;
 
+    /**
+     * @brief 开启时间索引
+     *
+     * 在日志文件旁写入 "<filepath>.idx"：每写入 every_bytes 字节或每隔 every 时间记录一条
+     * (时间戳, 字节偏移)，每条 16 字节，轮转时随日志文件一起改名。slog_cat 据此二分查找，
+     * 只读取指定时间段的日志。写入同一文件的 sink 共享索引，任意一个开启即生效。
+     *
+     * @param every_bytes 两条索引记录之间的最大字节数，默认 64KB
+     * @param every 两条索引记录之间的最长时间，默认 1 秒
+     */
+    void enable_time_index(size_t every_bytes = 64 * 1024,
+                           std::chrono::milliseconds every = std::chrono::seconds(1));
+
+    /// @brief 刷新共享的文件流（flush_on_write 为 false 时有用）
+    void flush() override;
+
     ~File();
 
+    /**
+     * @brief 向日志行追加时间戳、等级和 logger 名称
+     * 
+     * 与 write_line() 配合，供需要把消息直接格式化进日志行的调用方使用（如 StaticFile）
+     */
+    static void append_header(detail::LineBuffer & line, fmt::string_view logger_name, LogLevel level);
+
+    /**
+     * @brief 结束日志行（换行）并写入文件，按需执行rotation
+     * 
+     * 必须在 setup() 成功之后调用
+     */
+    void write_line(detail::LineBuffer & line);
+
 protected:
     void output(const std::string & logger_name, LogLevel level, std::string const &msg) override;
 
-private:
+    /// 字段以文本 " key=value" 直接追加到日志行缓冲区
+    void output_fields(const std::string & logger_name, LogLevel level, fmt::string_view msg, FieldList fields) override;
+
+    /// 整批格式化到一块缓冲区，加一次锁写入，轮转和索引按行边界切分
+    void output_batch(const std::string & logger_name, Batch const & batch, LogLevel level) override;
+
+    /// 向 line 追加一条完整的日志行（不含换行），output_batch() 使用；JsonFile 重写为 JSON 对象
+    virtual void append_line(detail::LineBuffer & line, fmt::string_view logger_name, LogLevel level, fmt::string_view msg);
+
+protected:
     std::string filepath_;
     size_t max_file_size_;
     size_t max_files_;
     bool flush_on_write_;
+    size_t index_every_bytes_ = 0;
+    std::chrono::milliseconds index_every_{0};
+
+private:
     std::shared_ptr<SharedFileState> file_state_;
 
+    /**
+     * @brief 写入若干完整的行，按需执行rotation和记录索引（min_ms/max_ms 为这些行日志时间的范围，epoch 毫秒）
+     * 注意：调用此函数前必须已获取file_mutex
+     */
+    void write_locked(const char *data, size_t size, int64_t min_ms, int64_t max_ms);
+
+    /**
+     * @brief 打开索引文件（不存在时创建并写入文件头）
+     * 注意：调用此函数前必须已获取file_mutex
+     */
+    void open_index();
+
     /**
      * @brief 获取文件路径对应的全局 mutex
      * 
@@ -107,11 +194,6 @@ private:
     static std::shared_ptr<SharedFileState> get_shared_file_state(
         std::string const & filepath, size_t max_file_size, size_t max_files, bool flush_on_write);
 
-    /**
-     * @brief 格式化日志消息
-     */
-    std::string format_log_message(const std::string & logger_name, LogLevel level, std::string const &msg);
-
     /**
      * @brief 执行文件rotation
      * 
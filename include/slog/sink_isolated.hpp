@@ -0,0 +1,163 @@
+#ifndef __SLOG_SINK_ISOLATED_H__
+#define __SLOG_SINK_ISOLATED_H__
+
+/**
+ * @file sink_isolated.hpp
+ * @author LiuChuansen (179712066@qq.com)
+ * @brief Isolated Sink实现（子 sink 在独立线程中输出，慢 sink 不拖慢其他 sink）
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "slog/slog.hpp"
+
+namespace slog {
+namespace sink {
+
+/**
+ * @brief Isolated Sink 的运行统计
+ */
+struct IsolatedStats
+{
+    /// 进入队列的记录数
+    uint64_t enqueued = 0;
+    /// 已交给子 sink 的记录数
+    uint64_t processed = 0;
+    /// 队列满而丢弃的记录数
+    uint64_t dropped = 0;
+    /// 当前排队的记录数
+    size_t queue_depth = 0;
+    /// 最近一条记录从入队到子 sink 输出完成的延迟（微秒）
+    uint64_t last_lag_us = 0;
+    /// 观察到的最大延迟（微秒）
+    uint64_t max_lag_us = 0;
+};
+
+/**
+ * @brief Isolated Sink
+ *
+ * 包装一个子 sink，为它提供私有的有界队列和工作线程：
+ * @code
+ * std::vector<std::shared_ptr<slog::LoggerSink>> sinks;
+ * sinks.push_back(std::make_shared<slog::sink::Stdout>(slog::LogLevel::Info));
+ * sinks.push_back(std::make_shared<slog::sink::Isolated>(
+ *     std::make_shared<slog::sink::File>(slog::LogLevel::Info, "/mnt/nfs/app.log")));
+ * auto logger = slog::make_logger("app", sinks);
+ * @endcode
+ *
+ * 调用线程只把消息（及结构化字段的副本）放入队列，子 sink 的输出在工作线程中进行；
+ * 子 sink 变慢时只会积压或丢弃自己的记录，同一 logger 的其他 sink 不受影响。
+ * 队列满时丢弃新记录并计数，不阻塞调用线程。
+ *
+ * Isolated 的初始等级取子 sink 的等级，之后的等级修改（含全局规则）同步给子 sink；
+ * 子 sink 的等级在入队前再检查一次。
+ */
+class Isolated: public LoggerSink
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param child 子 sink
+     * @param queue_size 队列长度（条），默认 8192
+     */
+    explicit Isolated(std::shared_ptr<LoggerSink> child, size_t queue_size = 8192);
+
+    ~Isolated();
+
+    std::shared_ptr<LoggerSink> clone(const std::string & logger_name) const override;
+
+    bool setup(const std::string & logger_name) override;
+
+    const char* name() const override;
+
+    /// @brief 子 sink
+    std::shared_ptr<LoggerSink> const & child() const noexcept { return child_; }
+
+    /// @brief 当前统计
+    IsolatedStats stats() const;
+
+    /// @brief 队列满而丢弃的记录数
+    uint64_t dropped() const;
+
+    /**
+     * @brief 等待队列中的记录全部交给子 sink
+     * @param timeout 最长等待时间
+     * @return true 队列已清空
+     */
+    bool flush(std::chrono::milliseconds timeout);
+
+    /// @brief 最多等待 1 秒让队列清空，再刷新子 sink
+    void flush() override;
+
+    /// @brief 追加 enqueued、processed、dropped、queue_depth、max_lag_us
+    void append_stats(std::string & out) const override;
+
+protected:
+    void output(const std::string & logger_name, LogLevel level, std::string const &msg) override;
+
+    /// 字段连同键名和字符串值一起复制进队列，由子 sink 在工作线程中按自己的编码序列化
+    void output_fields(const std::string & logger_name, LogLevel level, fmt::string_view msg, FieldList fields) override;
+
+    /// 等级变化同步给子 sink
+    void on_level_changed(LogLevel level) override;
+
+private:
+    /// 队列槽位，预分配并复用，字符串容量在稳态下不再增长
+    struct Entry
+    {
+        /// 绑定 logger 的驻留名称；其他名称复制到 name_copy
+        std::string const *name = nullptr;
+        std::string name_copy;
+        LogLevel level = LogLevel::Info;
+        std::string msg;
+        /// 字段的键名和字符串值
+        std::string storage;
+        std::vector<Field> fields;
+        bool has_fields = false;
+        std::chrono::steady_clock::time_point enqueued;
+        /// 调用线程中的日志时间，工作线程输出时恢复
+        detail::Timestamp timestamp;
+        /// 调用线程的 id 和名称
+        detail::ThreadInfo thread;
+    };
+
+    std::shared_ptr<LoggerSink> child_;
+    size_t queue_size_;
+    std::string const *bound_name_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable not_empty_;
+    std::condition_variable idle_;
+    std::vector<Entry> slots_;
+    size_t head_;
+    /// 已入队的记录数，包括工作线程正在处理的记录（处理完才释放槽位）
+    size_t count_;
+    bool stopping_;
+    IsolatedStats stats_;
+    std::thread worker_;
+
+    /// 取得一个空槽位（需持有 mutex_），队列满时返回 nullptr
+    Entry *acquire_slot(const std::string & logger_name, LogLevel level);
+
+    /// 入队完成，唤醒工作线程（需持有 mutex_）
+    void commit_slot();
+
+    void run();
+};
+
+} // namespace sink
+} // namespace slog
+
+#endif // __SLOG_SINK_ISOLATED_H__
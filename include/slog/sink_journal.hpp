@@ -0,0 +1,99 @@
+#ifndef __SLOG_SINK_JOURNAL_H__
+#define __SLOG_SINK_JOURNAL_H__
+
+/**
+ * @file sink_journal.hpp
+ * @author LiuChuansen (179712066@qq.com)
+ * @brief systemd journal Sink实现（原生协议，不依赖 libsystemd）
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "slog/slog.hpp"
+
+namespace slog {
+namespace sink {
+
+/**
+ * @brief systemd journal Sink
+ *
+ * 使用 journal 原生协议，把每条日志作为一个数据报发给 journald 套接字，字段分别发送：
+ * - MESSAGE：日志消息
+ * - PRIORITY：syslog severity（与 sink::Syslog 的映射相同）
+ * - SYSLOG_IDENTIFIER：logger 名称
+ * - CODE_FILE/CODE_LINE/CODE_FUNC：通过 SLOG_* 宏输出时的源码位置
+ * - 结构化字段：键名转换为 journal 字段名（大写字母、数字、下划线）
+ *
+ * 包含换行的值（如 log_data 的十六进制输出）使用二进制安全的长度前缀编码。
+ * 数据报超过 memfd_threshold 或被内核拒绝（EMSGSIZE）时，内容写入一个密封的 memfd，
+ * 只通过套接字传递文件描述符。
+ *
+ * 套接字不加锁：每条日志只调用一次 sendto/sendmsg，数据报本身是原子的。
+ * journald 来不及接收或不可用时丢弃消息并计数，不阻塞调用线程。
+ */
+class Journal: public LoggerSink
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param level 日志等级
+     * @param socket_path journald 原生协议套接字路径
+     */
+    explicit Journal(LogLevel level, std::string const & socket_path = "/run/systemd/journal/socket");
+
+    ~Journal();
+
+    std::shared_ptr<LoggerSink> clone(const std::string & logger_name) const override;
+
+    bool setup(const std::string & logger_name) override;
+
+    const char* name() const override;
+
+    /// @brief 因 journald 来不及接收或不可用而丢弃的消息数量
+    uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+    /// @brief 追加 dropped
+    void append_stats(std::string & out) const override;
+
+    /// @brief 超过此大小（字节）的记录通过 memfd 发送，默认 16KB
+    void set_memfd_threshold(size_t size) { memfd_threshold_ = size; }
+
+    /**
+     * @brief 追加一个 journal 字段
+     *
+     * 值不含换行时为 "KEY=value\n"，否则为 "KEY\n" + 64 位小端长度 + value + "\n"
+     */
+    static void append_field(detail::LineBuffer & buf, fmt::string_view key, fmt::string_view value);
+
+protected:
+    void output(const std::string & logger_name, LogLevel level, std::string const &msg) override;
+
+    void output_fields(const std::string & logger_name, LogLevel level, fmt::string_view msg, FieldList fields) override;
+
+private:
+    std::string socket_path_;
+    size_t memfd_threshold_;
+    int fd_;
+    std::atomic<uint64_t> dropped_;
+
+    /// 追加 MESSAGE 之外的公共字段
+    void append_common(detail::LineBuffer & buf, fmt::string_view logger_name, LogLevel level);
+
+    /// 发送一条记录，必要时改用 memfd
+    void send_record(detail::LineBuffer const & buf);
+
+    /// 通过密封的 memfd 发送
+    bool send_memfd(detail::LineBuffer const & buf);
+};
+
+} // namespace sink
+} // namespace slog
+
+#endif // __SLOG_SINK_JOURNAL_H__
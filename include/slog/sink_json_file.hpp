@@ -0,0 +1,93 @@
+#ifndef __SLOG_SINK_JSON_FILE_H__
+#define __SLOG_SINK_JSON_FILE_H__
+
+/**
+ * @file sink_json_file.hpp
+ * @author LiuChuansen (179712066@qq.com)
+ * @brief JSON Lines 文件 Sink实现
+ * @version 0.1
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <memory>
+#include <string>
+#include "slog/slog.hpp"
+#include "slog/sink_file.hpp"
+
+namespace slog {
+
+namespace detail {
+
+/**
+ * @brief 追加一个带双引号的 JSON 字符串
+ * 
+ * 转义 '"'、'\\' 和控制字符；支持 SSE2/NEON 时每次检查 16 字节，
+ * 不需要转义的片段整段拷贝。非 ASCII 字节原样输出（不校验 UTF-8）。
+ */
+void append_json_string(LineBuffer &buf, fmt::string_view str);
+
+/// @brief 以 JSON 对象成员的形式追加字段："key":value,...（不含外层花括号）
+void append_fields_json(LineBuffer &buf, FieldList fields);
+
+} // namespace detail
+
+namespace sink {
+
+/**
+ * @brief JSON Lines 文件 Sink
+ * 
+ * 每条日志输出一行 JSON 对象：
+ * {"ts":"2026-10-17T14:12:55.406","level":"INFO","logger":"app","thread":1234,"msg":"...","fields":{...}}
+ * 
+ * - 文件、mutex 和rotation与 sink::File 共用同一套共享文件状态
+ * - 结构化字段放在 "fields" 对象中，没有字段时省略
+ * - 整行在 256 字节内联的日志行缓冲区中拼接，不使用通用 JSON 库
+ */
+class JsonFile: public File
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param level 日志等级
+     * @param filepath 日志文件路径
+     * @param max_file_size 最大文件大小（字节），0表示无限制，默认10MB
+     * @param max_files 保留的旧日志文件数量，默认5个
+     * @param flush_on_write 是否每次写入后立即刷新，默认true
+     */
+    explicit JsonFile(LogLevel level, 
+                      std::string const & filepath,
+                      size_t max_file_size = 10 * 1024 * 1024,  // 10MB
+                      size_t max_files = 5,
+                      bool flush_on_write = true)
+        : File(level, filepath, max_file_size, max_files, flush_on_write)
+    {
+    }
+
+    std::shared_ptr<LoggerSink> clone(const std::string & logger_name) const override;
+
+    const char* name() const override;
+
+    /**
+     * @brief 向日志行追加 JSON 对象的公共成员（时间戳、等级、logger、线程、消息）
+     * 
+     * 不含结尾的 '}'，调用方可以继续追加字段
+     */
+    static void append_record(detail::LineBuffer & line, fmt::string_view logger_name, LogLevel level, fmt::string_view msg);
+
+protected:
+    void output(const std::string & logger_name, LogLevel level, std::string const &msg) override;
+
+    /// 字段以 "fields":{...} 对象输出
+    void output_fields(const std::string & logger_name, LogLevel level, fmt::string_view msg, FieldList fields) override;
+
+    /// 批量输出时每条记录为一个 JSON 对象
+    void append_line(detail::LineBuffer & line, fmt::string_view logger_name, LogLevel level, fmt::string_view msg) override;
+};
+
+} // namespace sink
+} // namespace slog
+
+#endif // __SLOG_SINK_JSON_FILE_H__
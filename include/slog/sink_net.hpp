@@ -0,0 +1,140 @@
+#ifndef __SLOG_SINK_NET_H__
+#define __SLOG_SINK_NET_H__
+
+/**
+ * @file sink_net.hpp
+ * @author LiuChuansen (179712066@qq.com)
+ * @brief 网络 Sink实现（TCP/UDP，批量发送，断线重连）
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "slog/slog.hpp"
+
+namespace slog {
+namespace sink {
+
+/**
+ * @brief 网络传输协议
+ */
+enum class NetProtocol
+{
+    Tcp,    ///< 长度前缀的帧，每帧一批记录
+    Udp,    ///< 每个数据报装入尽量多的完整记录
+};
+
+/**
+ * @brief 网络 Sink 配置
+ */
+struct NetOptions
+{
+    /// 每批最多记录数，达到后立即发送
+    size_t batch_records = 256;
+    /// 每批（TCP 每帧）最大字节数，达到后立即发送
+    size_t batch_bytes = 64 * 1024;
+    /// 批次未满时，第一条记录最多等待的时间
+    std::chrono::milliseconds flush_interval{100};
+    /// 未发送记录的缓冲上限（字节），断线或对端来不及接收时超出部分被丢弃并计数
+    size_t spill_bytes = 4 * 1024 * 1024;
+    /// UDP 数据报的最大长度，默认不超过以太网 MTU
+    size_t max_datagram_size = 1400;
+    /// 重连的初始间隔，每次失败翻倍
+    std::chrono::milliseconds reconnect_min{100};
+    /// 重连的最大间隔
+    std::chrono::milliseconds reconnect_max{30000};
+    /// 析构时等待剩余记录发送的最长时间
+    std::chrono::milliseconds linger{1000};
+    /// 每批使用 LZ4 压缩（编译时未找到 LZ4 时忽略）
+    bool compress = false;
+};
+
+/**
+ * @brief 网络 Sink
+ *
+ * 调用线程只把记录（与 File Sink 相同的文本行）追加到待发送缓冲区，
+ * 由后台发送线程按记录数、字节数或时间凑成批次，通过非阻塞套接字发出。
+ *
+ * 线路格式：
+ * - TCP：每批一帧，"4 字节大端长度" + "1 字节标志" + 数据；长度不含自身。
+ *   标志 bit0 为 1 时数据为 "4 字节大端原始长度" + LZ4 block，否则为原始记录
+ * - UDP：每个数据报装入尽量多的完整记录（超长记录单独发送）；
+ *   启用压缩时每个数据报前同样带 1 字节标志，压缩格式与 TCP 相同
+ *
+ * 连接失败或断开后按指数退避（reconnect_min ~ reconnect_max）重连，期间记录保存在
+ * 有上限的缓冲区中，超出 spill_bytes 的记录被丢弃并计入 dropped()。
+ * 断线时正在发送的帧会在新连接上从帧首重发，不会出现半条记录。
+ *
+ * clone() 得到的 sink 与原 sink 共享同一个连接和发送线程。
+ */
+class Net: public LoggerSink
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param level 日志等级
+     * @param host 目标主机名或地址
+     * @param port 目标端口
+     * @param protocol 传输协议，默认 TCP
+     * @param options 批量、缓冲和重连配置
+     */
+    Net(LogLevel level,
+        std::string const & host,
+        uint16_t port,
+        NetProtocol protocol = NetProtocol::Tcp,
+        NetOptions const & options = NetOptions());
+
+    ~Net();
+
+    std::shared_ptr<LoggerSink> clone(const std::string & logger_name) const override;
+
+    bool setup(const std::string & logger_name) override;
+
+    const char* name() const override;
+
+    /// @brief 因缓冲区满、对端拒绝或析构时未能发出而丢弃的记录数量
+    uint64_t dropped() const noexcept;
+
+    /// @brief 已交给内核发送的记录数量
+    uint64_t sent() const noexcept;
+
+    /// @brief 断线后重新连接成功的次数
+    uint64_t reconnects() const noexcept;
+
+    /// @brief 请求发送线程立即发送当前批次，不等待发送完成
+    void flush() override;
+
+    /// @brief 追加 sent、dropped、reconnects
+    void append_stats(std::string & out) const override;
+
+    /// @brief 编译时是否启用了 LZ4 压缩支持
+    static bool compression_supported() noexcept;
+
+protected:
+    void output(const std::string & logger_name, LogLevel level, std::string const &msg) override;
+
+    /// 字段以文本 " key=value" 追加到消息后
+    void output_fields(const std::string & logger_name, LogLevel level, fmt::string_view msg, FieldList fields) override;
+
+private:
+    class Channel;
+
+    std::string host_;
+    uint16_t port_;
+    NetProtocol protocol_;
+    NetOptions options_;
+    /// 连接和发送线程，clone 出的 sink 共享
+    std::shared_ptr<Channel> channel_;
+};
+
+} // namespace sink
+} // namespace slog
+
+#endif // __SLOG_SINK_NET_H__
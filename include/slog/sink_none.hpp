@@ -46,6 +46,15 @@ protected:
         (void)level;  // 避免未使用参数警告
         (void)msg;    // 避免未使用参数警告
     }
+
+    void output_fields(const std::string & logger_name, LogLevel level, fmt::string_view msg, FieldList fields) override
+    {
+        // 空实现，字段不做序列化
+        (void)logger_name;
+        (void)level;
+        (void)msg;
+        (void)fields;
+    }
 };
 
 } // namespace sink
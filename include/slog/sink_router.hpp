@@ -0,0 +1,117 @@
+#ifndef __SLOG_SINK_ROUTER_H__
+#define __SLOG_SINK_ROUTER_H__
+
+/**
+ * @file sink_router.hpp
+ * @author LiuChuansen (179712066@qq.com)
+ * @brief Router Sink实现（按等级和 logger 名称把日志分发给子 sink）
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "slog/slog.hpp"
+
+namespace slog {
+namespace sink {
+
+/**
+ * @brief Router Sink
+ *
+ * 持有多个子 sink，每条路由由“子 sink + 最低等级 + logger 名称通配符”组成：
+ * @code
+ * auto router = std::make_shared<slog::sink::Router>();
+ * router->add_route(alert_file, slog::LogLevel::Error);          // Error 以上写告警文件
+ * router->add_route(main_file);                                  // 全部写主文件
+ * router->add_route(net_file, slog::LogLevel::Trace, "net_*");   // net_* logger 写单独文件
+ * @endcode
+ *
+ * setup() 时按绑定的 logger 名称预先计算路由表：每个等级一个位掩码，第 i 位表示第 i 条路由接收该等级。
+ * 输出时按等级取出掩码，只遍历被置位的子 sink，不调用会拒绝这条日志的子 sink。
+ * 路由等级会与子 sink 自身的等级合并（取较高者），之后修改子 sink 等级需要调用 rebuild()。
+ *
+ * 每个 Router 绑定一个 logger（clone() 为新 logger 克隆全部子 sink 并重新计算路由表）；
+ * 同一个 Router 被其他名称的 logger 使用时，退化为逐条匹配路由。
+ * 最多支持 64 条路由。
+ */
+class Router: public LoggerSink
+{
+public:
+    /// 最多路由条数（路由表掩码的位数）
+    static constexpr size_t kMaxRoutes = 64;
+
+    /**
+     * @brief 构造函数
+     * @param level Router 自身的等级，低于此等级的日志不会进入路由表
+     */
+    explicit Router(LogLevel level = LogLevel::Trace);
+
+    /**
+     * @brief 添加一条路由，需在 logger 创建前添加
+     * @param sink 子 sink
+     * @param level 该路由接收的最低等级
+     * @param logger_pattern logger 名称通配符，支持 '*' 和 '?'，默认匹配全部
+     * @return false 路由已满或 sink 为空
+     */
+    bool add_route(std::shared_ptr<LoggerSink> sink, LogLevel level = LogLevel::Trace,
+                   std::string const & logger_pattern = "*");
+
+    /// @brief 路由条数
+    size_t route_count() const noexcept { return routes_.size(); }
+
+    /// @brief 绑定的 logger 在指定等级上的路由掩码（第 i 位为第 i 条路由）
+    uint64_t route_mask(LogLevel level) const noexcept;
+
+    /// @brief 子 sink 等级变化后重新计算路由表
+    void rebuild();
+
+    std::shared_ptr<LoggerSink> clone(const std::string & logger_name) const override;
+
+    bool setup(const std::string & logger_name) override;
+
+    const char* name() const override;
+
+    /// @brief 刷新全部子 sink
+    void flush() override;
+
+protected:
+    void output(const std::string & logger_name, LogLevel level, std::string const &msg) override;
+
+    /// 字段原样交给子 sink，由各子 sink 按自己的编码序列化
+    void output_fields(const std::string & logger_name, LogLevel level, fmt::string_view msg, FieldList fields) override;
+
+private:
+    struct Route
+    {
+        std::shared_ptr<LoggerSink> sink;
+        LogLevel level;
+        std::string pattern;
+    };
+
+    /// Trace ~ Error 五个等级
+    static constexpr int kLevelCount = static_cast<int>(LogLevel::Off);
+
+    std::vector<Route> routes_;
+    /// 绑定的 logger 名称（驻留字符串，地址稳定），用于输出时快速确认路由表适用
+    std::string const *bound_name_;
+    /// 路由表：按等级索引的子 sink 位掩码
+    uint64_t table_[kLevelCount];
+
+    /// 计算指定 logger 在指定等级上的路由掩码
+    uint64_t compute_mask(fmt::string_view logger_name, LogLevel level) const;
+
+    /// 取出这条日志的路由掩码
+    uint64_t mask_for(const std::string & logger_name, LogLevel level) const;
+};
+
+} // namespace sink
+} // namespace slog
+
+#endif // __SLOG_SINK_ROUTER_H__
@@ -34,9 +34,11 @@ struct SpdlogSinkImplDeleter {
  * 使用位标志，可以组合使用
  */
 enum SpdlogSinkType {
-    NoSink      = 0,        // 无输出
-    ToConsole   = 1 << 0,   // 控制台输出 (0x01)
-    ToFile      = 1 << 1    // 文件输出 (0x02)
+    NoSink          = 0,        // 无输出
+    ToConsole       = 1 << 0,   // 控制台输出 (0x01)
+    ToFile          = 1 << 1,   // 文件输出 (0x02)
+    ToRotatingFile  = 1 << 2,   // 按大小轮转的文件输出 (0x04)，对应 rotating_file_sink_mt
+    ToDailyFile     = 1 << 3    // 按天轮转的文件输出 (0x08)，对应 daily_file_sink_mt
 };
 
 /**
@@ -44,6 +46,7 @@ enum SpdlogSinkType {
  * 
  * 封装 spdlog 的 logger，支持 console 和/或 file 输出
  * 可以单独启用 console 或 file，也可以同时启用两者
+ * 文件输出三选一：ToFile（不轮转）、ToRotatingFile（按大小轮转）、ToDailyFile（按天轮转）
  * 
  * 特性：
  * - 线程安全：使用 spdlog 的 _mt 版本（多线程安全）
@@ -54,15 +57,23 @@ enum SpdlogSinkType {
 class Spdlog: public LoggerSink
 {
 public:
+    /// ToDailyFile 保留文件数量的上限（spdlog daily_file_sink 以 uint16_t 保存）
+    static constexpr size_t kMaxDailyFiles = 65535;
+
     /**
      * @brief 构造函数
      * @param level 日志等级
      * @param sink_type Sink 类型标志，可以组合（如 Console | File）
      * @param filepath 日志文件路径（仅当启用 File 时需要）
      * @param async 是否使用异步模式，默认false（同步）
+     * @param max_file_size 单个文件最大大小（字节），仅 ToRotatingFile 有效，默认10MB
+     * @param max_files 保留的旧日志文件数量，ToRotatingFile/ToDailyFile 有效，默认5个
+     *                  （ToDailyFile 中 0 表示不限制，超过 kMaxDailyFiles 时 setup 失败）
      */
-    explicit Spdlog(LogLevel level, int sink_type, std::string const & filepath = "", bool async = false)
+    explicit Spdlog(LogLevel level, int sink_type, std::string const & filepath = "", bool async = false,
+                    size_t max_file_size = 10 * 1024 * 1024, size_t max_files = 5)
         : LoggerSink(level), sink_type_(sink_type), filepath_(filepath), async_(async)
+        , max_file_size_(max_file_size), max_files_(max_files)
     {
         // Initialization will be done in setup()
     }
@@ -83,6 +94,15 @@ public:
     
     const char* name() const override;
 
+    void flush() override;
+
+    /**
+     * @brief 设置按天轮转的时间点（仅 ToDailyFile 有效，需在 setup 之前调用）
+     * @param hour 小时 0-23
+     * @param minute 分钟 0-59
+     */
+    void set_daily_rotation_time(int hour, int minute);
+
 protected:
     void output(const std::string & logger_name, LogLevel level, std::string const &msg) override;
     void on_level_changed(LogLevel level) override;
@@ -92,6 +112,10 @@ private:
     int sink_type_;
     std::string filepath_;
     bool async_;
+    size_t max_file_size_;
+    size_t max_files_;
+    int rotation_hour_ = 0;
+    int rotation_minute_ = 0;
 };
 
 } // namespace sink
@@ -33,9 +33,27 @@ public:
         
     const char* name() const override;
 
+    void flush() override;
+
+    /**
+     * @brief 向日志行追加时间戳、颜色、等级和 logger 名称
+     * 
+     * 与 write_line() 配合，供需要把消息直接格式化进日志行的调用方使用（如 StaticStdout）
+     */
+    static void append_header(detail::LineBuffer & line, fmt::string_view logger_name, LogLevel level);
+
+    /// @brief 结束日志行（颜色复位、换行）并在全局锁保护下写到 stdout
+    static void write_line(detail::LineBuffer & line);
+
 protected:
     void output(const std::string & logger_name, LogLevel level, std::string const &msg) override;
 
+    /// 字段以文本 " key=value" 直接追加到日志行缓冲区
+    void output_fields(const std::string & logger_name, LogLevel level, fmt::string_view msg, FieldList fields) override;
+
+    /// 整批格式化到一块缓冲区，加一次锁写出
+    void output_batch(const std::string & logger_name, Batch const & batch, LogLevel level) override;
+
 private:
     
     /// @brief 获取全局 stdout mutex（所有 Stdout sink 共享）
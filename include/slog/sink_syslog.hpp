@@ -0,0 +1,163 @@
+#ifndef __SLOG_SINK_SYSLOG_H__
+#define __SLOG_SINK_SYSLOG_H__
+
+/**
+ * @file sink_syslog.hpp
+ * @author LiuChuansen (179712066@qq.com)
+ * @brief Syslog Sink实现（直接写本地 Unix 数据报套接字，不依赖 glibc syslog()）
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "slog/slog.hpp"
+
+namespace slog {
+namespace sink {
+
+/**
+ * @brief syslog facility，数值与 <syslog.h> 中的 LOG_xxx >> 3 相同
+ *
+ * 头文件中不包含 <syslog.h>，避免 LOG_INFO 等宏污染使用者的命名空间
+ */
+enum class SyslogFacility : int
+{
+    Kern = 0,
+    User = 1,
+    Mail = 2,
+    Daemon = 3,
+    Auth = 4,
+    Syslog = 5,
+    Lpr = 6,
+    News = 7,
+    Uucp = 8,
+    Cron = 9,
+    AuthPriv = 10,
+    Ftp = 11,
+    Local0 = 16,
+    Local1 = 17,
+    Local2 = 18,
+    Local3 = 19,
+    Local4 = 20,
+    Local5 = 21,
+    Local6 = 22,
+    Local7 = 23,
+};
+
+/**
+ * @brief syslog 消息格式
+ */
+enum class SyslogFormat
+{
+    Rfc3164,    ///< <PRI>Mmm dd hh:mm:ss ident[pid]: (logger) msg，与 glibc syslog() 写 /dev/log 的格式相同
+    Rfc5424,    ///< <PRI>1 TIMESTAMP HOSTNAME APP-NAME PROCID MSGID - msg，MSGID 为 logger 名称
+};
+
+/**
+ * @brief Syslog Sink
+ *
+ * 每条日志格式化为一个数据报，通过已连接的非阻塞 AF_UNIX 套接字发送给本地 syslog 守护进程。
+ *
+ * 特性：
+ * - 不使用 glibc syslog()（进程级全局锁、二次格式化）
+ * - LogLevel 映射到 syslog severity：Trace/Debug->debug, Info->info, Warning->warning, Error->err
+ * - 批量发送：正在发送的线程会把其他线程同时提交的消息一起用 sendmmsg 发出，不引入额外延迟
+ * - 守护进程来不及接收（EAGAIN/ENOBUFS）时丢弃消息并计数，不阻塞调用线程
+ * - 守护进程重启（ECONNREFUSED/ENOTCONN）时自动重连一次
+ * - 超过 max_datagram_size 的消息被截断
+ */
+class Syslog: public LoggerSink
+{
+public:
+    /**
+     * @brief 构造函数
+     * @param level 日志等级
+     * @param ident 程序标识，为空时使用进程名
+     * @param facility syslog facility，默认 User
+     * @param format 消息格式，默认 RFC 3164
+     * @param socket_path 守护进程的套接字路径，默认 /dev/log
+     */
+    explicit Syslog(LogLevel level,
+                    std::string const & ident = std::string(),
+                    SyslogFacility facility = SyslogFacility::User,
+                    SyslogFormat format = SyslogFormat::Rfc3164,
+                    std::string const & socket_path = "/dev/log");
+
+    ~Syslog();
+
+    std::shared_ptr<LoggerSink> clone(const std::string & logger_name) const override;
+
+    bool setup(const std::string & logger_name) override;
+
+    const char* name() const override;
+
+    /// @brief 因守护进程来不及接收或不可用而丢弃的消息数量
+    uint64_t dropped() const noexcept { return dropped_.load(std::memory_order_relaxed); }
+
+    /// @brief 追加 dropped
+    void append_stats(std::string & out) const override;
+
+    /// @brief 设置单个数据报的最大长度（字节），默认 8192
+    void set_max_datagram_size(size_t size) { max_datagram_size_ = size; }
+
+    /// @brief LogLevel 对应的 syslog severity
+    static int severity(LogLevel level) noexcept;
+
+protected:
+    void output(const std::string & logger_name, LogLevel level, std::string const &msg) override;
+
+    /// 字段以文本 " key=value" 追加到消息后
+    void output_fields(const std::string & logger_name, LogLevel level, fmt::string_view msg, FieldList fields) override;
+
+private:
+    std::string ident_;
+    SyslogFacility facility_;
+    SyslogFormat format_;
+    std::string socket_path_;
+    size_t max_datagram_size_;
+    std::string hostname_;
+    int pid_;
+
+    /// 套接字，只在持有 send_mutex_ 时读写
+    int fd_;
+    /// 上一次连接失败的时间，守护进程不可用时每秒最多重连一次
+    std::chrono::steady_clock::time_point last_connect_failure_;
+    std::atomic<uint64_t> dropped_;
+
+    /// 待发送的数据报，提交线程在 queue_mutex_ 下追加
+    std::mutex queue_mutex_;
+    std::vector<std::string> pending_;
+    size_t pending_count_;
+
+    /// 发送线程持有，取走全部待发送数据报后批量发送
+    std::mutex send_mutex_;
+    std::vector<std::string> sending_;
+
+    /// 追加头部（PRI、时间戳、主机、标识）
+    void append_header(detail::LineBuffer & line, fmt::string_view logger_name, LogLevel level);
+
+    /// 提交一个数据报，必要时成为发送线程
+    void submit(detail::LineBuffer & line);
+
+    /// 发送 sending_ 中的前 count 个数据报（需持有 send_mutex_）
+    void send_batch(size_t count);
+
+    /// 连接守护进程（需持有 send_mutex_）
+    bool connect_socket();
+
+    void close_socket();
+};
+
+} // namespace sink
+} // namespace slog
+
+#endif // __SLOG_SINK_SYSLOG_H__
@@ -25,6 +25,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <mutex>
+#include <atomic>
 #if defined(_WIN32)
 #include <process.h>
 #else
@@ -32,6 +33,9 @@
 #endif
 #include <unordered_map>
 #include <map>
+#include <utility>
+#include <iterator>
+#include <type_traits>
 
 
 #ifdef BUILD_WITH_LIBFMT
@@ -42,6 +46,21 @@
 #include <slog/fmt/format.h>
 #endif 
 
+/**
+ * SLOG_COMPILED_FORMAT 为 1 时，SLOG_* 和 LOCAL_* 宏用 FMT_COMPILE 包装字面量格式串，
+ * 格式串在编译期解析为直接的格式化代码，运行时不再解析格式串（调用点代码相应变大）。
+ * 需要系统 fmt（内置 fmt 没有 compile.h）和 C++17，否则 SLOG_HAS_COMPILED_FORMAT 为 0，宏仍使用 FMT_STRING。
+ */
+#if defined(SLOG_COMPILED_FORMAT) && SLOG_COMPILED_FORMAT && defined(BUILD_WITH_LIBFMT)
+#include <fmt/compile.h>
+#if defined(__cpp_if_constexpr) && defined(__cpp_return_type_deduction)
+#define SLOG_HAS_COMPILED_FORMAT 1
+#endif
+#endif
+#ifndef SLOG_HAS_COMPILED_FORMAT
+#define SLOG_HAS_COMPILED_FORMAT 0
+#endif
+
 /// 版本号定义
 #define SLOG_VERSION_MAJOR 0
 #define SLOG_VERSION_MINOR 6
@@ -102,7 +121,7 @@ constexpr char log_level_short_name(LogLevel level) noexcept
 }
 
 /**
- * @brief 将字串转换日志名称，支持短名称如T D, d等
+ * @brief 将字串转换日志名称，支持短名称如T D, d等，以及日志输出中的 "WARN" 和关闭日志的 "off"
  * 
  * @param level 
  * @param default_level 默认值
@@ -121,8 +140,9 @@ inline LogLevel log_level_from_name(std::string const &level, LogLevel default_l
         c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
     }
 
-    constexpr const char* level_names[] = {"trace", "debug", "info", "warning", "error"};
-    constexpr LogLevel levels[] = {LogLevel::Trace, LogLevel::Debug, LogLevel::Info, LogLevel::Warning, LogLevel::Error};
+    constexpr const char* level_names[] = {"trace", "debug", "info", "warning", "error", "off"};
+    constexpr LogLevel levels[] = {LogLevel::Trace, LogLevel::Debug, LogLevel::Info, LogLevel::Warning, LogLevel::Error,
+                                   LogLevel::Off};
     constexpr size_t level_count = sizeof(level_names) / sizeof(level_names[0]);
 
     // 比较每个字串
@@ -139,6 +159,12 @@ inline LogLevel log_level_from_name(std::string const &level, LogLevel default_l
         }
     }
 
+    // log_level_name() 输出的名称
+    if (in == "warn")
+    {
+        return LogLevel::Warning;
+    }
+
     return default_level;
 }
 
@@ -247,6 +273,573 @@ inline std::string format_log_filename(std::string const &pattern)
     return out;
 }
 
+/// 日志时间戳使用的时钟
+enum class TimestampClock : uint8_t
+{
+    /// 系统时间，输出 "YYYY-mm-dd HH:MM:SS.fff"
+    Realtime,
+    /// 单调时钟（Linux 上为 CLOCK_MONOTONIC），输出开机以来的秒数 "SSSS.fff"，便于与 perf/ftrace 等追踪数据对齐
+    Monotonic,
+    /// CPU 时间戳计数器（x86 rdtsc、AArch64 cntvct），按启动时的校准换算为系统时间输出；
+    /// 读取比系统时间便宜，换算在格式化时进行（sink::Isolated 中为工作线程）
+    Tsc,
+};
+
+/// 时间戳小数部分的位数
+enum class TimestampPrecision : uint8_t
+{
+    Milli = 3,
+    Micro = 6,
+    Nano = 9,
+};
+
+/**
+ * @brief 时间戳配置，作用于 Stdout/File/JsonFile/Net sink
+ *
+ * 默认（Realtime + Milli）与旧版本输出完全相同；slog_cat/slog_grep/slog_merge 只识别系统时间格式。
+ */
+struct TimestampOptions
+{
+    TimestampClock clock = TimestampClock::Realtime;
+    TimestampPrecision precision = TimestampPrecision::Milli;
+};
+
+/**
+ * @brief 设置时间戳的时钟和精度，随时生效
+ *
+ * 第一次选择 TimestampClock::Tsc 时校准计数器频率，约阻塞 20ms。
+ * precision 不是 Milli/Micro/Nano 之一时保持原有精度，只设置时钟。
+ *
+ * @param options 配置
+ */
+void set_timestamp_options(TimestampOptions const &options);
+
+/**
+ * @brief 获取当前的时间戳配置
+ */
+TimestampOptions get_timestamp_options();
+
+/**
+ * @brief 设置当前线程的名称
+ *
+ * 名称保存在线程局部变量中（最长 31 字节），随日志输出；同时设置 pthread 名称，
+ * 在 top -H、gdb、perf 中可见（Linux 上截断为 15 字节）。
+ *
+ * @param name 线程名称，为空时清除
+ */
+void set_thread_name(fmt::string_view name);
+
+/**
+ * @brief 是否在 Stdout/File/Net 日志行的 logger 名称之后输出线程 "[tid]" 或 "[tid:name]"，默认不输出
+ *
+ * JsonFile 和 Journal 总是输出线程 id 及名称。
+ *
+ * @param enable 是否输出
+ */
+void set_log_thread(bool enable);
+
+/**
+ * @brief 获取是否输出线程信息
+ */
+bool get_log_thread();
+
+namespace detail {
+
+/// 单条日志行缓冲区：256 字节内联存储（头部 + 常见长度的消息），长消息或 dump 时自动溢出到堆
+using LineBuffer = fmt::basic_memory_buffer<char, 256>;
+
+/**
+ * @brief 一条日志的时间：捕获时只读取时钟，换算和格式化在输出时进行
+ */
+struct Timestamp
+{
+    /// Realtime：epoch 以来的纳秒；Monotonic：单调时钟纳秒；Tsc：计数器原始值
+    uint64_t ticks = 0;
+    TimestampClock clock = TimestampClock::Realtime;
+};
+
+/// 当前使用的时钟，由 set_timestamp_options() 设置
+inline std::atomic<TimestampClock> &timestamp_clock() noexcept
+{
+    static std::atomic<TimestampClock> clock{TimestampClock::Realtime};
+    return clock;
+}
+
+/// 读取 CPU 时间戳计数器，不支持的平台返回 steady_clock 纳秒
+inline uint64_t read_tsc() noexcept
+{
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__))
+    return __builtin_ia32_rdtsc();
+#elif defined(__aarch64__) && (defined(__GNUC__) || defined(__clang__))
+    uint64_t value;
+    __asm__ __volatile__("mrs %0, cntvct_el0" : "=r"(value));
+    return value;
+#else
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+#endif
+}
+
+/// 按当前配置读取时钟
+inline Timestamp capture_timestamp() noexcept
+{
+    Timestamp ts;
+    ts.clock = timestamp_clock().load(std::memory_order_relaxed);
+    switch (ts.clock) {
+    case TimestampClock::Tsc:
+        ts.ticks = read_tsc();
+        break;
+    case TimestampClock::Monotonic:
+        ts.ticks = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+        break;
+    default:
+        ts.ticks = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count());
+        break;
+    }
+    return ts;
+}
+
+/// 当前线程正在输出的日志的时间，由 RecordTimeScope 设置
+struct RecordTime
+{
+    Timestamp ts;
+    bool valid = false;
+};
+
+inline RecordTime &record_time() noexcept
+{
+    static thread_local RecordTime current;
+    return current;
+}
+
+/**
+ * @brief 在一条日志分发给各个 sink 期间固定它的时间，支持嵌套
+ *
+ * Logger 每条日志只读取一次时钟，所有 sink 输出相同的时间；
+ * sink::Isolated 在入队时保存时间，工作线程输出时恢复。
+ */
+class RecordTimeScope
+{
+public:
+    explicit RecordTimeScope(Timestamp ts) noexcept : previous_(record_time())
+    {
+        record_time().ts = ts;
+        record_time().valid = true;
+    }
+
+    ~RecordTimeScope()
+    {
+        record_time() = previous_;
+    }
+
+    RecordTimeScope(RecordTimeScope const &) = delete;
+    RecordTimeScope & operator=(RecordTimeScope const &) = delete;
+
+private:
+    RecordTime previous_;
+};
+
+/// 当前日志的时间；不在 RecordTimeScope 中时（如直接调用 sink）读取时钟
+inline Timestamp current_timestamp() noexcept
+{
+    RecordTime const &current = record_time();
+    return current.valid ? current.ts : capture_timestamp();
+}
+
+/**
+ * @brief 线程的 id 和名称，每个线程第一次使用时读取 id，之后只是一次线程局部变量访问
+ */
+struct ThreadInfo
+{
+    /// 内核线程 id（Linux 为 gettid()），0 表示尚未读取
+    uint64_t id = 0;
+    uint8_t name_size = 0;
+    char name[31];
+
+    fmt::string_view thread_name() const noexcept { return fmt::string_view(name, name_size); }
+};
+
+inline ThreadInfo &this_thread_info() noexcept
+{
+    static thread_local ThreadInfo info;
+    return info;
+}
+
+/// 读取并缓存当前线程的 id
+uint64_t init_thread_id() noexcept;
+
+/// 当前线程的 ThreadInfo，保证 id 已读取
+inline ThreadInfo const &current_thread_info() noexcept
+{
+    ThreadInfo &info = this_thread_info();
+    if (info.id == 0) {
+        init_thread_id();
+    }
+    return info;
+}
+
+/// 当前线程正在输出的日志所属的线程，由 RecordThreadScope 设置
+inline ThreadInfo const *&record_thread_override() noexcept
+{
+    static thread_local ThreadInfo const *thread = nullptr;
+    return thread;
+}
+
+/**
+ * @brief 在其他线程代为输出日志期间，把日志的线程信息指向调用线程
+ *
+ * sink::Isolated 在入队时复制调用线程的 ThreadInfo，工作线程输出时设置。
+ */
+class RecordThreadScope
+{
+public:
+    explicit RecordThreadScope(ThreadInfo const &thread) noexcept : previous_(record_thread_override())
+    {
+        record_thread_override() = &thread;
+    }
+
+    ~RecordThreadScope()
+    {
+        record_thread_override() = previous_;
+    }
+
+    RecordThreadScope(RecordThreadScope const &) = delete;
+    RecordThreadScope & operator=(RecordThreadScope const &) = delete;
+
+private:
+    ThreadInfo const *previous_;
+};
+
+/// 当前日志所属线程的 id 和名称
+inline ThreadInfo const &record_thread() noexcept
+{
+    ThreadInfo const *thread = record_thread_override();
+    return (thread != nullptr) ? *thread : current_thread_info();
+}
+
+/// set_log_thread() 的开关
+inline std::atomic<bool> &log_thread_flag() noexcept
+{
+    static std::atomic<bool> flag{false};
+    return flag;
+}
+
+/**
+ * @brief 向日志行追加 "YYYY-mm-dd HH:MM:SS.mmm" 格式的时间戳
+ * 
+ * 日期和时分秒部分按秒缓存在线程局部变量中，同一秒内不再调用 localtime。
+ * 小数位数按 set_timestamp_options() 的精度。
+ * 
+ * @param buf 日志行缓冲区
+ * @param now 时间点
+ */
+void append_timestamp(LineBuffer &buf, std::chrono::system_clock::time_point now);
+
+/**
+ * @brief 按捕获时的时钟和当前精度追加时间戳
+ *
+ * Realtime/Tsc 输出 "YYYY-mm-dd HH:MM:SS.fff"（Tsc 按校准换算为系统时间），Monotonic 输出 "SSSS.fff"
+ */
+void append_timestamp(LineBuffer &buf, Timestamp ts);
+
+/**
+ * @brief 时间戳对应的系统时间，自 epoch 起的纳秒数
+ *
+ * Tsc 按校准换算；Monotonic 按当前系统时间与单调时钟的差值换算
+ */
+int64_t timestamp_epoch_ns(Timestamp ts) noexcept;
+
+/// @brief 向日志行追加字符串
+inline void append_string(LineBuffer &buf, fmt::string_view str)
+{
+    buf.append(str.data(), str.data() + str.size());
+}
+
+/// 追加 "[tid] " 或 "[tid:name] "
+void append_thread(LineBuffer &buf, ThreadInfo const &thread);
+
+/// set_log_thread() 打开时追加当前日志的线程信息
+inline void append_thread_tag(LineBuffer &buf)
+{
+    if (log_thread_flag().load(std::memory_order_relaxed)) {
+        append_thread(buf, record_thread());
+    }
+}
+
+/// 按字符串保存的字段值：能转换为 fmt::string_view 的类型（const char*、std::string 等）
+template<typename T>
+struct is_string_field : std::integral_constant<bool,
+    !std::is_arithmetic<T>::value && std::is_convertible<T const &, fmt::string_view>::value> {};
+
+/// 按数值保存的字段值：算术类型，char 除外（按字符格式化，走自定义类型）
+template<typename T>
+struct is_arithmetic_field : std::integral_constant<bool,
+    std::is_arithmetic<T>::value && !std::is_same<T, char>::value> {};
+
+} // namespace detail
+
+/**
+ * @brief 结构化日志字段，由 slog::kv() 创建
+ * 
+ * 字段按类型保存，不预先格式化；只有通过等级检查的 sink 才按各自的编码（文本 k=v、JSON 等）
+ * 把字段直接写入日志行缓冲区。字符串和自定义类型只保存引用，字段只能在创建它的那条日志语句中使用。
+ */
+class Field
+{
+public:
+    enum class Type : uint8_t { Int, UInt, Double, Bool, String, Custom };
+
+    /// 自定义类型的格式化函数，把值直接写入日志行缓冲区
+    using FormatFunc = void (*)(void const *value, detail::LineBuffer &buf);
+
+    template<typename T, typename std::enable_if<std::is_same<T, bool>::value, int>::type = 0>
+    Field(fmt::string_view key, T value) noexcept : key_(key), type_(Type::Bool)
+    {
+        value_.b = value;
+    }
+
+    template<typename T, typename std::enable_if<detail::is_arithmetic_field<T>::value && std::is_integral<T>::value
+        && std::is_signed<T>::value, int>::type = 0>
+    Field(fmt::string_view key, T value) noexcept : key_(key), type_(Type::Int)
+    {
+        value_.i = static_cast<int64_t>(value);
+    }
+
+    template<typename T, typename std::enable_if<detail::is_arithmetic_field<T>::value && std::is_integral<T>::value
+        && !std::is_signed<T>::value && !std::is_same<T, bool>::value, int>::type = 0>
+    Field(fmt::string_view key, T value) noexcept : key_(key), type_(Type::UInt)
+    {
+        value_.u = static_cast<uint64_t>(value);
+    }
+
+    template<typename T, typename std::enable_if<std::is_floating_point<T>::value, int>::type = 0>
+    Field(fmt::string_view key, T value) noexcept : key_(key), type_(Type::Double)
+    {
+        value_.d = static_cast<double>(value);
+    }
+
+    template<typename T, typename std::enable_if<detail::is_string_field<T>::value, int>::type = 0>
+    Field(fmt::string_view key, T const &value) noexcept : key_(key), type_(Type::String)
+    {
+        fmt::string_view str(value);
+        value_.s.data = str.data();
+        value_.s.size = str.size();
+    }
+
+    template<typename T, typename std::enable_if<!detail::is_arithmetic_field<T>::value
+        && !detail::is_string_field<T>::value, int>::type = 0>
+    Field(fmt::string_view key, T const &value) noexcept : key_(key), type_(Type::Custom)
+    {
+        value_.custom.ptr = &value;
+        value_.custom.format = &format_custom<T>;
+    }
+
+    fmt::string_view key() const noexcept { return key_; }
+    Type type() const noexcept { return type_; }
+
+    int64_t as_int() const noexcept { return value_.i; }
+    uint64_t as_uint() const noexcept { return value_.u; }
+    double as_double() const noexcept { return value_.d; }
+    bool as_bool() const noexcept { return value_.b; }
+    fmt::string_view as_string() const noexcept { return fmt::string_view(value_.s.data, value_.s.size); }
+
+    /// @brief 按 fmt 的默认格式把值写入缓冲区（字符串不加引号）
+    void format_value(detail::LineBuffer &buf) const;
+
+private:
+    template<typename T>
+    static void format_custom(void const *value, detail::LineBuffer &buf)
+    {
+        fmt::format_to(std::back_inserter(buf), "{}", *static_cast<T const *>(value));
+    }
+
+    fmt::string_view key_;
+    Type type_;
+    union
+    {
+        int64_t i;
+        uint64_t u;
+        double d;
+        bool b;
+        struct { const char *data; size_t size; } s;
+        struct { void const *ptr; FormatFunc format; } custom;
+    } value_;
+};
+
+/**
+ * @brief 创建一个结构化日志字段
+ * 
+ * @example
+ * ```cpp
+ * logger->info("request done", slog::kv("latency_us", latency), slog::kv("path", path));
+ * ```
+ */
+template<typename T>
+inline Field kv(fmt::string_view key, T const &value) noexcept
+{
+    return Field(key, value);
+}
+
+/// @brief 一条日志携带的字段（不持有字段）
+struct FieldList
+{
+    Field const *data = nullptr;
+    size_t size = 0;
+
+    Field const *begin() const noexcept { return data; }
+    Field const *end() const noexcept { return data + size; }
+    bool empty() const noexcept { return size == 0; }
+};
+
+namespace detail {
+
+/**
+ * @brief 以文本形式追加字段：每个字段为 " key=value"
+ * 
+ * 字符串值为空或包含空格、引号、'=' 时加双引号并转义。
+ */
+void append_fields_text(LineBuffer &buf, FieldList fields);
+
+template<typename... Args>
+struct all_fields;
+
+template<>
+struct all_fields<> : std::true_type {};
+
+template<typename T, typename... Rest>
+struct all_fields<T, Rest...> : std::integral_constant<bool,
+    std::is_same<typename std::decay<T>::type, Field>::value && all_fields<Rest...>::value> {};
+
+template<typename... Args>
+struct any_field;
+
+template<>
+struct any_field<> : std::false_type {};
+
+template<typename T, typename... Rest>
+struct any_field<T, Rest...> : std::integral_constant<bool,
+    std::is_same<typename std::decay<T>::type, Field>::value || any_field<Rest...>::value> {};
+
+/// 格式化日志接口：参数中不能有结构化字段
+template<typename... Args>
+using enable_if_no_fields_t = typename std::enable_if<!any_field<Args...>::value, int>::type;
+
+/// 结构化日志接口：至少一个参数，且全部为结构化字段
+template<typename... Args>
+using enable_if_fields_t = typename std::enable_if<(sizeof...(Args) > 0) && all_fields<Args...>::value, int>::type;
+
+} // namespace detail
+
+/**
+ * @brief 一批日志记录，由调用者持有，可反复使用
+ *
+ * 记录的消息连续保存在同一块内存中，add() 时格式化并读取时钟；Logger::log_batch() 把整批交给每个 sink，
+ * File/Stdout 拼接成一块后只加一次锁写入。用于关闭时输出大表、重放队列等集中输出大量日志的场景：
+ *
+ * @code
+ * slog::Batch batch;
+ * for (auto const &row : rows) {
+ *     batch.add(slog::LogLevel::Info, "{} {}", row.key, row.value);
+ * }
+ * logger->log_batch(batch);
+ * batch.clear();
+ * @endcode
+ */
+class Batch
+{
+public:
+    /// 一条记录，msg 在 Batch 下一次修改前有效
+    struct Record
+    {
+        LogLevel level;
+        fmt::string_view msg;
+        detail::Timestamp timestamp;
+    };
+
+    Batch() = default;
+
+    /// @brief 预留记录数和消息总字节数
+    void reserve(size_t records, size_t bytes)
+    {
+        entries_.reserve(records);
+        text_.reserve(bytes);
+    }
+
+    /// @brief 添加一条记录
+    void add(LogLevel level, fmt::string_view msg)
+    {
+        size_t offset = text_.size();
+        text_.append(msg.data(), msg.size());
+        push(level, offset);
+    }
+
+    /// @brief 格式化并添加一条记录
+    template<typename... Args>
+    void add(LogLevel level, fmt::format_string<Args...> fmt, Args &&... args)
+    {
+        vadd(level, fmt, fmt::make_format_args(args...));
+    }
+
+    /// @brief 按类型擦除的参数格式化并添加一条记录
+    void vadd(LogLevel level, fmt::string_view fmt, fmt::format_args args);
+
+    /// @brief 清空记录，保留已分配的内存
+    void clear() noexcept
+    {
+        entries_.clear();
+        text_.clear();
+        max_level_ = LogLevel::Trace;
+    }
+
+    size_t size() const noexcept { return entries_.size(); }
+    bool empty() const noexcept { return entries_.empty(); }
+
+    /// @brief 消息的总字节数
+    size_t bytes() const noexcept { return text_.size(); }
+
+    /// @brief 所有记录中最高的等级，sink 等级高于它时整批跳过
+    LogLevel max_level() const noexcept { return max_level_; }
+
+    Record operator[](size_t i) const noexcept
+    {
+        Entry const &entry = entries_[i];
+        return Record{entry.level, fmt::string_view(text_.data() + entry.offset, entry.size), entry.timestamp};
+    }
+
+private:
+    struct Entry
+    {
+        LogLevel level;
+        uint32_t offset;
+        uint32_t size;
+        detail::Timestamp timestamp;
+    };
+
+    void push(LogLevel level, size_t offset)
+    {
+        Entry entry;
+        entry.level = level;
+        entry.offset = static_cast<uint32_t>(offset);
+        entry.size = static_cast<uint32_t>(text_.size() - offset);
+        entry.timestamp = detail::capture_timestamp();
+        entries_.push_back(entry);
+        if (static_cast<int>(level) > static_cast<int>(max_level_)) {
+            max_level_ = level;
+        }
+    }
+
+    std::string text_;
+    std::vector<Entry> entries_;
+    LogLevel max_level_ = LogLevel::Trace;
+};
+
+namespace sink {
+class Router;
+class Isolated;
+} // namespace sink
+
 /**
  * @brief 一个日志SINK接口
  * 
@@ -290,11 +883,44 @@ public:
     /// @brief 获取规则日志logger名称
     virtual const char* name() const = 0;
 
+    /// @brief 把已缓冲的日志写出，默认无操作
+    virtual void flush() {}
+
+    /// @brief 向 out 追加运行统计（若干 " key=value"），默认没有统计
+    virtual void append_stats(std::string & out) const
+    {
+        (void)out;
+    }
+
 protected:
+    /// Logger 通过 sink 分发表直接调用 output()，等级检查已在分发表中完成
+    friend class Logger;
+    /// Router 按路由表直接调用子 sink 的 output()，等级检查已在路由表中完成
+    friend class sink::Router;
+    /// Isolated 在工作线程中直接调用子 sink 的 output()，等级检查已在入队前完成
+    friend class sink::Isolated;
+
     /// @brief 实际输出日志的虚函数，子类需要实现此函数
     /// @param level 日志等级
     /// @param msg 日志消息
     virtual void output(const std::string & logger_name, LogLevel level, std::string const & msg) = 0;
+
+    /// @brief 输出带结构化字段的日志，只有通过等级检查的 sink 才会被调用
+    /// 
+    /// 默认实现把字段按文本 " key=value" 追加到消息后再交给 output()；
+    /// 子类可以重写此函数，把字段按自己的编码直接写入日志行缓冲区。
+    /// @param level 日志等级
+    /// @param msg 日志消息
+    /// @param fields 结构化字段
+    virtual void output_fields(const std::string & logger_name, LogLevel level, fmt::string_view msg, FieldList fields);
+
+    /// @brief 输出一批日志中等级不低于 level 的记录
+    /// 
+    /// 默认实现逐条调用 output()，每条使用记录自己的时间戳；
+    /// 子类可以重写此函数，把整批格式化后一次写出。
+    /// @param batch 日志记录
+    /// @param level sink 的生效等级
+    virtual void output_batch(const std::string & logger_name, Batch const & batch, LogLevel level);
     
     /// @brief 当日志等级改变时的回调函数，子类可以重写此函数来执行额外操作
     /// @param level 新的日志等级
@@ -349,10 +975,147 @@ inline void LoggerSink::set_rule_level(LogLevel level)
 }
 
 
+/**
+ * @brief 异步模式及消息缓冲区配置
+ * 
+ * 异步队列参数在第一个异步 logger 创建时生效，之后修改不再影响已启动的后台线程；
+ * 消息缓冲区参数随时生效。
+ */
+struct AsyncOptions
+{
+    /// 异步队列长度（条），队列槽位预分配，短消息（< 250 字节）直接存放在槽位内
+    size_t queue_size = 8192;
+    /// 异步后台线程数量
+    size_t thread_count = 2;
+    /// 每线程消息缓冲区的初始容量（字节）
+    size_t payload_reserve = 256;
+    /// 每线程消息缓冲区保留的最大容量（字节），超过后在本条日志结束时释放，避免大块 dump 长期占用内存
+    size_t payload_retain_max = 64 * 1024;
+};
+
+/**
+ * @brief 设置异步模式及消息缓冲区配置
+ * 
+ * @param options 配置
+ */
+void set_async_options(AsyncOptions const &options);
+
+/**
+ * @brief 获取当前的异步模式及消息缓冲区配置
+ * 
+ * @return AsyncOptions 
+ */
+AsyncOptions get_async_options();
+
+class Logger;
+
 namespace detail {
 class LoggerRegistry;
+
+/// @brief 获取当前线程复用的消息缓冲区，重入（格式化参数时又打印日志）时返回 nullptr
+std::string *acquire_payload_buffer() noexcept;
+
+/// @brief 归还当前线程的消息缓冲区
+void release_payload_buffer(std::string *buf) noexcept;
+
+/**
+ * @brief 格式化消息用的缓冲区
+ * 
+ * 优先使用每线程复用的缓冲区，其容量随实际消息长度增长后保留，稳态下格式化不再分配内存；
+ * 重入时退化为局部 std::string。
+ */
+class PayloadBuffer
+{
+public:
+    PayloadBuffer() : buf_(acquire_payload_buffer())
+    {
+        if (buf_ == nullptr) {
+            buf_ = &local_;
+        }
+    }
+
+    ~PayloadBuffer()
+    {
+        if (buf_ != &local_) {
+            release_payload_buffer(buf_);
+        }
+    }
+
+    PayloadBuffer(PayloadBuffer const &) = delete;
+    PayloadBuffer & operator=(PayloadBuffer const &) = delete;
+
+    std::string &str() noexcept { return *buf_; }
+
+private:
+    std::string *buf_;
+    std::string local_;
+};
+
+/**
+ * @brief 受全局日志等级规则控制、但不是 Logger 的对象（如 StaticLogger）
+ * 
+ * 注册到 LoggerRegistry 后，set_logger_level()/apply_logger_rules() 会像作用于 Logger 一样作用于它。
+ * 注册表只保存原始指针，对象析构前必须调用 unregister_rule_target()。
+ */
+class RuleTarget
+{
+public:
+    virtual ~RuleTarget() = default;
+
+    /// @brief 用于规则匹配的名称
+    virtual std::string const &rule_name() const = 0;
+
+    /// @brief 应用规则等级，Unknown 表示取消规则
+    virtual void set_rule_level(LogLevel level) = 0;
+};
+
+/// @brief 注册规则对象，并立即应用已存在的匹配规则
+bool register_rule_target(RuleTarget *target);
+
+/// @brief 注销规则对象
+void unregister_rule_target(RuleTarget *target);
+
+/**
+ * @brief FNV-1a 64 位哈希，可在编译期对字面量 logger 名称求值
+ */
+constexpr uint64_t fnv1a_hash(const char *str, size_t size) noexcept
+{
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= static_cast<uint8_t>(str[i]);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
 }
 
+template<size_t N>
+constexpr uint64_t fnv1a_hash(const char (&str)[N]) noexcept
+{
+    return fnv1a_hash(str, N - 1);
+}
+
+/**
+ * @brief 进程级驻留的 logger 名称
+ * 
+ * 同名 logger 共享同一个条目，条目在进程生命周期内不会释放，地址和 id 稳定。
+ */
+struct InternedName
+{
+    uint32_t id;        ///< 驻留序号，从 1 开始
+    uint64_t hash;      ///< fnv1a_hash(name)
+    std::string name;   ///< 名称，长度已知，sink 拼接头部时无需再计算
+};
+
+/// @brief 驻留一个 logger 名称，返回稳定的条目
+InternedName const &intern_logger_name(std::string const &name);
+
+/// @brief 注册表代数，注册或移除 logger 时递增，用于让调用点缓存的 logger 失效
+uint64_t registry_generation() noexcept;
+
+/// @brief shell 通配符匹配：'*' 匹配任意长度，'?' 匹配单个字符（等级规则和 Router 路由共用）
+bool glob_match(fmt::string_view pattern, fmt::string_view name) noexcept;
+} // namespace detail
+
 /**
  * @brief Logger对象声明
  * 
@@ -365,7 +1128,7 @@ public:
     using SharedPtr = std::shared_ptr<Logger>; 
 
     /// @brief 默认构造函数
-    Logger() : valid_(false) {}
+    Logger() : name_(&detail::intern_logger_name(std::string())), valid_(false) {}
 
     /// @brief 单sink构造函数
     /// @param name logger名称
@@ -387,6 +1150,12 @@ public:
     /// @return 
     std::string const &name() const;
 
+    /// @brief 返回名称驻留后的稳定 id，同名 logger 的 id 相同
+    uint32_t id() const noexcept { return name_->id; }
+
+    /// @brief 返回名称视图（长度已预先计算）
+    fmt::string_view name_view() const noexcept { return fmt::string_view(name_->name); }
+
     /// @brief 返回日志等级
     /// @return 
     LogLevel get_level() const;
@@ -403,6 +1172,19 @@ public:
     /// @brief All sinks completed setup successfully (false if any sink setup failed)
     bool is_valid() const noexcept { return valid_; }
 
+    /// @brief 返回 sink 列表
+    ///
+    /// 日志分发使用 Logger 缓存的各 sink 等级，只在 Logger::set_level()、规则变化和 refresh_levels() 时更新。
+    /// 直接调用 sinks()[i]->set_level() / set_rule_level()（或通过另一个共享该 sink 的 logger）修改等级后，
+    /// 本 logger 要在调用 refresh_levels() 之后才按新等级过滤。
+    std::vector<std::shared_ptr<LoggerSink>> const &sinks() const noexcept { return sinks_; }
+
+    /// @brief 按各 sink 当前的等级重新计算过滤等级和分发表，用于直接修改 sink 等级之后
+    void refresh_levels();
+
+    /// @brief 让所有 sink 写出已缓冲的日志
+    void flush();
+
     /// @brief 显示指定日志
     /// @param level 日志等级
     /// @param msg 日志消息
@@ -425,6 +1207,25 @@ public:
     /// @param msg 日志消息
     void log_data(LogLevel level, void const *data, size_t size, std::string const &msg);
 
+    /// @brief 显示带结构化字段的日志，字段只在通过等级检查的 sink 中序列化
+    /// @param level 日志等级
+    /// @param msg 日志消息
+    /// @param fields 结构化字段
+    void log_fields(LogLevel level, fmt::string_view msg, FieldList fields);
+
+    /// @brief 按类型擦除的参数格式化并输出日志
+    ///
+    /// 模板版本的 log()/info() 等只在调用点构造参数包，格式化在此函数中完成，
+    /// 避免每个调用点实例化并内联完整的格式化代码。
+    /// @param level 日志等级
+    /// @param fmt 格式串
+    /// @param args fmt::make_format_args() 构造的参数
+    void vlog(LogLevel level, fmt::string_view fmt, fmt::format_args args);
+
+    /// @brief 输出一批日志，每个 sink 只调用一次，按各自的等级过滤记录
+    /// @param batch 日志记录，调用后可 clear() 复用
+    void log_batch(Batch const &batch);
+
     /// @brief 具有限制属性的日志输出方法
     /// @param tag 限制的标签
     /// @param allowed_num 允许打印的日志数量
@@ -444,10 +1245,25 @@ public:
     std::shared_ptr<Logger> clone(std::string const & logger_name, LogLevel level) const;
 
     // 以下是基础函数
-    template<typename... Args>
+    template<typename... Args, detail::enable_if_no_fields_t<Args...> = 0>
     void log(LogLevel level, fmt::format_string<Args...> fmt, Args &&... args)
     {
-        log(level, fmt::format(fmt, std::forward<Args>(args)...));        
+        // 等级不允许时不做格式化
+        if (!is_allowed(level)) {
+            return;
+        }
+        vlog(level, fmt, fmt::make_format_args(args...));
+    }
+
+    /// 结构化日志：logger->info("request done", slog::kv("latency_us", x), slog::kv("path", p))
+    template<typename... Fields, detail::enable_if_fields_t<Fields...> = 0>
+    void log(LogLevel level, fmt::string_view msg, Fields const &... fields)
+    {
+        if (!is_allowed(level)) {
+            return;
+        }
+        Field const items[] = {fields...};
+        log_fields(level, msg, FieldList{items, sizeof...(Fields)});
     }
 
     template<typename... Args>
@@ -470,34 +1286,64 @@ public:
 
     /// 以下是便捷函数
 
-    template<typename... Args>
+    template<typename... Args, detail::enable_if_no_fields_t<Args...> = 0>
     void trace(fmt::format_string<Args...> fmt, Args &&... args)
     {
-        log(LogLevel::Trace, fmt::format(fmt, std::forward<Args>(args)...));
+        log(LogLevel::Trace, fmt, std::forward<Args>(args)...);
     }
 
-    template<typename... Args>
+    template<typename... Fields, detail::enable_if_fields_t<Fields...> = 0>
+    void trace(fmt::string_view msg, Fields const &... fields)
+    {
+        log(LogLevel::Trace, msg, fields...);
+    }
+
+    template<typename... Args, detail::enable_if_no_fields_t<Args...> = 0>
     void debug(fmt::format_string<Args...> fmt, Args &&... args)
     {
-        log(LogLevel::Debug, fmt::format(fmt, std::forward<Args>(args)...));        
+        log(LogLevel::Debug, fmt, std::forward<Args>(args)...);
     }
 
-    template<typename... Args>
+    template<typename... Fields, detail::enable_if_fields_t<Fields...> = 0>
+    void debug(fmt::string_view msg, Fields const &... fields)
+    {
+        log(LogLevel::Debug, msg, fields...);
+    }
+
+    template<typename... Args, detail::enable_if_no_fields_t<Args...> = 0>
     void info(fmt::format_string<Args...> fmt, Args &&... args)
     {
-        log(LogLevel::Info, fmt::format(fmt, std::forward<Args>(args)...));        
+        log(LogLevel::Info, fmt, std::forward<Args>(args)...);
+    }
+
+    template<typename... Fields, detail::enable_if_fields_t<Fields...> = 0>
+    void info(fmt::string_view msg, Fields const &... fields)
+    {
+        log(LogLevel::Info, msg, fields...);
     }    
 
-    template<typename... Args>
+    template<typename... Args, detail::enable_if_no_fields_t<Args...> = 0>
     void warning(fmt::format_string<Args...> fmt, Args &&... args)
     {
-        log(LogLevel::Warning, fmt::format(fmt, std::forward<Args>(args)...));        
+        log(LogLevel::Warning, fmt, std::forward<Args>(args)...);
+    }
+
+    template<typename... Fields, detail::enable_if_fields_t<Fields...> = 0>
+    void warning(fmt::string_view msg, Fields const &... fields)
+    {
+        log(LogLevel::Warning, msg, fields...);
     }    
 
-    template<typename... Args>
+    template<typename... Args, detail::enable_if_no_fields_t<Args...> = 0>
     void error(fmt::format_string<Args...> fmt, Args &&... args)
     {
-        log(LogLevel::Error, fmt::format(fmt, std::forward<Args>(args)...));        
+        log(LogLevel::Error, fmt, std::forward<Args>(args)...);
+    }
+
+    template<typename... Fields, detail::enable_if_fields_t<Fields...> = 0>
+    void error(fmt::string_view msg, Fields const &... fields)
+    {
+        log(LogLevel::Error, msg, fields...);
     }
 
     // 日志抑制
@@ -541,10 +1387,27 @@ public:
 
 
 private:
-    std::string name_;
+    /**
+     * @brief sink 分发表条目
+     * 
+     * 保存 sink 的原始指针和生效等级（已合并 rule_level），Logger::log 遍历分发表时
+     * 不触碰 shared_ptr 引用计数，等级不够的 sink 直接跳过，不会发生虚函数调用。
+     * sink 的所有权仍由 sinks_ 持有。
+     */
+    struct SinkPlanEntry
+    {
+        LoggerSink *sink = nullptr;
+        std::atomic<LogLevel> level{LogLevel::Off};
+    };
+
+    /// 驻留的名称，进程生命周期内有效
+    detail::InternedName const *name_;
     std::vector<std::shared_ptr<LoggerSink>> sinks_;
+    /// sink 分发表，与 sinks_ 一一对应，在 update_filter_level() 中建立和刷新
+    std::unique_ptr<SinkPlanEntry[]> plan_;
+    size_t plan_size_ = 0;
     bool valid_;
-    LogLevel min_level_; // 过滤等级，如果为Off，则不进行过滤
+    std::atomic<LogLevel> min_level_{LogLevel::Off}; // 过滤等级，如果为Off，则不进行过滤
     LogLevel max_level_; // 最大等级，如果为Off，则不进行过滤
 
     /// 用来管理日志抑制
@@ -560,10 +1423,15 @@ private:
     /// @param allowed_num 允许打印的日志数量
     int limited_allowed_left(std::string const &tag, int allowed_num);
 
-    /// @brief 计算最小等级
+    /// @brief 计算最小等级，并刷新 sink 分发表
     /// @return 最小等级
     void update_filter_level();
 
+    /// @brief 按分发表把日志交给各个 sink（调用前已完成 valid_/min_level_ 检查）
+    /// @param level 日志等级
+    /// @param msg 日志消息
+    void dispatch(LogLevel level, std::string const &msg);
+
     /// @brief 重置规则日志等级
     /// @param level 规则日志等级
     void set_rule_level(LogLevel level);
@@ -624,6 +1492,44 @@ bool set_default_logger(const std::string& name);
 */
 std::shared_ptr<Logger> get_logger(const std::string& name);
 
+/**
+* @brief 查找已注册的logger，不存在时不会创建
+* @param name logger名称
+* @return std::shared_ptr<Logger> logger指针，不存在返回nullptr
+*/
+std::shared_ptr<Logger> find_logger(const std::string& name);
+
+namespace detail {
+
+/**
+ * @brief 按字面量名称缓存 logger，供 SLOG_GET_LOGGER 使用
+ * 
+ * 每个名称（按编译期哈希区分）在每个线程中缓存一次 get_logger() 的结果，
+ * 之后只比较注册表代数；logger 被注册或移除后自动重新解析。
+ * 按值返回：缓存刷新后，调用者已取得的 logger 不受影响。
+ */
+template<uint64_t Hash>
+std::shared_ptr<Logger> cached_logger(const char *name)
+{
+    struct Cache
+    {
+        std::shared_ptr<Logger> logger;
+        uint64_t generation = 0;
+        const char *name = nullptr;
+    };
+    static thread_local Cache cache;
+
+    if (!cache.logger || cache.generation != registry_generation()
+        || (cache.name != name && cache.logger->name() != name)) {
+        cache.logger = get_logger(name);
+        cache.generation = registry_generation();
+    }
+    cache.name = name;
+    return cache.logger;
+}
+
+} // namespace detail
+
 /**
 * @brief 检查logger是否存在
 * 
@@ -713,6 +1619,51 @@ std::shared_ptr<Logger> make_rotating_file_logger(std::string const &name,
     bool to_stdout = false, 
     bool flush_on_write = true);
 
+/**
+ * @brief 创建一个输出 JSON Lines 的文件logger（每行一个 JSON 对象，支持轮转）
+ * 
+ * @param name logger名称
+ * @param filepath 日志文件路径
+ * @param level 日志等级，默认Info
+ * @param max_file_size 最大文件大小（字节），0表示无限制，默认10MB
+ * @param max_files 保留的旧日志文件数量，默认5个
+ * @param flush_on_write 是否每次写入后立即刷新，默认true
+ * @return std::shared_ptr<Logger> 
+ */
+std::shared_ptr<Logger> make_json_file_logger(std::string const &name, 
+    std::string const &filepath, 
+    LogLevel level = LogLevel::Info, 
+    size_t max_file_size = 10 * 1024 * 1024, 
+    size_t max_files = 5, 
+    bool flush_on_write = true);
+
+#if !defined(_WIN32)
+/**
+ * @brief 创建一个写本地 syslog（/dev/log）的logger，facility 为 user，RFC 3164 格式
+ * 
+ * 需要其他 facility、RFC 5424 或自定义套接字路径时，直接构造 sink::Syslog
+ * 
+ * @param name logger名称
+ * @param level 日志等级，默认Info
+ * @param ident 程序标识，为空时使用进程名
+ * @return std::shared_ptr<Logger> 
+ */
+std::shared_ptr<Logger> make_syslog_logger(std::string const &name, 
+    LogLevel level = LogLevel::Info, 
+    std::string const &ident = std::string());
+#endif // !_WIN32
+
+#if defined(__linux__)
+/**
+ * @brief 创建一个使用 journal 原生协议写 systemd journal 的logger
+ * 
+ * @param name logger名称，同时作为 SYSLOG_IDENTIFIER
+ * @param level 日志等级，默认Info
+ * @return std::shared_ptr<Logger> 
+ */
+std::shared_ptr<Logger> make_journal_logger(std::string const &name, LogLevel level = LogLevel::Info);
+#endif // __linux__
+
 #ifdef BUILD_WITH_SPDLOG
 /**
  * @brief 创建 spdlog console logger
@@ -740,6 +1691,50 @@ std::shared_ptr<Logger> make_spdlog_logger(std::string const &name,
     LogLevel level = LogLevel::Info,
     bool to_console = false,
     bool async = false);
+
+/**
+ * @brief 创建 spdlog 按大小轮转的 file logger（rotating_file_sink_mt）
+ * 
+ * @param name logger名称
+ * @param filepath 日志文件路径
+ * @param level 日志等级，默认Info
+ * @param max_file_size 最大文件大小（字节），默认10MB
+ * @param max_files 保留的旧日志文件数量，默认5个
+ * @param to_console 是否同时输出到控制台，默认false
+ * @param async 是否使用异步模式，默认false（同步）
+ * @return std::shared_ptr<Logger> 
+ */
+std::shared_ptr<Logger> make_spdlog_rotating_file_logger(std::string const &name,
+    std::string const &filepath,
+    LogLevel level = LogLevel::Info,
+    size_t max_file_size = 10 * 1024 * 1024,
+    size_t max_files = 5,
+    bool to_console = false,
+    bool async = false);
+
+/**
+ * @brief 创建 spdlog 按天轮转的 file logger（daily_file_sink_mt）
+ * 
+ * 文件名形如 filepath_YYYY-mm-dd.ext，每天 hour:minute 切换到新文件
+ * 
+ * @param name logger名称
+ * @param filepath 日志文件路径
+ * @param level 日志等级，默认Info
+ * @param hour 轮转时间（小时 0-23），默认0
+ * @param minute 轮转时间（分钟 0-59），默认0
+ * @param max_files 保留的旧日志文件数量，0 表示不限制，默认0，超过 65535 时返回 nullptr
+ * @param to_console 是否同时输出到控制台，默认false
+ * @param async 是否使用异步模式，默认false（同步）
+ * @return std::shared_ptr<Logger> 
+ */
+std::shared_ptr<Logger> make_spdlog_daily_file_logger(std::string const &name,
+    std::string const &filepath,
+    LogLevel level = LogLevel::Info,
+    int hour = 0,
+    int minute = 0,
+    size_t max_files = 0,
+    bool to_console = false,
+    bool async = false);
 #endif // BUILD_WITH_SPDLOG
 
 
@@ -787,6 +1782,70 @@ void set_logger_level(const std::string& pattern, LogLevel level);
  */
 int apply_logger_rules(const std::string& rule_text);
 
+/**
+ * @brief 解析日志规则文本，不应用
+ * 
+ * @param rule_text 格式同 apply_logger_rules()
+ * @return std::vector<std::pair<std::string, LogLevel>> 解析出的规则（pattern, level），格式错误的规则被跳过
+ */
+std::vector<std::pair<std::string, LogLevel>> parse_logger_rules(const std::string& rule_text);
+
+/**
+ * @brief 批量设置日志等级规则
+ * 
+ * 全部规则先在锁外编译，再一次性发布：每个已存在的 logger 只更新一次等级，
+ * 几百条规则的重新加载也只占用注册表锁很短时间，日志线程读取的是原子等级，不会被阻塞。
+ * 
+ * @param rules 规则列表（pattern, level），pattern 语法同 set_logger_level()
+ * @param replace true 替换全部现有规则，logger 按新规则表更新等级（不再匹配任何规则的 logger 恢复自身等级）；
+ *                false 追加，被本次规则匹配到的 logger 取本次匹配到的等级，与逐条调用 set_logger_level() 一致
+ * @return int 接受的规则数量
+ * 
+ * @example
+ * ```cpp
+ * slog::set_logger_level_rules(slog::parse_logger_rules("net_*:debug;db:trace"), true);
+ * ```
+ */
+int set_logger_level_rules(std::vector<std::pair<std::string, LogLevel>> const& rules, bool replace = false);
+
+/**
+ * @brief 移除一组先前设置的规则并追加新规则，一次性发布
+ * 
+ * 用于只替换某一来源（如配置文件）的规则：removed 中的规则只有 pattern 和等级都未被改动时才移除，
+ * 其他来源的规则（SLOG_LEVEL、--slog-level、控制端点）保留。被新规则匹配到的 logger 取新规则的等级，
+ * 只被移除的规则匹配到的 logger 按剩余规则重新计算，不再匹配任何规则时恢复自身等级。
+ * 
+ * @param removed 要移除的规则（pattern, level），通常是上一次追加的 rules
+ * @param rules 要追加的规则（pattern, level），pattern 语法同 set_logger_level()
+ * @return int 接受的新规则数量
+ */
+int update_logger_level_rules(std::vector<std::pair<std::string, LogLevel>> const& removed,
+                              std::vector<std::pair<std::string, LogLevel>> const& rules);
+
+/**
+ * @brief 从命令行参数应用日志规则
+ * 
+ * 识别 "--slog-level=RULES" 和 "--slog-level RULES" 两种写法（可出现多次），RULES 格式同 apply_logger_rules()，
+ * 也可以只写一个等级（如 "debug"，等价于 "*:debug"）。参数不会从 argv 中移除。
+ * 
+ * 环境变量 SLOG_LEVEL 使用相同格式，在注册表构造时（第一个 logger 注册前）自动应用，无需调用任何函数；
+ * 命令行规则在其后追加，按规则优先级与之共存。
+ * 
+ * @example
+ * ```cpp
+ * int main(int argc, char **argv) {
+ *     slog::apply_logger_rules_from_args(argc, argv);
+ *     ...
+ * }
+ * ```
+ * 
+ * @param argc 参数个数
+ * @param argv 参数列表
+ * @param option 选项名，默认 "--slog-level"
+ * @return int 应用的规则数量
+ */
+int apply_logger_rules_from_args(int argc, char const* const* argv, const std::string& option = "--slog-level");
+
 /**
  * @brief 获取所有日志规则
  * 
@@ -800,6 +1859,11 @@ std::map<std::string, LogLevel> get_logger_rules();
  */
 void clear_logger_rules();
 
+/**
+ * @brief 让所有已注册的 logger 写出已缓冲的日志
+ */
+void flush_all_loggers();
+
 /**
  * @brief 获取所有 logger 的名称列表
  * 
@@ -808,10 +1872,25 @@ void clear_logger_rules();
 std::vector<std::string> get_logger_list();
 
 
-template<typename... Args>
+/**
+ * @brief 使用默认 logger 按类型擦除的参数格式化并输出日志
+ * 
+ * @param level 日志等级
+ * @param fmt 格式串
+ * @param args fmt::make_format_args() 构造的参数
+ */
+void vlog(LogLevel level, fmt::string_view fmt, fmt::format_args args);
+
+template<typename... Args, detail::enable_if_no_fields_t<Args...> = 0>
 inline void log(LogLevel level, fmt::format_string<Args...> fmt, Args &&...args)
 {
-    default_logger()->log(level, fmt::format(fmt, std::forward<Args>(args)...));
+    vlog(level, fmt, fmt::make_format_args(args...));
+}
+
+template<typename... Fields, detail::enable_if_fields_t<Fields...> = 0>
+inline void log(LogLevel level, fmt::string_view msg, Fields const &...fields)
+{
+    default_logger()->log(level, msg, fields...);
 }
 
 /**
@@ -842,34 +1921,64 @@ inline void dump(LogLevel level, std::string const & str, fmt::format_string<Arg
     default_logger()->log_data(level, str.data(), str.size(), fmt::format(fmt, std::forward<Args>(args)...));        
 }
 
-template<typename... Args>
+template<typename... Args, detail::enable_if_no_fields_t<Args...> = 0>
 inline void trace(fmt::format_string<Args...> fmt, Args &&...args)
 {
-    default_logger()->log(LogLevel::Trace, fmt::format(fmt, std::forward<Args>(args)...));
+    default_logger()->log(LogLevel::Trace, fmt, std::forward<Args>(args)...);
 }
 
-template<typename... Args>
+template<typename... Fields, detail::enable_if_fields_t<Fields...> = 0>
+inline void trace(fmt::string_view msg, Fields const &...fields)
+{
+    default_logger()->log(LogLevel::Trace, msg, fields...);
+}
+
+template<typename... Args, detail::enable_if_no_fields_t<Args...> = 0>
 inline void debug(fmt::format_string<Args...> fmt, Args &&...args)
 {
-    default_logger()->log(LogLevel::Debug, fmt::format(fmt, std::forward<Args>(args)...));
+    default_logger()->log(LogLevel::Debug, fmt, std::forward<Args>(args)...);
 }
 
-template<typename... Args>
+template<typename... Fields, detail::enable_if_fields_t<Fields...> = 0>
+inline void debug(fmt::string_view msg, Fields const &...fields)
+{
+    default_logger()->log(LogLevel::Debug, msg, fields...);
+}
+
+template<typename... Args, detail::enable_if_no_fields_t<Args...> = 0>
 inline void info(fmt::format_string<Args...> fmt, Args &&...args)
 {
-    default_logger()->log(LogLevel::Info, fmt::format(fmt, std::forward<Args>(args)...));
+    default_logger()->log(LogLevel::Info, fmt, std::forward<Args>(args)...);
 }
 
-template<typename... Args>
+template<typename... Fields, detail::enable_if_fields_t<Fields...> = 0>
+inline void info(fmt::string_view msg, Fields const &...fields)
+{
+    default_logger()->log(LogLevel::Info, msg, fields...);
+}
+
+template<typename... Args, detail::enable_if_no_fields_t<Args...> = 0>
 inline void warning(fmt::format_string<Args...> fmt, Args &&...args)
 {
-    default_logger()->log(LogLevel::Warning, fmt::format(fmt, std::forward<Args>(args)...));
+    default_logger()->log(LogLevel::Warning, fmt, std::forward<Args>(args)...);
 }
 
-template<typename... Args>
+template<typename... Fields, detail::enable_if_fields_t<Fields...> = 0>
+inline void warning(fmt::string_view msg, Fields const &...fields)
+{
+    default_logger()->log(LogLevel::Warning, msg, fields...);
+}
+
+template<typename... Args, detail::enable_if_no_fields_t<Args...> = 0>
 inline void error(fmt::format_string<Args...> fmt, Args &&...args)
 {
-    default_logger()->log(LogLevel::Error, fmt::format(fmt, std::forward<Args>(args)...));
+    default_logger()->log(LogLevel::Error, fmt, std::forward<Args>(args)...);
+}
+
+template<typename... Fields, detail::enable_if_fields_t<Fields...> = 0>
+inline void error(fmt::string_view msg, Fields const &...fields)
+{
+    default_logger()->log(LogLevel::Error, msg, fields...);
 }
 
 template<typename... Args>
@@ -902,6 +2011,167 @@ inline void error_limited(std::string const &tag, int allowed_num, fmt::format_s
     default_logger()->log_limited(tag, allowed_num, LogLevel::Error, fmt::format(fmt, std::forward<Args>(args)...));
 }
 
+class SourceSite;
+
+namespace detail {
+
+/// 登记调用点并返回初始状态（慢路径，每个调用点只执行一次）
+uint8_t register_source_site(SourceSite *site) noexcept;
+
+/// 按默认 logger 的等级批量刷新所有已登记调用点的状态
+void refresh_source_sites(LogLevel level) noexcept;
+
+} // namespace detail
+
+/**
+ * @brief 日志调用点的静态元数据，由 SLOG_* 宏在每个调用点实例化一个静态对象
+ * 
+ * 构造函数是 constexpr 的，静态对象在编译期完成初始化，不需要局部静态变量的初始化保护。
+ * 调用点第一次执行时登记到全局列表，之后热路径只读取一次 enabled 标志；
+ * 默认 logger 的等级变化时，所有调用点的标志被批量刷新。
+ */
+class SourceSite
+{
+public:
+    constexpr SourceSite(const char *file, int line, const char *function, LogLevel level, const char *format) noexcept
+        : file(file), line(line), function(function), level(level), format(format)
+        , state_(Unregistered), limited_count_(0), next_(nullptr)
+    {
+    }
+
+    SourceSite(SourceSite const &) = delete;
+    SourceSite & operator=(SourceSite const &) = delete;
+
+    const char *const file;       ///< 源文件
+    const int line;               ///< 行号
+    const char *const function;   ///< 函数名
+    const LogLevel level;         ///< 日志等级
+    const char *const format;     ///< 格式字符串
+
+    /// @brief 当前调用点是否允许输出（热路径只有一次原子读取）
+    bool enabled() noexcept
+    {
+        uint8_t state = state_.load(std::memory_order_relaxed);
+        if (state == Unregistered) {
+            state = detail::register_source_site(this);
+        }
+        return state == Enabled;
+    }
+
+    /**
+     * @brief 调用点级别的日志抑制，替代按 tag 查表的 *_limited
+     * 
+     * @param allowed_num 允许打印的次数
+     * @return int 剩余可打印次数（含本次），0 表示应当抑制
+     */
+    int limited_allowed_left(int allowed_num) noexcept
+    {
+        int count = limited_count_.fetch_add(1, std::memory_order_relaxed);
+        return (count < allowed_num) ? (allowed_num - count) : 0;
+    }
+
+    /// @brief 重置抑制计数
+    void reset_limited() noexcept
+    {
+        limited_count_.store(0, std::memory_order_relaxed);
+    }
+
+private:
+    friend uint8_t detail::register_source_site(SourceSite *site) noexcept;
+    friend void detail::refresh_source_sites(LogLevel level) noexcept;
+
+    enum : uint8_t { Unregistered = 0, Disabled = 1, Enabled = 2 };
+
+    std::atomic<uint8_t> state_;
+    std::atomic<int> limited_count_;
+    SourceSite *next_;
+};
+
+/**
+ * @brief 当前线程正在输出的 SLOG_* 调用点
+ * 
+ * 供需要源码位置的 sink（如 sink::Journal 的 CODE_FILE/CODE_LINE）使用；
+ * 不是通过 SLOG_* 宏输出的日志返回 nullptr。
+ */
+inline SourceSite const *&current_source_site() noexcept
+{
+    static thread_local SourceSite const *site = nullptr;
+    return site;
+}
+
+namespace detail {
+
+/// @brief 在 SLOG_* 宏输出期间记录当前调用点，支持嵌套
+class SourceSiteScope
+{
+public:
+    explicit SourceSiteScope(SourceSite const *site) noexcept : previous_(current_source_site())
+    {
+        current_source_site() = site;
+    }
+
+    ~SourceSiteScope()
+    {
+        current_source_site() = previous_;
+    }
+
+    SourceSiteScope(SourceSiteScope const &) = delete;
+    SourceSiteScope & operator=(SourceSiteScope const &) = delete;
+
+private:
+    SourceSite const *previous_;
+};
+
+/// @brief 默认 logger 输出已格式化的消息
+void log_default(LogLevel level, std::string const &msg);
+
+#if SLOG_HAS_COMPILED_FORMAT
+/// @brief 用编译期格式串格式化并输出，供 SLOG_* / LOCAL_* 宏使用
+template<typename S, typename... Args, enable_if_no_fields_t<Args...> = 0>
+inline void log_compiled(Logger &logger, LogLevel level, S const &fmt, Args const &...args)
+{
+    if (!logger.is_allowed(level)) {
+        return;
+    }
+    PayloadBuffer payload;
+    fmt::format_to(std::back_inserter(payload.str()), fmt, args...);
+    logger.log(level, payload.str());
+}
+
+/// 带结构化字段时格式串就是消息本身，走原来的字段路径
+template<typename S, typename... Fields, enable_if_fields_t<Fields...> = 0>
+inline void log_compiled(Logger &logger, LogLevel level, S const &fmt, Fields const &...fields)
+{
+    logger.log(level, fmt::string_view(fmt), fields...);
+}
+
+template<typename S, typename... Args, enable_if_no_fields_t<Args...> = 0>
+inline void log_default_compiled(LogLevel level, S const &fmt, Args const &...args)
+{
+    // 调用点标志已按默认 logger 的等级检查
+    PayloadBuffer payload;
+    fmt::format_to(std::back_inserter(payload.str()), fmt, args...);
+    log_default(level, payload.str());
+}
+
+template<typename S, typename... Fields, enable_if_fields_t<Fields...> = 0>
+inline void log_default_compiled(LogLevel level, S const &fmt, Fields const &...fields)
+{
+    slog::log(level, fmt::string_view(fmt), fields...);
+}
+#endif // SLOG_HAS_COMPILED_FORMAT
+
+/// @brief 调用点日志抑制的输出，最后一条追加抑制提示
+void vlog_site_limited(int left, LogLevel level, fmt::string_view fmt, fmt::format_args args);
+
+template<typename... Args>
+inline void log_site_limited(int left, LogLevel level, fmt::format_string<Args...> fmt, Args &&...args)
+{
+    vlog_site_limited(left, level, fmt, fmt::make_format_args(args...));
+}
+
+} // namespace detail
+
 } // namespace slog
 
 // Suppress warning about GNU extension for variadic macros
@@ -915,7 +2185,9 @@ inline void error_limited(std::string const &tag, int allowed_num, fmt::format_s
  * @brief 日志宏，支持编译时格式字符串检查
  * 
  * 使用这些宏可以在编译时检查格式字符串和参数是否匹配。
- * 这些宏内部使用 FMT_STRING 来启用编译时检查。
+ * 这些宏内部使用 FMT_STRING 来启用编译时检查；定义 SLOG_COMPILED_FORMAT=1 且条件满足时改用 FMT_COMPILE
+ * （SLOG_*_LIMITED 仍使用 FMT_STRING）。
+ * 每个调用点实例化一个静态的 slog::SourceSite，等级不允许时只需读取一次调用点标志。
  * 
  * @example
  * ```cpp
@@ -923,22 +2195,101 @@ inline void error_limited(std::string const &tag, int allowed_num, fmt::format_s
  * SLOG_ERROR("Failed to connect: {}", error_code);
  * ```
  */
+#if SLOG_HAS_COMPILED_FORMAT
+#define SLOG_LOG_DEFAULT_(level, fmt, ...) \
+    slog::detail::log_default_compiled(level, FMT_COMPILE(fmt), ##__VA_ARGS__)
+#else
+#define SLOG_LOG_DEFAULT_(level, fmt, ...) \
+    slog::log(level, FMT_STRING(fmt), ##__VA_ARGS__)
+#endif
+
+#define SLOG_LOG_SITE_(level, fmt, ...) \
+    do { \
+        static slog::SourceSite slog_site_(__FILE__, __LINE__, __func__, level, fmt); \
+        if (slog_site_.enabled()) { \
+            slog::detail::SourceSiteScope slog_scope_(&slog_site_); \
+            SLOG_LOG_DEFAULT_(level, fmt, ##__VA_ARGS__); \
+        } \
+    } while (0)
+
 #define SLOG_TRACE(fmt, ...) \
-    slog::trace(FMT_STRING(fmt), ##__VA_ARGS__)
+    SLOG_LOG_SITE_(slog::LogLevel::Trace, fmt, ##__VA_ARGS__)
 
 #define SLOG_DEBUG(fmt, ...) \
-    slog::debug(FMT_STRING(fmt), ##__VA_ARGS__)
+    SLOG_LOG_SITE_(slog::LogLevel::Debug, fmt, ##__VA_ARGS__)
 
 #define SLOG_INFO(fmt, ...) \
-    slog::info(FMT_STRING(fmt), ##__VA_ARGS__)
+    SLOG_LOG_SITE_(slog::LogLevel::Info, fmt, ##__VA_ARGS__)
 
 #define SLOG_WARNING(fmt, ...) \
-    slog::warning(FMT_STRING(fmt), ##__VA_ARGS__)
+    SLOG_LOG_SITE_(slog::LogLevel::Warning, fmt, ##__VA_ARGS__)
 
 #define SLOG_ERROR(fmt, ...) \
-    slog::error(FMT_STRING(fmt), ##__VA_ARGS__)
+    SLOG_LOG_SITE_(slog::LogLevel::Error, fmt, ##__VA_ARGS__)
+
+/**
+ * @brief 调用点级别的日志抑制宏：每个调用点最多输出 allowed_num 次，无需 tag
+ * 
+ * @example
+ * ```cpp
+ * SLOG_WARNING_LIMITED(3, "Retry {} failed", n);
+ * ```
+ */
+#define SLOG_LOG_SITE_LIMITED_(level, allowed_num, fmt, ...) \
+    do { \
+        static slog::SourceSite slog_site_(__FILE__, __LINE__, __func__, level, fmt); \
+        if (slog_site_.enabled()) { \
+            int slog_left_ = slog_site_.limited_allowed_left(allowed_num); \
+            if (slog_left_ > 0) { \
+                slog::detail::SourceSiteScope slog_scope_(&slog_site_); \
+                slog::detail::log_site_limited(slog_left_, level, FMT_STRING(fmt), ##__VA_ARGS__); \
+            } \
+        } \
+    } while (0)
+
+#define SLOG_TRACE_LIMITED(allowed_num, fmt, ...) \
+    SLOG_LOG_SITE_LIMITED_(slog::LogLevel::Trace, allowed_num, fmt, ##__VA_ARGS__)
+
+#define SLOG_DEBUG_LIMITED(allowed_num, fmt, ...) \
+    SLOG_LOG_SITE_LIMITED_(slog::LogLevel::Debug, allowed_num, fmt, ##__VA_ARGS__)
+
+#define SLOG_INFO_LIMITED(allowed_num, fmt, ...) \
+    SLOG_LOG_SITE_LIMITED_(slog::LogLevel::Info, allowed_num, fmt, ##__VA_ARGS__)
+
+#define SLOG_WARNING_LIMITED(allowed_num, fmt, ...) \
+    SLOG_LOG_SITE_LIMITED_(slog::LogLevel::Warning, allowed_num, fmt, ##__VA_ARGS__)
+
+#define SLOG_ERROR_LIMITED(allowed_num, fmt, ...) \
+    SLOG_LOG_SITE_LIMITED_(slog::LogLevel::Error, allowed_num, fmt, ##__VA_ARGS__)
+
 
+/**
+ * @brief 获取字面量名称对应的 logger，每个线程只在第一次（或注册表变化后）查找注册表
+ * 
+ * @example
+ * ```cpp
+ * SLOG_GET_LOGGER("net")->info("connected");
+ * ```
+ */
+#define SLOG_GET_LOGGER(name) \
+    slog::detail::cached_logger<slog::detail::fnv1a_hash(name)>(name)
+
+#if SLOG_HAS_COMPILED_FORMAT
+#define LOCAL_TRACE(local_logger, fmt, ...) \
+    slog::detail::log_compiled(*(local_logger), slog::LogLevel::Trace, FMT_COMPILE(fmt), ##__VA_ARGS__)
 
+#define LOCAL_DEBUG(local_logger, fmt, ...) \
+    slog::detail::log_compiled(*(local_logger), slog::LogLevel::Debug, FMT_COMPILE(fmt), ##__VA_ARGS__)
+
+#define LOCAL_INFO(local_logger, fmt, ...) \
+    slog::detail::log_compiled(*(local_logger), slog::LogLevel::Info, FMT_COMPILE(fmt), ##__VA_ARGS__)
+
+#define LOCAL_WARNING(local_logger, fmt, ...) \
+    slog::detail::log_compiled(*(local_logger), slog::LogLevel::Warning, FMT_COMPILE(fmt), ##__VA_ARGS__)
+
+#define LOCAL_ERROR(local_logger, fmt, ...) \
+    slog::detail::log_compiled(*(local_logger), slog::LogLevel::Error, FMT_COMPILE(fmt), ##__VA_ARGS__)
+#else
 #define LOCAL_TRACE(local_logger, fmt, ...) \
     local_logger->trace(FMT_STRING(fmt), ##__VA_ARGS__)
 
@@ -953,6 +2304,7 @@ inline void error_limited(std::string const &tag, int allowed_num, fmt::format_s
 
 #define LOCAL_ERROR(local_logger, fmt, ...) \
     local_logger->error(FMT_STRING(fmt), ##__VA_ARGS__)
+#endif // SLOG_HAS_COMPILED_FORMAT
 
 #if defined(__clang__)
 #pragma clang diagnostic pop
@@ -0,0 +1,306 @@
+#ifndef __SLOG_STATIC_LOGGER_H__
+#define __SLOG_STATIC_LOGGER_H__
+
+/**
+ * @file static_logger.hpp
+ * @author LiuChuansen (179712066@qq.com)
+ * @brief 编译期确定 sink 列表的静态 Logger
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <tuple>
+#include <utility>
+#include <string>
+#include <atomic>
+
+#include "slog/slog.hpp"
+#include "slog/sink_stdout.hpp"
+#include "slog/sink_file.hpp"
+
+namespace slog {
+
+/**
+ * @brief 静态 sink 基类（无虚函数），管理等级与规则等级，语义与 LoggerSink 一致
+ *
+ * 静态 sink 需要继承此类，并提供：
+ * - bool setup(const std::string & logger_name)：可选，默认返回 true
+ * - void write(const std::string & logger_name, LogLevel level, fmt::string_view fmt, fmt::format_args args)：
+ *   把消息直接格式化进自己的缓冲区并输出
+ */
+class StaticSinkBase
+{
+public:
+    explicit StaticSinkBase(LogLevel level) : level_(level), rule_level_(LogLevel::Unknown) {}
+
+    StaticSinkBase(StaticSinkBase const & other)
+        : level_(other.level_.load(std::memory_order_relaxed))
+        , rule_level_(other.rule_level_.load(std::memory_order_relaxed))
+    {
+    }
+
+    bool setup(const std::string & logger_name)
+    {
+        (void)logger_name;
+        return true;
+    }
+
+    /// @brief 设置日志等级，同时取消规则等级
+    void set_level(LogLevel level)
+    {
+        level_.store(level, std::memory_order_relaxed);
+        rule_level_.store(LogLevel::Unknown, std::memory_order_relaxed);
+    }
+
+    /// @brief 设置规则日志等级
+    void set_rule_level(LogLevel level)
+    {
+        rule_level_.store(level, std::memory_order_relaxed);
+    }
+
+    /// @brief 获取生效的日志等级
+    LogLevel get_level() const
+    {
+        LogLevel rule = rule_level_.load(std::memory_order_relaxed);
+        return (rule != LogLevel::Unknown) ? rule : level_.load(std::memory_order_relaxed);
+    }
+
+private:
+    std::atomic<LogLevel> level_;
+    std::atomic<LogLevel> rule_level_;
+};
+
+namespace sink {
+
+/**
+ * @brief 静态 Stdout sink，格式与 sink::Stdout 一致，消息直接格式化进日志行缓冲区
+ */
+class StaticStdout: public StaticSinkBase
+{
+public:
+    explicit StaticStdout(LogLevel level) : StaticSinkBase(level) {}
+
+    void write(const std::string & logger_name, LogLevel level, fmt::string_view fmt, fmt::format_args args)
+    {
+        detail::LineBuffer line;
+        Stdout::append_header(line, logger_name, level);
+        fmt::vformat_to(std::back_inserter(line), fmt, args);
+        Stdout::write_line(line);
+    }
+};
+
+/**
+ * @brief 静态 File sink，复用 sink::File 的共享文件状态与rotation，消息直接格式化进日志行缓冲区
+ */
+class StaticFile: public StaticSinkBase
+{
+public:
+    explicit StaticFile(LogLevel level,
+                        std::string const & filepath,
+                        size_t max_file_size = 10 * 1024 * 1024,
+                        size_t max_files = 5,
+                        bool flush_on_write = true)
+        : StaticSinkBase(level)
+        , file_(level, filepath, max_file_size, max_files, flush_on_write)
+    {
+    }
+
+    bool setup(const std::string & logger_name)
+    {
+        return file_.setup(logger_name);
+    }
+
+    void write(const std::string & logger_name, LogLevel level, fmt::string_view fmt, fmt::format_args args)
+    {
+        detail::LineBuffer line;
+        File::append_header(line, logger_name, level);
+        fmt::vformat_to(std::back_inserter(line), fmt, args);
+        file_.write_line(line);
+    }
+
+private:
+    File file_;
+};
+
+} // namespace sink
+
+/**
+ * @brief 编译期确定 sink 列表的 Logger
+ *
+ * - sink 按值保存在 std::tuple 中，分发时没有虚函数调用，编译器可以内联整个输出路径
+ * - 消息直接格式化进各个 sink 的日志行缓冲区，没有中间 std::string
+ * - 构造时注册到全局注册表，set_logger_level()/apply_logger_rules() 对其同样生效
+ * - 对象地址被注册表引用，因此不可复制、不可移动
+ *
+ * @example
+ * ```cpp
+ * static slog::StaticLogger<slog::sink::StaticStdout, slog::sink::StaticFile> s_log("app",
+ *     slog::sink::StaticStdout(slog::LogLevel::Info),
+ *     slog::sink::StaticFile(slog::LogLevel::Debug, "/tmp/app.log"));
+ * s_log.info("value = {}", 42);
+ * ```
+ */
+template<typename... Sinks>
+class StaticLogger : public detail::RuleTarget
+{
+    static_assert(sizeof...(Sinks) > 0, "StaticLogger requires at least one sink");
+
+public:
+    explicit StaticLogger(std::string const & name, Sinks... sinks)
+        : name_(name), sinks_(std::move(sinks)...), valid_(false)
+    {
+        valid_ = setup_all(std::index_sequence_for<Sinks...>{});
+        update_filter_level();
+        detail::register_rule_target(this);
+    }
+
+    ~StaticLogger() override
+    {
+        detail::unregister_rule_target(this);
+    }
+
+    StaticLogger(StaticLogger const &) = delete;
+    StaticLogger & operator=(StaticLogger const &) = delete;
+
+    /// @brief 返回名称
+    std::string const & name() const { return name_; }
+
+    /// @brief All sinks completed setup successfully
+    bool is_valid() const noexcept { return valid_; }
+
+    /// @brief 返回日志等级（所有 sink 中最小的）
+    LogLevel get_level() const { return min_level_.load(std::memory_order_relaxed); }
+
+    /// @brief 设置日志等级，将修改所有sink的等级
+    void set_level(LogLevel level)
+    {
+        for_each_sink([level](StaticSinkBase & sink) { sink.set_level(level); });
+        update_filter_level();
+    }
+
+    /// @brief 是否允许打印指定等级
+    bool is_allowed(LogLevel level) const noexcept
+    {
+        return static_cast<int>(level) >= static_cast<int>(min_level_.load(std::memory_order_relaxed));
+    }
+
+    /// @brief 获取第 I 个 sink
+    template<size_t I>
+    typename std::tuple_element<I, std::tuple<Sinks...>>::type & sink()
+    {
+        return std::get<I>(sinks_);
+    }
+
+    template<typename... Args>
+    void log(LogLevel level, fmt::format_string<Args...> fmt, Args &&... args)
+    {
+        if (!valid_ || !is_allowed(level)) {
+            return;
+        }
+        auto store = fmt::make_format_args(args...);
+        write_all(level, fmt::string_view(fmt), fmt::format_args(store), std::index_sequence_for<Sinks...>{});
+    }
+
+    template<typename... Args>
+    void trace(fmt::format_string<Args...> fmt, Args &&... args)
+    {
+        log(LogLevel::Trace, fmt, std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    void debug(fmt::format_string<Args...> fmt, Args &&... args)
+    {
+        log(LogLevel::Debug, fmt, std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    void info(fmt::format_string<Args...> fmt, Args &&... args)
+    {
+        log(LogLevel::Info, fmt, std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    void warning(fmt::format_string<Args...> fmt, Args &&... args)
+    {
+        log(LogLevel::Warning, fmt, std::forward<Args>(args)...);
+    }
+
+    template<typename... Args>
+    void error(fmt::format_string<Args...> fmt, Args &&... args)
+    {
+        log(LogLevel::Error, fmt, std::forward<Args>(args)...);
+    }
+
+    /// @brief 规则匹配使用的名称
+    std::string const & rule_name() const override { return name_; }
+
+    /// @brief 应用规则等级（由注册表调用）
+    void set_rule_level(LogLevel level) override
+    {
+        for_each_sink([level](StaticSinkBase & sink) { sink.set_rule_level(level); });
+        update_filter_level();
+    }
+
+private:
+    std::string name_;
+    std::tuple<Sinks...> sinks_;
+    bool valid_;
+    std::atomic<LogLevel> min_level_{LogLevel::Off};
+
+    template<size_t... I>
+    bool setup_all(std::index_sequence<I...>)
+    {
+        bool ok = true;
+        int expand[] = {0, (ok = (std::get<I>(sinks_).setup(name_) && ok), 0)...};
+        (void)expand;
+        return ok;
+    }
+
+    template<size_t I>
+    void write_one(LogLevel level, fmt::string_view fmt, fmt::format_args args)
+    {
+        auto & sink = std::get<I>(sinks_);
+        if (static_cast<int>(level) >= static_cast<int>(sink.get_level())) {
+            sink.write(name_, level, fmt, args);
+        }
+    }
+
+    template<size_t... I>
+    void write_all(LogLevel level, fmt::string_view fmt, fmt::format_args args, std::index_sequence<I...>)
+    {
+        detail::RecordTimeScope time_scope(detail::current_timestamp());
+        int expand[] = {0, (write_one<I>(level, fmt, args), 0)...};
+        (void)expand;
+    }
+
+    template<typename Func, size_t... I>
+    void for_each_sink_impl(Func && func, std::index_sequence<I...>)
+    {
+        int expand[] = {0, (func(std::get<I>(sinks_)), 0)...};
+        (void)expand;
+    }
+
+    template<typename Func>
+    void for_each_sink(Func && func)
+    {
+        for_each_sink_impl(std::forward<Func>(func), std::index_sequence_for<Sinks...>{});
+    }
+
+    void update_filter_level()
+    {
+        LogLevel min_level = LogLevel::Off;
+        for_each_sink([&min_level](StaticSinkBase & sink) {
+            if (static_cast<int>(sink.get_level()) < static_cast<int>(min_level)) {
+                min_level = sink.get_level();
+            }
+        });
+        min_level_.store(min_level, std::memory_order_relaxed);
+    }
+};
+
+} // namespace slog
+
+#endif // __SLOG_STATIC_LOGGER_H__
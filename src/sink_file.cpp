@@ -9,11 +9,13 @@
  * 
  */
 
-#include <sstream>
-#include <iomanip>
+#include <algorithm>
 #include <chrono>
+#include <cstring>
 #include <ctime>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 #include <sys/stat.h>
 #include <unistd.h>
 #include <cstdio>
@@ -43,6 +45,8 @@ File::~File()
 std::shared_ptr<LoggerSink> File::clone(const std::string & logger_name) const 
 {
     auto sink = std::make_shared<File>(level_, filepath_, max_file_size_, max_files_, flush_on_write_);
+    sink->index_every_bytes_ = index_every_bytes_;
+    sink->index_every_ = index_every_;
     sink->setup(logger_name);
     return sink;
 }
@@ -70,10 +74,71 @@ bool File::setup(const std::string & logger_name)
             return false;
         }
     }
+
+    if (index_every_bytes_ > 0 && file_state_->index_every_bytes == 0) {
+        file_state_->index_every_bytes = index_every_bytes_;
+        file_state_->index_every_ms = static_cast<int64_t>(index_every_.count());
+        open_index();
+    }
     
     return true;
 }
 
+void File::enable_time_index(size_t every_bytes, std::chrono::milliseconds every)
+{
+    index_every_bytes_ = (every_bytes > 0) ? every_bytes : 1;
+    index_every_ = every;
+    if (!file_state_) {
+        return;
+    }
+
+    // 已经 setup 过，直接作用于共享状态
+    std::lock_guard<std::mutex> lock(get_file_mutex(filepath_));
+    bool opened = file_state_->index_every_bytes > 0;
+    file_state_->index_every_bytes = index_every_bytes_;
+    file_state_->index_every_ms = static_cast<int64_t>(index_every_.count());
+    if (!opened) {
+        open_index();
+    }
+}
+
+void File::open_index()
+{
+    std::string path = filepath_ + ".idx";
+    struct stat st;
+    bool fresh = (stat(path.c_str(), &st) != 0 || st.st_size == 0);
+
+    // 续写已有索引时沿用它最后一条记录的时间和滞后，保证整个文件的记录不减；
+    // 文件头不同（旧格式或不是索引文件）时重新建立
+    file_state_->max_lag_ms = 0;
+    if (!fresh) {
+        std::ifstream existing(path, std::ios::binary);
+        char magic[sizeof(kTimeIndexMagic)] = {};
+        existing.read(magic, sizeof(magic));
+        if (!existing || std::memcmp(magic, kTimeIndexMagic, sizeof(magic)) != 0) {
+            fresh = true;
+        } else {
+            size_t count = (static_cast<size_t>(st.st_size) - sizeof(kTimeIndexMagic)) / sizeof(TimeIndexEntry);
+            TimeIndexEntry last;
+            if (count > 0 &&
+                existing.seekg(static_cast<std::streamoff>(sizeof(kTimeIndexMagic) + (count - 1) * sizeof(TimeIndexEntry))) &&
+                existing.read(reinterpret_cast<char *>(&last), sizeof(last)))
+            {
+                file_state_->latest_ms = std::max(file_state_->latest_ms, last.timestamp_ms);
+                file_state_->max_lag_ms = last.max_lag_ms;
+            }
+        }
+    }
+
+    file_state_->index.open(path, std::ios::out | (fresh ? std::ios::trunc : std::ios::app) | std::ios::binary);
+    if (fresh && file_state_->index.is_open()) {
+        file_state_->index.write(kTimeIndexMagic, sizeof(kTimeIndexMagic));
+        file_state_->index.flush();
+    }
+    file_state_->last_index_offset = file_state_->current_size;
+    file_state_->last_index_ms = -1;
+}
+
 void File::output(const std::string & logger_name, LogLevel level, std::string const &msg) 
 {    
     if (!file_state_) {
@@ -81,22 +146,88 @@ void File::output(const std::string & logger_name, LogLevel level, std::string c
     }
     
     // 格式化日志消息
-    std::string formatted_msg = format_log_message(logger_name, level, msg);
+    detail::LineBuffer line;
+    append_header(line, logger_name, level);
+    detail::append_string(line, msg);
+    write_line(line);
+}
+
+void File::output_fields(const std::string & logger_name, LogLevel level, fmt::string_view msg, FieldList fields)
+{
+    if (!file_state_) {
+        return;
+    }
+
+    detail::LineBuffer line;
+    append_header(line, logger_name, level);
+    detail::append_string(line, msg);
+    detail::append_fields_text(line, fields);
+    write_line(line);
+}
+
+void File::append_header(detail::LineBuffer & line, fmt::string_view logger_name, LogLevel level)
+{
+    // output timestamp
+    detail::append_timestamp(line, detail::current_timestamp());
     
+    // output log level and logger name
+    detail::append_string(line, " <");
+    detail::append_string(line, log_level_name(level));
+    detail::append_string(line, "> (");
+    detail::append_string(line, logger_name);
+    detail::append_string(line, ") ");
+    detail::append_thread_tag(line);
+}
+
+void File::write_line(detail::LineBuffer & line)
+{
+    if (!file_state_) {
+        return;
+    }
+
+    line.push_back('\n');
+
     // 使用文件路径对应的mutex保护文件写入
     std::lock_guard<std::mutex> lock(get_file_mutex(filepath_));
-    
+    int64_t record_ms = detail::timestamp_epoch_ns(detail::current_timestamp()) / 1000000;
+    write_locked(line.data(), line.size(), record_ms, record_ms);
+}
+
+void File::write_locked(const char *data, size_t size, int64_t min_ms, int64_t max_ms)
+{
     // 检查是否需要rotation
     if (file_state_->max_file_size > 0 && 
-        file_state_->current_size + formatted_msg.size() > file_state_->max_file_size) 
+        file_state_->current_size + size > file_state_->max_file_size) 
     {
         rotate_files();
     }
     
+    // 距上一条索引超过字节数或时间间隔、或者这些行的滞后超过此前的最大滞后时，为它们记录索引；
+    // 索引时间取日志自身的时间（Isolated 等延迟写入的行也按记录时刻索引），并保持不减，供二分查找
+    if (file_state_->index_every_bytes > 0 && file_state_->index.is_open()) {
+        file_state_->latest_ms = std::max(file_state_->latest_ms, max_ms);
+        int64_t lag = file_state_->latest_ms - min_ms;
+        bool lagging = lag > file_state_->max_lag_ms;
+        if (lagging) {
+            file_state_->max_lag_ms = lag;
+        }
+        if (lagging || file_state_->last_index_ms < 0 ||
+            file_state_->current_size - file_state_->last_index_offset >= file_state_->index_every_bytes ||
+            file_state_->latest_ms - file_state_->last_index_ms >= file_state_->index_every_ms)
+        {
+            TimeIndexEntry entry = {file_state_->latest_ms, static_cast<uint64_t>(file_state_->current_size),
+                                    file_state_->max_lag_ms};
+            file_state_->index.write(reinterpret_cast<const char *>(&entry), sizeof(entry));
+            file_state_->index.flush();
+            file_state_->last_index_offset = file_state_->current_size;
+            file_state_->last_index_ms = file_state_->latest_ms;
+        }
+    }
+
     // 写入文件
     if (file_state_->file.is_open()) {
-        file_state_->file << formatted_msg;
-        file_state_->current_size += formatted_msg.size();
+        file_state_->file.write(data, static_cast<std::streamsize>(size));
+        file_state_->current_size += size;
         
         // 根据配置决定是否立即刷新
         if (file_state_->flush_on_write) {
@@ -105,11 +236,92 @@ void File::output(const std::string & logger_name, LogLevel level, std::string c
     }
 }
 
+void File::append_line(detail::LineBuffer & line, fmt::string_view logger_name, LogLevel level, fmt::string_view msg)
+{
+    append_header(line, logger_name, level);
+    detail::append_string(line, msg);
+}
+
+void File::output_batch(const std::string & logger_name, Batch const & batch, LogLevel level)
+{
+    if (!file_state_) {
+        return;
+    }
+
+    detail::LineBuffer lines;
+    lines.reserve(batch.bytes() + batch.size() * 48);
+    // 每行的起始偏移和时间（epoch 毫秒），分块写入时按块内各行的时间范围记录索引
+    std::vector<std::pair<size_t, int64_t>> starts;
+    starts.reserve(batch.size());
+    for (size_t i = 0; i < batch.size(); ++i) {
+        Batch::Record record = batch[i];
+        if (static_cast<int>(record.level) < static_cast<int>(level)) {
+            continue;
+        }
+        starts.emplace_back(lines.size(), detail::timestamp_epoch_ns(record.timestamp) / 1000000);
+        detail::RecordTimeScope time_scope(record.timestamp);
+        append_line(lines, logger_name, record.level, record.msg);
+        lines.push_back('\n');
+    }
+    if (lines.size() == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(get_file_mutex(filepath_));
+    const char *data = lines.data();
+    size_t const size = lines.size();
+    size_t start = 0;
+    size_t line = 0;
+    while (start < size) {
+        // 每块不超过当前文件的剩余空间和索引间隔，在行尾切开；一行也放不下时单独写入这一行（先轮转）
+        size_t limit = size - start;
+        if (file_state_->max_file_size > 0) {
+            size_t room = file_state_->max_file_size > file_state_->current_size
+                ? file_state_->max_file_size - file_state_->current_size : 0;
+            limit = std::min(limit, room);
+        }
+        if (file_state_->index_every_bytes > 0 && file_state_->index.is_open()) {
+            limit = std::min(limit, file_state_->index_every_bytes);
+        }
+
+        size_t end = size;
+        if (limit < size - start) {
+            end = start + limit;
+            while (end > start && data[end - 1] != '\n') {
+                --end;
+            }
+            if (end == start) {
+                end = static_cast<size_t>(static_cast<const char *>(
+                    std::memchr(data + start, '\n', size - start)) - data) + 1;
+            }
+        }
+        int64_t min_ms = starts[line].second;
+        int64_t max_ms = min_ms;
+        for (; line < starts.size() && starts[line].first < end; ++line) {
+            min_ms = std::min(min_ms, starts[line].second);
+            max_ms = std::max(max_ms, starts[line].second);
+        }
+        write_locked(data + start, end - start, min_ms, max_ms);
+        start = end;
+    }
+}
+
 const char* File::name() const 
 { 
     return "File"; 
 }
 
+void File::flush()
+{
+    if (!file_state_) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(get_file_mutex(filepath_));
+    if (file_state_->file.is_open()) {
+        file_state_->file.flush();
+    }
+}
+
 std::mutex& File::get_file_mutex(std::string const & filepath) 
 {
     static std::mutex map_mutex;
@@ -146,26 +358,6 @@ std::shared_ptr<SharedFileState> File::get_shared_file_state(
     return state;
 }
 
-std::string File::format_log_message(const std::string & logger_name, LogLevel level, std::string const &msg) 
-{
-    auto now = std::chrono::system_clock::now();
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now.time_since_epoch()).count();
-    std::time_t time = std::chrono::system_clock::to_time_t(now);
-    std::tm tm = *std::localtime(&time);
-    std::ostringstream oss;
-    
-    // output timestamp
-    oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S.");
-    oss << std::setfill('0') << std::setw(3) << ms % 1000;
-    
-    // output log level and logger name
-    oss << " <" << log_level_name(level) << "> (" << logger_name << ") ";
-    oss << msg << "\n";
-    
-    return oss.str();
-}
-
 void File::rotate_files() 
 {
     if (!file_state_) 
@@ -178,6 +370,11 @@ void File::rotate_files()
         file_state_->file.flush();
         file_state_->file.close();
     }
+    bool indexed = file_state_->index.is_open();
+    if (indexed)
+    {
+        file_state_->index.close();
+    }
     
     // 删除最旧的文件
     if (file_state_->max_files > 0) 
@@ -188,6 +385,7 @@ void File::rotate_files()
         {
             std::remove(oldest_file.c_str());
         }
+        std::remove((oldest_file + ".idx").c_str());
     }
     
     // 将旧文件依次重命名
@@ -201,11 +399,21 @@ void File::rotate_files()
         {
             std::rename(old_name.c_str(), new_name.c_str());
         }
+        // 索引随日志文件改名：filename.idx -> filename.1.idx, ...
+        std::string old_index = old_name + ".idx";
+        if (stat(old_index.c_str(), &st) == 0) 
+        {
+            std::rename(old_index.c_str(), (new_name + ".idx").c_str());
+        }
     }
     
     // 重新打开文件
     file_state_->file.open(filepath_, std::ios::out | std::ios::app);
     file_state_->current_size = 0;
+    if (indexed)
+    {
+        open_index();
+    }
 }
 
 } // namespace sink
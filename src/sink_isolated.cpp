@@ -0,0 +1,290 @@
+/**
+ * @file sink_isolated.cpp
+ * @author LiuChuansen (179712066@qq.com)
+ * @brief Isolated Sink实现
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+
+#include "slog/sink_isolated.hpp"
+
+namespace slog {
+namespace sink {
+
+Isolated::Isolated(std::shared_ptr<LoggerSink> child, size_t queue_size)
+    : LoggerSink(child ? child->get_level() : LogLevel::Off)
+    , child_(std::move(child))
+    , queue_size_(std::max<size_t>(queue_size, 1))
+    , bound_name_(nullptr)
+    , slots_(queue_size_)
+    , head_(0)
+    , count_(0)
+    , stopping_(false)
+{
+}
+
+Isolated::~Isolated()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+    }
+    not_empty_.notify_one();
+    // 工作线程把已入队的记录全部交给子 sink 后退出
+    if (worker_.joinable()) {
+        worker_.join();
+    }
+}
+
+std::shared_ptr<LoggerSink> Isolated::clone(const std::string & logger_name) const
+{
+    auto child = child_ ? child_->clone(logger_name) : nullptr;
+    if (!child) {
+        return nullptr;
+    }
+    auto sink = std::make_shared<Isolated>(std::move(child), queue_size_);
+    sink->set_level(level_);
+    sink->setup(logger_name);
+    return sink;
+}
+
+bool Isolated::setup(const std::string & logger_name)
+{
+    if (!child_ || !child_->setup(logger_name)) {
+        return false;
+    }
+
+    // clone() 传入的可能是临时字符串，绑定到驻留的名称；Logger 输出时传回的正是这个引用
+    std::string const *bound_name = &detail::intern_logger_name(logger_name).name;
+    std::lock_guard<std::mutex> lock(mutex_);
+    bound_name_ = bound_name;
+    if (!worker_.joinable()) {
+        worker_ = std::thread([this]() { run(); });
+    }
+    return true;
+}
+
+void Isolated::on_level_changed(LogLevel level)
+{
+    // Logger::set_level / 全局规则作用于包装 sink，同步给子 sink
+    if (!child_) {
+        return;
+    }
+    // set_rule_level() 传入的等级就是 rule_level_（清除规则时为 Unknown，子 sink 随之恢复自身等级）
+    if (level == rule_level_) {
+        child_->set_rule_level(level);
+    } else {
+        child_->set_level(level);
+    }
+}
+
+const char* Isolated::name() const
+{
+    return "Isolated";
+}
+
+IsolatedStats Isolated::stats() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    IsolatedStats stats = stats_;
+    stats.queue_depth = count_;
+    return stats;
+}
+
+uint64_t Isolated::dropped() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_.dropped;
+}
+
+bool Isolated::flush(std::chrono::milliseconds timeout)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    return idle_.wait_for(lock, timeout, [this]() { return count_ == 0; });
+}
+
+void Isolated::flush()
+{
+    flush(std::chrono::milliseconds(1000));
+    if (child_) {
+        child_->flush();
+    }
+}
+
+void Isolated::append_stats(std::string & out) const
+{
+    IsolatedStats current = stats();
+    fmt::format_to(std::back_inserter(out), " enqueued={} processed={} dropped={} queue_depth={} max_lag_us={}",
+        current.enqueued, current.processed, current.dropped, current.queue_depth, current.max_lag_us);
+}
+
+Isolated::Entry *Isolated::acquire_slot(const std::string & logger_name, LogLevel level)
+{
+    if (stopping_ || !worker_.joinable() || count_ == queue_size_) {
+        stats_.dropped++;
+        return nullptr;
+    }
+
+    Entry & entry = slots_[(head_ + count_) % queue_size_];
+    if (&logger_name == bound_name_) {
+        entry.name = bound_name_;
+    } else {
+        // 未绑定的名称可能是临时对象，复制一份
+        entry.name_copy = logger_name;
+        entry.name = &entry.name_copy;
+    }
+    entry.level = level;
+    entry.enqueued = std::chrono::steady_clock::now();
+    entry.timestamp = detail::current_timestamp();
+    entry.thread = detail::record_thread();
+    return &entry;
+}
+
+void Isolated::commit_slot()
+{
+    count_++;
+    stats_.enqueued++;
+    // 队列从空变为非空时工作线程可能在等待
+    if (count_ == 1) {
+        not_empty_.notify_one();
+    }
+}
+
+void Isolated::output(const std::string & logger_name, LogLevel level, std::string const &msg)
+{
+    if (static_cast<int>(level) < static_cast<int>(child_->get_level())) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry *entry = acquire_slot(logger_name, level);
+    if (entry == nullptr) {
+        return;
+    }
+    entry->msg.assign(msg);
+    entry->has_fields = false;
+    commit_slot();
+}
+
+void Isolated::output_fields(const std::string & logger_name, LogLevel level, fmt::string_view msg, FieldList fields)
+{
+    if (static_cast<int>(level) < static_cast<int>(child_->get_level())) {
+        return;
+    }
+
+    // 字段引用调用者的数据，先在锁外把自定义类型格式化为文本
+    detail::LineBuffer custom;
+    std::vector<size_t> custom_ends;
+    for (Field const & field : fields) {
+        if (field.type() == Field::Type::Custom) {
+            field.format_value(custom);
+            custom_ends.push_back(custom.size());
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    Entry *entry = acquire_slot(logger_name, level);
+    if (entry == nullptr) {
+        return;
+    }
+    entry->msg.assign(msg.data(), msg.size());
+    entry->has_fields = true;
+
+    // 先把键名和字符串值全部复制进 storage，再按偏移建立 Field，避免 storage 扩容后失效
+    std::string & storage = entry->storage;
+    storage.clear();
+    for (Field const & field : fields) {
+        storage.append(field.key().data(), field.key().size());
+        if (field.type() == Field::Type::String) {
+            storage.append(field.as_string().data(), field.as_string().size());
+        }
+    }
+    storage.append(custom.data(), custom.size());
+
+    entry->fields.clear();
+    size_t offset = 0;
+    size_t custom_base = storage.size() - custom.size();
+    size_t custom_begin = custom_base;
+    size_t custom_index = 0;
+    for (Field const & field : fields) {
+        fmt::string_view key(storage.data() + offset, field.key().size());
+        offset += key.size();
+        switch (field.type()) {
+        case Field::Type::Int:
+            entry->fields.emplace_back(key, field.as_int());
+            break;
+        case Field::Type::UInt:
+            entry->fields.emplace_back(key, field.as_uint());
+            break;
+        case Field::Type::Double:
+            entry->fields.emplace_back(key, field.as_double());
+            break;
+        case Field::Type::Bool:
+            entry->fields.emplace_back(key, field.as_bool());
+            break;
+        case Field::Type::String:
+            entry->fields.emplace_back(key, fmt::string_view(storage.data() + offset, field.as_string().size()));
+            offset += field.as_string().size();
+            break;
+        case Field::Type::Custom:
+        {
+            size_t custom_end = custom_base + custom_ends[custom_index++];
+            entry->fields.emplace_back(key, fmt::string_view(storage.data() + custom_begin, custom_end - custom_begin));
+            custom_begin = custom_end;
+            break;
+        }
+        }
+    }
+    commit_slot();
+}
+
+void Isolated::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        not_empty_.wait(lock, [this]() { return count_ > 0 || stopping_; });
+        if (count_ == 0) {
+            break;
+        }
+
+        // 处理期间槽位仍计入 count_，调用线程不会覆盖它们
+        size_t start = head_;
+        size_t busy = count_;
+        lock.unlock();
+
+        uint64_t last_lag = 0;
+        uint64_t max_lag = 0;
+        for (size_t i = 0; i < busy; ++i) {
+            Entry & entry = slots_[(start + i) % queue_size_];
+            detail::RecordTimeScope time_scope(entry.timestamp);
+            detail::RecordThreadScope thread_scope(entry.thread);
+            if (entry.has_fields) {
+                child_->output_fields(*entry.name, entry.level, entry.msg,
+                                      FieldList{entry.fields.data(), entry.fields.size()});
+            } else {
+                child_->output(*entry.name, entry.level, entry.msg);
+            }
+            last_lag = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                std::chrono::steady_clock::now() - entry.enqueued).count());
+            max_lag = std::max(max_lag, last_lag);
+        }
+
+        lock.lock();
+        head_ = (start + busy) % queue_size_;
+        count_ -= busy;
+        stats_.processed += busy;
+        stats_.last_lag_us = last_lag;
+        stats_.max_lag_us = std::max(stats_.max_lag_us, max_lag);
+        if (count_ == 0) {
+            idle_.notify_all();
+        }
+    }
+}
+
+} // namespace sink
+} // namespace slog
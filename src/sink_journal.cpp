@@ -0,0 +1,296 @@
+/**
+ * @file sink_journal.cpp
+ * @author LiuChuansen (179712066@qq.com)
+ * @brief systemd journal Sink实现
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "slog/sink_journal.hpp"
+#include "slog/sink_syslog.hpp"
+
+namespace slog {
+namespace sink {
+
+namespace {
+
+int create_memfd(const char *name)
+{
+#if defined(SYS_memfd_create) && defined(MFD_ALLOW_SEALING)
+    return static_cast<int>(syscall(SYS_memfd_create, name, MFD_CLOEXEC | MFD_ALLOW_SEALING));
+#else
+    (void)name;
+    errno = ENOSYS;
+    return -1;
+#endif
+}
+
+/// 把结构化字段的键名转换为 journal 字段名：大写字母、数字、下划线，不以下划线或数字开头，最长 64
+void append_journal_key(detail::LineBuffer & buf, fmt::string_view key)
+{
+    static const char prefix[] = "FIELD_";
+    constexpr size_t max_size = 64;
+
+    bool need_prefix = (key.size() == 0 || key[0] == '_' || (key[0] >= '0' && key[0] <= '9'));
+    size_t size = 0;
+    if (need_prefix) {
+        detail::append_string(buf, prefix);
+        size = sizeof(prefix) - 1;
+    }
+    for (size_t i = 0; i < key.size() && size < max_size; ++i, ++size) {
+        char c = key[i];
+        if (c >= 'a' && c <= 'z') {
+            buf.push_back(static_cast<char>(c - 'a' + 'A'));
+        } else if ((c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9')) {
+            buf.push_back(c);
+        } else {
+            buf.push_back('_');
+        }
+    }
+}
+
+} // namespace
+
+Journal::Journal(LogLevel level, std::string const & socket_path)
+    : LoggerSink(level)
+    , socket_path_(socket_path)
+    , memfd_threshold_(16 * 1024)
+    , fd_(-1)
+    , dropped_(0)
+{
+}
+
+Journal::~Journal()
+{
+    if (fd_ >= 0) {
+        close(fd_);
+    }
+}
+
+std::shared_ptr<LoggerSink> Journal::clone(const std::string & logger_name) const
+{
+    auto sink = std::make_shared<Journal>(level_, socket_path_);
+    sink->set_memfd_threshold(memfd_threshold_);
+    sink->setup(logger_name);
+    return sink;
+}
+
+bool Journal::setup(const std::string & logger_name)
+{
+    (void)logger_name;
+    if (fd_ >= 0) {
+        return true;
+    }
+
+    struct sockaddr_un addr;
+    if (socket_path_.size() >= sizeof(addr.sun_path)) {
+        return false;
+    }
+
+    // 未连接的套接字，每次 sendto 指定地址，journald 重启后无需重连
+    fd_ = socket(AF_UNIX, SOCK_DGRAM | SOCK_CLOEXEC | SOCK_NONBLOCK, 0);
+    if (fd_ < 0) {
+        return false;
+    }
+
+    // 与 libsystemd 相同：尽量增大发送缓冲区，减少大记录走 memfd 的次数
+    int sndbuf = 8 * 1024 * 1024;
+    setsockopt(fd_, SOL_SOCKET, SO_SNDBUF, &sndbuf, sizeof(sndbuf));
+    return true;
+}
+
+const char* Journal::name() const
+{
+    return "Journal";
+}
+
+void Journal::append_stats(std::string & out) const
+{
+    fmt::format_to(std::back_inserter(out), " dropped={}", dropped());
+}
+
+void Journal::append_field(detail::LineBuffer & buf, fmt::string_view key, fmt::string_view value)
+{
+    detail::append_string(buf, key);
+    if (std::memchr(value.data(), '\n', value.size()) == nullptr) {
+        buf.push_back('=');
+        detail::append_string(buf, value);
+        buf.push_back('\n');
+        return;
+    }
+
+    buf.push_back('\n');
+    uint64_t size = value.size();
+    char length[8];
+    for (int i = 0; i < 8; ++i) {
+        length[i] = static_cast<char>((size >> (8 * i)) & 0xFF);
+    }
+    buf.append(length, length + 8);
+    detail::append_string(buf, value);
+    buf.push_back('\n');
+}
+
+void Journal::append_common(detail::LineBuffer & buf, fmt::string_view logger_name, LogLevel level)
+{
+    const char priority[] = {'P', 'R', 'I', 'O', 'R', 'I', 'T', 'Y', '=',
+                             static_cast<char>('0' + Syslog::severity(level)), '\n'};
+    buf.append(priority, priority + sizeof(priority));
+    append_field(buf, "SYSLOG_IDENTIFIER", logger_name);
+
+    detail::ThreadInfo const &thread = detail::record_thread();
+    fmt::format_int tid(thread.id);
+    append_field(buf, "TID", fmt::string_view(tid.data(), tid.size()));
+    if (thread.name_size > 0) {
+        append_field(buf, "THREAD_NAME", thread.thread_name());
+    }
+
+    SourceSite const *site = current_source_site();
+    if (site != nullptr) {
+        append_field(buf, "CODE_FILE", site->file);
+        fmt::format_int line(site->line);
+        append_field(buf, "CODE_LINE", fmt::string_view(line.data(), line.size()));
+        append_field(buf, "CODE_FUNC", site->function);
+    }
+}
+
+void Journal::output(const std::string & logger_name, LogLevel level, std::string const &msg)
+{
+    detail::LineBuffer buf;
+    append_field(buf, "MESSAGE", msg);
+    append_common(buf, logger_name, level);
+    send_record(buf);
+}
+
+void Journal::output_fields(const std::string & logger_name, LogLevel level, fmt::string_view msg, FieldList fields)
+{
+    detail::LineBuffer buf;
+    append_field(buf, "MESSAGE", msg);
+    append_common(buf, logger_name, level);
+
+    detail::LineBuffer key;
+    detail::LineBuffer value;
+    for (Field const & field : fields) {
+        key.clear();
+        value.clear();
+        append_journal_key(key, field.key());
+        field.format_value(value);
+        append_field(buf, fmt::string_view(key.data(), key.size()), fmt::string_view(value.data(), value.size()));
+    }
+    send_record(buf);
+}
+
+void Journal::send_record(detail::LineBuffer const & buf)
+{
+    if (fd_ < 0) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    if (buf.size() > memfd_threshold_ && send_memfd(buf)) {
+        return;
+    }
+
+    struct sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, socket_path_.c_str(), socket_path_.size() + 1);
+
+    ssize_t sent;
+    do {
+        sent = sendto(fd_, buf.data(), buf.size(), MSG_NOSIGNAL,
+                      reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr));
+    } while (sent < 0 && errno == EINTR);
+
+    if (sent < 0) {
+        // 超过套接字允许的数据报大小时改用 memfd（阈值设置得比内核限制大时）
+        if (errno == EMSGSIZE && buf.size() <= memfd_threshold_ && send_memfd(buf)) {
+            return;
+        }
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+bool Journal::send_memfd(detail::LineBuffer const & buf)
+{
+    int memfd = create_memfd("slog-journal");
+    if (memfd < 0) {
+        return false;
+    }
+
+    const char *data = buf.data();
+    size_t left = buf.size();
+    while (left > 0) {
+        ssize_t written = write(memfd, data, left);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            close(memfd);
+            return false;
+        }
+        data += written;
+        left -= static_cast<size_t>(written);
+    }
+
+    // journald 只接受密封后不可再修改的 memfd
+#if defined(F_ADD_SEALS)
+    if (fcntl(memfd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_WRITE | F_SEAL_SEAL) < 0) {
+        close(memfd);
+        return false;
+    }
+#endif
+
+    struct sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, socket_path_.c_str(), socket_path_.size() + 1);
+
+    union
+    {
+        struct cmsghdr header;
+        char data[CMSG_SPACE(sizeof(int))];
+    } control;
+    std::memset(&control, 0, sizeof(control));
+
+    struct msghdr msg;
+    std::memset(&msg, 0, sizeof(msg));
+    msg.msg_name = &addr;
+    msg.msg_namelen = sizeof(addr);
+    msg.msg_control = control.data;
+    msg.msg_controllen = sizeof(control.data);
+
+    struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type = SCM_RIGHTS;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+    std::memcpy(CMSG_DATA(cmsg), &memfd, sizeof(int));
+
+    ssize_t sent;
+    do {
+        sent = sendmsg(fd_, &msg, MSG_NOSIGNAL);
+    } while (sent < 0 && errno == EINTR);
+    close(memfd);
+
+    if (sent < 0) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+    // 已经尝试过 memfd，失败时不再退回普通数据报
+    return true;
+}
+
+} // namespace sink
+} // namespace slog
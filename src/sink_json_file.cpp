@@ -0,0 +1,261 @@
+/**
+ * @file sink_json_file.cpp
+ * @author LiuChuansen (179712066@qq.com)
+ * @brief JSON Lines 文件 Sink实现
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <chrono>
+#include <cmath>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#include "slog/sink_json_file.hpp"
+
+namespace slog {
+namespace detail {
+
+namespace {
+
+inline bool json_needs_escape(unsigned char c)
+{
+    return c == '"' || c == '\\' || c < 0x20;
+}
+
+/// 在缓冲区尾部预留 n 字节，返回写入位置（缓冲区 size 同时增加 n）
+inline char *grow_by(LineBuffer &buf, size_t n)
+{
+    size_t pos = buf.size();
+    buf.resize(pos + n);
+    return buf.data() + pos;
+}
+
+/// 写入一个转义序列，返回新的写入位置；调用前需保证至少 6 字节的空间
+char *write_json_escape(char *out, unsigned char c)
+{
+    static const char hex[] = "0123456789abcdef";
+    *out++ = '\\';
+    switch (c) {
+    case '"':  *out++ = '"';  break;
+    case '\\': *out++ = '\\'; break;
+    case '\n': *out++ = 'n';  break;
+    case '\r': *out++ = 'r';  break;
+    case '\t': *out++ = 't';  break;
+    case '\b': *out++ = 'b';  break;
+    case '\f': *out++ = 'f';  break;
+    default:
+        *out++ = 'u';
+        *out++ = '0';
+        *out++ = '0';
+        *out++ = hex[c >> 4];
+        *out++ = hex[c & 0x0F];
+        break;
+    }
+    return out;
+}
+
+/**
+ * @brief 输出一个需要转义的字符
+ * 
+ * 缓冲区按“每个输入字节输出一个字节”预留，转义序列最多多出 5 个字节，先扩容再写入。
+ * 扩容可能使写入指针失效，因此以偏移量重新计算。
+ */
+inline char *escape_one(LineBuffer &buf, char *out, unsigned char c)
+{
+    size_t used = static_cast<size_t>(out - buf.data());
+    buf.resize(buf.size() + 5);
+    return write_json_escape(buf.data() + used, c);
+}
+
+template<size_t N>
+inline void append_literal(LineBuffer &buf, const char (&str)[N])
+{
+    std::memcpy(grow_by(buf, N - 1), str, N - 1);
+}
+
+} // namespace
+
+void append_json_string(LineBuffer &buf, fmt::string_view str)
+{
+    const char *p = str.data();
+    const char *end = p + str.size();
+
+    // 先按没有转义字符预留空间，整段直接写入缓冲区
+    char *out = grow_by(buf, str.size() + 2);
+    *out++ = '"';
+
+#if defined(__SSE2__)
+    const __m128i quote = _mm_set1_epi8('"');
+    const __m128i backslash = _mm_set1_epi8('\\');
+    const __m128i control = _mm_set1_epi8(0x1F);
+    while (end - p >= 16) {
+        __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i *>(p));
+        // 无符号 v <= 0x1F 等价于 min(v, 0x1F) == v
+        __m128i hit = _mm_or_si128(_mm_or_si128(_mm_cmpeq_epi8(v, quote), _mm_cmpeq_epi8(v, backslash)),
+                                   _mm_cmpeq_epi8(_mm_min_epu8(v, control), v));
+        int mask = _mm_movemask_epi8(hit);
+        if (mask == 0) {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out), v);
+            out += 16;
+            p += 16;
+            continue;
+        }
+        size_t clean = static_cast<size_t>(__builtin_ctz(static_cast<unsigned>(mask)));
+        std::memcpy(out, p, clean);
+        out = escape_one(buf, out + clean, static_cast<unsigned char>(p[clean]));
+        p += clean + 1;
+    }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    const uint8x16_t quote = vdupq_n_u8('"');
+    const uint8x16_t backslash = vdupq_n_u8('\\');
+    const uint8x16_t control = vdupq_n_u8(0x1F);
+    while (end - p >= 16) {
+        uint8x16_t v = vld1q_u8(reinterpret_cast<const uint8_t *>(p));
+        uint8x16_t hit = vorrq_u8(vorrq_u8(vceqq_u8(v, quote), vceqq_u8(v, backslash)), vcleq_u8(v, control));
+        if (vmaxvq_u8(hit) == 0) {
+            vst1q_u8(reinterpret_cast<uint8_t *>(out), v);
+            out += 16;
+            p += 16;
+            continue;
+        }
+        // 块内至少有一个需要转义的字符，逐字节定位
+        while (!json_needs_escape(static_cast<unsigned char>(*p))) {
+            *out++ = *p++;
+        }
+        out = escape_one(buf, out, static_cast<unsigned char>(*p));
+        ++p;
+    }
+#endif
+
+    for (; p < end; ++p) {
+        unsigned char c = static_cast<unsigned char>(*p);
+        if (json_needs_escape(c)) {
+            out = escape_one(buf, out, c);
+        } else {
+            *out++ = *p;
+        }
+    }
+    *out++ = '"';
+    // 两字符的转义序列没有用完预留的空间
+    buf.resize(static_cast<size_t>(out - buf.data()));
+}
+
+void append_fields_json(LineBuffer &buf, FieldList fields)
+{
+    bool first = true;
+    for (Field const &field : fields) {
+        if (!first) {
+            buf.push_back(',');
+        }
+        first = false;
+
+        append_json_string(buf, field.key());
+        buf.push_back(':');
+        switch (field.type()) {
+        case Field::Type::String:
+            append_json_string(buf, field.as_string());
+            break;
+        case Field::Type::Custom: {
+            LineBuffer value;
+            field.format_value(value);
+            append_json_string(buf, fmt::string_view(value.data(), value.size()));
+            break;
+        }
+        case Field::Type::Double:
+            // JSON 不支持 NaN/Inf
+            if (std::isfinite(field.as_double())) {
+                field.format_value(buf);
+            } else {
+                append_string(buf, "null");
+            }
+            break;
+        default:
+            field.format_value(buf);
+            break;
+        }
+    }
+}
+
+} // namespace detail
+
+namespace sink {
+
+std::shared_ptr<LoggerSink> JsonFile::clone(const std::string & logger_name) const
+{
+    auto sink = std::make_shared<JsonFile>(level_, filepath_, max_file_size_, max_files_, flush_on_write_);
+    sink->index_every_bytes_ = index_every_bytes_;
+    sink->index_every_ = index_every_;
+    sink->setup(logger_name);
+    return sink;
+}
+
+const char* JsonFile::name() const
+{
+    return "JsonFile";
+}
+
+void JsonFile::append_record(detail::LineBuffer & line, fmt::string_view logger_name, LogLevel level, fmt::string_view msg)
+{
+    // 固定的键名按字面量整段拷贝，避免逐段计算长度
+    detail::append_literal(line, "{\"ts\":\"");
+    size_t ts = line.size();
+    detail::append_timestamp(line, detail::current_timestamp());
+    // "YYYY-mm-dd HH:MM:SS.mmm" -> "YYYY-mm-ddTHH:MM:SS.mmm"（单调时钟的秒数没有日期部分）
+    if (line.size() > ts + 10 && line[ts + 10] == ' ') {
+        line[ts + 10] = 'T';
+    }
+
+    detail::append_literal(line, "\",\"level\":\"");
+    detail::append_string(line, log_level_name(level));
+    detail::append_literal(line, "\",\"logger\":");
+    detail::append_json_string(line, logger_name);
+    detail::ThreadInfo const &thread = detail::record_thread();
+    detail::append_literal(line, ",\"thread\":");
+    fmt::format_int tid(thread.id);
+    std::memcpy(detail::grow_by(line, tid.size()), tid.data(), tid.size());
+    if (thread.name_size > 0) {
+        detail::append_literal(line, ",\"thread_name\":");
+        detail::append_json_string(line, thread.thread_name());
+    }
+    detail::append_literal(line, ",\"msg\":");
+    detail::append_json_string(line, msg);
+}
+
+void JsonFile::output(const std::string & logger_name, LogLevel level, std::string const &msg)
+{
+    detail::LineBuffer line;
+    append_record(line, logger_name, level, msg);
+    line.push_back('}');
+    write_line(line);
+}
+
+void JsonFile::append_line(detail::LineBuffer & line, fmt::string_view logger_name, LogLevel level, fmt::string_view msg)
+{
+    append_record(line, logger_name, level, msg);
+    line.push_back('}');
+}
+
+void JsonFile::output_fields(const std::string & logger_name, LogLevel level, fmt::string_view msg, FieldList fields)
+{
+    detail::LineBuffer line;
+    append_record(line, logger_name, level, msg);
+    if (!fields.empty()) {
+        detail::append_string(line, ",\"fields\":{");
+        detail::append_fields_json(line, fields);
+        line.push_back('}');
+    }
+    line.push_back('}');
+    write_line(line);
+}
+
+} // namespace sink
+} // namespace slog
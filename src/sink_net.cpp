@@ -0,0 +1,649 @@
+/**
+ * @file sink_net.cpp
+ * @author LiuChuansen (179712066@qq.com)
+ * @brief 网络 Sink实现
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#if defined(SLOG_WITH_LZ4)
+#include <lz4.h>
+#endif
+
+#include "slog/sink_net.hpp"
+#include "slog/sink_file.hpp"
+
+namespace slog {
+namespace sink {
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+/// 阻塞等待（连接、可写）时的轮询间隔，期间检查是否需要退出
+constexpr int kPollSliceMs = 100;
+
+/// 非阻塞连接的超时时间
+constexpr std::chrono::milliseconds kConnectTimeout{3000};
+
+/// TCP 帧头：4 字节长度 + 1 字节标志
+constexpr size_t kFrameHeaderSize = 5;
+
+/// 压缩数据前的原始长度
+constexpr size_t kRawSizeSize = 4;
+
+constexpr char kFlagLz4 = 0x01;
+
+void put_be32(char *out, uint32_t value)
+{
+    out[0] = static_cast<char>((value >> 24) & 0xFF);
+    out[1] = static_cast<char>((value >> 16) & 0xFF);
+    out[2] = static_cast<char>((value >> 8) & 0xFF);
+    out[3] = static_cast<char>(value & 0xFF);
+}
+
+} // namespace
+
+/**
+ * @brief 连接和发送线程
+ *
+ * 调用线程在 mutex_ 下追加记录到 pending_；发送线程取走整批后在锁外编码、发送。
+ * batch_ 及套接字只由发送线程访问。
+ */
+class Net::Channel
+{
+public:
+    Channel(std::string const & host, uint16_t port, NetProtocol protocol, NetOptions const & options);
+
+    ~Channel();
+
+    void start();
+
+    void submit(const char *data, size_t size);
+
+    void flush();
+
+    std::atomic<uint64_t> dropped;
+    std::atomic<uint64_t> sent;
+    std::atomic<uint64_t> reconnects;
+
+private:
+    std::string host_;
+    uint16_t port_;
+    NetProtocol protocol_;
+    NetOptions options_;
+    bool compress_;
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    /// 待发送的记录，pending_ends_ 为每条记录在 pending_ 中的结束位置
+    std::string pending_;
+    std::vector<size_t> pending_ends_;
+    Clock::time_point pending_since_;
+    /// 发送线程手中尚未发出的字节数，与 pending_ 一起受 spill_bytes 限制
+    size_t inflight_bytes_;
+    bool flush_requested_;
+    bool stopping_;
+    std::atomic<bool> stop_flag_;
+    Clock::time_point stop_deadline_;
+    std::thread thread_;
+
+    /// 发送线程取走的批次，batch_record_ 之前的记录已发出
+    std::string batch_;
+    std::vector<size_t> batch_ends_;
+    size_t batch_record_;
+    /// 编码后的帧/数据报
+    std::string frame_;
+
+    int fd_;
+    bool ever_connected_;
+    std::chrono::milliseconds backoff_;
+    Clock::time_point next_connect_;
+
+    void run();
+
+    /// 等待下一批工作，返回 false 表示发送线程应当退出
+    bool wait_work(std::unique_lock<std::mutex> & lock);
+
+    bool connect_socket();
+
+    void close_socket();
+
+    /// 连接失败或断开后计算下一次重连时间
+    void schedule_reconnect();
+
+    /// 发送 batch_ 中剩余的记录，连接出错时返回 false
+    bool deliver();
+
+    /// 编码 [data, data + size) 为一帧（TCP）或一个数据报（UDP），返回待发送的数据
+    fmt::string_view encode(const char *data, size_t size);
+
+    bool send_stream(fmt::string_view data);
+
+    /// 发送一个数据报，返回 false 表示需要重连
+    bool send_datagram(fmt::string_view data, size_t records);
+
+    /// 等待套接字可写，需要退出时返回 false
+    bool wait_writable(int fd);
+
+    /// 析构时等待发送的时间已用完
+    bool stop_expired() const
+    {
+        return stop_flag_.load(std::memory_order_acquire) && Clock::now() >= stop_deadline_;
+    }
+
+    /// 检查 TCP 对端是否已关闭连接（丢弃对端发来的数据）
+    bool peer_closed();
+};
+
+Net::Channel::Channel(std::string const & host, uint16_t port, NetProtocol protocol, NetOptions const & options)
+    : dropped(0)
+    , sent(0)
+    , reconnects(0)
+    , host_(host)
+    , port_(port)
+    , protocol_(protocol)
+    , options_(options)
+    , compress_(options.compress && Net::compression_supported())
+    , inflight_bytes_(0)
+    , flush_requested_(false)
+    , stopping_(false)
+    , stop_flag_(false)
+    , batch_record_(0)
+    , fd_(-1)
+    , ever_connected_(false)
+    , backoff_(0)
+{
+    options_.batch_records = std::max<size_t>(options_.batch_records, 1);
+    options_.max_datagram_size = std::max<size_t>(options_.max_datagram_size, 64);
+}
+
+Net::Channel::~Channel()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stopping_ = true;
+        stop_deadline_ = Clock::now() + options_.linger;
+    }
+    stop_flag_.store(true, std::memory_order_release);
+    cond_.notify_one();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+
+    close_socket();
+    dropped.fetch_add(pending_ends_.size() + (batch_ends_.size() - batch_record_), std::memory_order_relaxed);
+}
+
+void Net::Channel::start()
+{
+    thread_ = std::thread([this]() { run(); });
+}
+
+void Net::Channel::submit(const char *data, size_t size)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (stopping_ || pending_.size() + inflight_bytes_ + size > options_.spill_bytes) {
+        lock.unlock();
+        dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    bool first = pending_ends_.empty();
+    if (first) {
+        pending_since_ = Clock::now();
+    }
+    pending_.append(data, size);
+    pending_ends_.push_back(pending_.size());
+    // 只在批次开始（启动计时）和刚好凑满时唤醒发送线程
+    bool full = (pending_ends_.size() == options_.batch_records)
+        || (pending_.size() >= options_.batch_bytes && pending_.size() - size < options_.batch_bytes);
+    lock.unlock();
+
+    if (first || full) {
+        cond_.notify_one();
+    }
+}
+
+void Net::Channel::flush()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        flush_requested_ = true;
+    }
+    cond_.notify_one();
+}
+
+void Net::Channel::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    for (;;) {
+        inflight_bytes_ = batch_.size() - (batch_record_ == 0 ? 0 : batch_ends_[batch_record_ - 1]);
+        if (!wait_work(lock)) {
+            break;
+        }
+
+        if (batch_record_ == batch_ends_.size() && !pending_ends_.empty()) {
+            batch_.swap(pending_);
+            batch_ends_.swap(pending_ends_);
+            pending_.clear();
+            pending_ends_.clear();
+            batch_record_ = 0;
+            inflight_bytes_ = batch_.size();
+        }
+        lock.unlock();
+
+        if (fd_ < 0 && !connect_socket()) {
+            schedule_reconnect();
+        } else if (!deliver()) {
+            close_socket();
+            schedule_reconnect();
+        }
+
+        lock.lock();
+    }
+}
+
+bool Net::Channel::wait_work(std::unique_lock<std::mutex> & lock)
+{
+    for (;;) {
+        auto now = Clock::now();
+        bool has_batch = batch_record_ < batch_ends_.size();
+        bool waiting_reconnect = (fd_ < 0 && now < next_connect_);
+
+        if (stopping_) {
+            if ((!has_batch && pending_ends_.empty()) || now >= stop_deadline_) {
+                return false;
+            }
+            if (waiting_reconnect) {
+                cond_.wait_until(lock, std::min(next_connect_, stop_deadline_));
+                continue;
+            }
+            return true;
+        }
+
+        // 等待重连期间记录留在 pending_ 中，直到缓冲区满
+        if (waiting_reconnect) {
+            cond_.wait_until(lock, next_connect_);
+            continue;
+        }
+        if (has_batch) {
+            return true;
+        }
+        if (pending_ends_.empty()) {
+            flush_requested_ = false;
+            cond_.wait(lock);
+            continue;
+        }
+
+        auto deadline = pending_since_ + options_.flush_interval;
+        if (flush_requested_ || now >= deadline
+            || pending_ends_.size() >= options_.batch_records || pending_.size() >= options_.batch_bytes) {
+            flush_requested_ = false;
+            return true;
+        }
+        cond_.wait_until(lock, deadline);
+    }
+}
+
+bool Net::Channel::connect_socket()
+{
+    struct addrinfo hints;
+    std::memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = (protocol_ == NetProtocol::Tcp) ? SOCK_STREAM : SOCK_DGRAM;
+    hints.ai_flags = AI_NUMERICSERV;
+
+    char port[8];
+    std::snprintf(port, sizeof(port), "%u", static_cast<unsigned>(port_));
+
+    struct addrinfo *result = nullptr;
+    if (getaddrinfo(host_.c_str(), port, &hints, &result) != 0) {
+        return false;
+    }
+
+    for (struct addrinfo *ai = result; ai != nullptr && fd_ < 0; ai = ai->ai_next) {
+        int fd = socket(ai->ai_family, ai->ai_socktype | SOCK_NONBLOCK | SOCK_CLOEXEC, ai->ai_protocol);
+        if (fd < 0) {
+            continue;
+        }
+
+        bool connected = (connect(fd, ai->ai_addr, ai->ai_addrlen) == 0);
+        if (!connected && errno == EINPROGRESS) {
+            auto deadline = Clock::now() + kConnectTimeout;
+            struct pollfd pfd = {fd, POLLOUT, 0};
+            int rc = 0;
+            while (rc == 0 && Clock::now() < deadline && !stop_expired()) {
+                rc = poll(&pfd, 1, kPollSliceMs);
+                if (rc < 0 && errno == EINTR) {
+                    rc = 0;
+                }
+            }
+            int error = 0;
+            socklen_t len = sizeof(error);
+            connected = (rc > 0 && getsockopt(fd, SOL_SOCKET, SO_ERROR, &error, &len) == 0 && error == 0);
+        }
+
+        if (!connected) {
+            close(fd);
+            continue;
+        }
+
+        if (protocol_ == NetProtocol::Tcp) {
+            // 已经自行批量，不需要 Nagle 再合并
+            int one = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        }
+        fd_ = fd;
+    }
+    freeaddrinfo(result);
+
+    if (fd_ < 0) {
+        return false;
+    }
+    if (ever_connected_) {
+        reconnects.fetch_add(1, std::memory_order_relaxed);
+    }
+    ever_connected_ = true;
+    return true;
+}
+
+void Net::Channel::close_socket()
+{
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+}
+
+void Net::Channel::schedule_reconnect()
+{
+    if (backoff_.count() == 0) {
+        backoff_ = options_.reconnect_min;
+    } else {
+        backoff_ = std::min(backoff_ * 2, options_.reconnect_max);
+    }
+    next_connect_ = Clock::now() + backoff_;
+}
+
+bool Net::Channel::deliver()
+{
+    if (protocol_ == NetProtocol::Tcp && peer_closed()) {
+        return false;
+    }
+
+    bool tcp = (protocol_ == NetProtocol::Tcp);
+    size_t limit = tcp ? options_.batch_bytes
+                       : options_.max_datagram_size - (compress_ ? 1 + kRawSizeSize : 0);
+
+    while (batch_record_ < batch_ends_.size()) {
+        // 从 batch_record_ 开始取尽量多的完整记录，至少一条
+        size_t begin = (batch_record_ == 0) ? 0 : batch_ends_[batch_record_ - 1];
+        size_t end_record = batch_record_ + 1;
+        while (end_record < batch_ends_.size()
+               && end_record - batch_record_ < options_.batch_records
+               && batch_ends_[end_record] - begin <= limit) {
+            ++end_record;
+        }
+        size_t records = end_record - batch_record_;
+        fmt::string_view data = encode(batch_.data() + begin, batch_ends_[end_record - 1] - begin);
+
+        if (tcp) {
+            if (!send_stream(data)) {
+                return false;
+            }
+            sent.fetch_add(records, std::memory_order_relaxed);
+        } else if (!send_datagram(data, records)) {
+            return false;
+        }
+        batch_record_ = end_record;
+    }
+
+    batch_.clear();
+    batch_ends_.clear();
+    batch_record_ = 0;
+    backoff_ = std::chrono::milliseconds(0);
+    return true;
+}
+
+fmt::string_view Net::Channel::encode(const char *data, size_t size)
+{
+    bool tcp = (protocol_ == NetProtocol::Tcp);
+    if (!tcp && !compress_) {
+        return fmt::string_view(data, size);
+    }
+
+    frame_.clear();
+    if (tcp) {
+        frame_.append(kFrameHeaderSize - 1, '\0');
+    }
+
+    bool compressed = false;
+#if defined(SLOG_WITH_LZ4)
+    if (compress_) {
+        size_t head = frame_.size();
+        int bound = LZ4_compressBound(static_cast<int>(size));
+        frame_.resize(head + 1 + kRawSizeSize + static_cast<size_t>(bound));
+        int n = LZ4_compress_default(data, &frame_[head + 1 + kRawSizeSize], static_cast<int>(size), bound);
+        if (n > 0 && static_cast<size_t>(n) < size) {
+            frame_[head] = kFlagLz4;
+            put_be32(&frame_[head + 1], static_cast<uint32_t>(size));
+            frame_.resize(head + 1 + kRawSizeSize + static_cast<size_t>(n));
+            compressed = true;
+        } else {
+            // 压缩后没有变小，发送原始数据
+            frame_.resize(head);
+        }
+    }
+#endif
+    if (!compressed) {
+        frame_.push_back('\0');
+        frame_.append(data, size);
+    }
+
+    if (tcp) {
+        put_be32(&frame_[0], static_cast<uint32_t>(frame_.size() - 4));
+    }
+    return fmt::string_view(frame_.data(), frame_.size());
+}
+
+bool Net::Channel::send_stream(fmt::string_view data)
+{
+    size_t offset = 0;
+    while (offset < data.size()) {
+        ssize_t n = send(fd_, data.data() + offset, data.size() - offset, MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (n > 0) {
+            offset += static_cast<size_t>(n);
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+            if (!wait_writable(fd_)) {
+                return false;
+            }
+        } else {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Net::Channel::send_datagram(fmt::string_view data, size_t records)
+{
+    for (;;) {
+        ssize_t n = send(fd_, data.data(), data.size(), MSG_NOSIGNAL | MSG_DONTWAIT);
+        if (n >= 0) {
+            sent.fetch_add(records, std::memory_order_relaxed);
+            return true;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            if (!wait_writable(fd_)) {
+                return false;
+            }
+            continue;
+        }
+        // 对端端口不可达（ECONNREFUSED）或单条记录过大（EMSGSIZE）：丢弃这个数据报
+        if (errno == ECONNREFUSED || errno == EMSGSIZE) {
+            dropped.fetch_add(records, std::memory_order_relaxed);
+            return true;
+        }
+        return false;
+    }
+}
+
+bool Net::Channel::wait_writable(int fd)
+{
+    struct pollfd pfd = {fd, POLLOUT, 0};
+    for (;;) {
+        if (stop_expired()) {
+            return false;
+        }
+        int rc = poll(&pfd, 1, kPollSliceMs);
+        if (rc > 0) {
+            return (pfd.revents & (POLLERR | POLLHUP | POLLNVAL)) == 0;
+        }
+        if (rc < 0 && errno != EINTR) {
+            return false;
+        }
+    }
+}
+
+bool Net::Channel::peer_closed()
+{
+    char buf[256];
+    for (;;) {
+        ssize_t n = recv(fd_, buf, sizeof(buf), MSG_DONTWAIT);
+        if (n > 0) {
+            continue;
+        }
+        if (n == 0) {
+            return true;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        return (errno != EAGAIN && errno != EWOULDBLOCK);
+    }
+}
+
+Net::Net(LogLevel level, std::string const & host, uint16_t port, NetProtocol protocol, NetOptions const & options)
+    : LoggerSink(level)
+    , host_(host)
+    , port_(port)
+    , protocol_(protocol)
+    , options_(options)
+{
+}
+
+Net::~Net() = default;
+
+std::shared_ptr<LoggerSink> Net::clone(const std::string & logger_name) const
+{
+    auto sink = std::make_shared<Net>(level_, host_, port_, protocol_, options_);
+    sink->channel_ = channel_;
+    sink->setup(logger_name);
+    return sink;
+}
+
+bool Net::setup(const std::string & logger_name)
+{
+    (void)logger_name;
+    if (!channel_) {
+        channel_ = std::make_shared<Channel>(host_, port_, protocol_, options_);
+        channel_->start();
+    }
+    return true;
+}
+
+const char* Net::name() const
+{
+    return "Net";
+}
+
+uint64_t Net::dropped() const noexcept
+{
+    return channel_ ? channel_->dropped.load(std::memory_order_relaxed) : 0;
+}
+
+uint64_t Net::sent() const noexcept
+{
+    return channel_ ? channel_->sent.load(std::memory_order_relaxed) : 0;
+}
+
+uint64_t Net::reconnects() const noexcept
+{
+    return channel_ ? channel_->reconnects.load(std::memory_order_relaxed) : 0;
+}
+
+void Net::flush()
+{
+    if (channel_) {
+        channel_->flush();
+    }
+}
+
+void Net::append_stats(std::string & out) const
+{
+    fmt::format_to(std::back_inserter(out), " sent={} dropped={} reconnects={}", sent(), dropped(), reconnects());
+}
+
+bool Net::compression_supported() noexcept
+{
+#if defined(SLOG_WITH_LZ4)
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Net::output(const std::string & logger_name, LogLevel level, std::string const &msg)
+{
+    if (!channel_) {
+        return;
+    }
+
+    detail::LineBuffer line;
+    File::append_header(line, logger_name, level);
+    detail::append_string(line, msg);
+    line.push_back('\n');
+    channel_->submit(line.data(), line.size());
+}
+
+void Net::output_fields(const std::string & logger_name, LogLevel level, fmt::string_view msg, FieldList fields)
+{
+    if (!channel_) {
+        return;
+    }
+
+    detail::LineBuffer line;
+    File::append_header(line, logger_name, level);
+    detail::append_string(line, msg);
+    detail::append_fields_text(line, fields);
+    line.push_back('\n');
+    channel_->submit(line.data(), line.size());
+}
+
+} // namespace sink
+} // namespace slog
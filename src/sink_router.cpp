@@ -0,0 +1,150 @@
+/**
+ * @file sink_router.cpp
+ * @author LiuChuansen (179712066@qq.com)
+ * @brief Router Sink实现
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <algorithm>
+
+#include "slog/sink_router.hpp"
+
+namespace slog {
+namespace sink {
+
+namespace {
+
+/// 最低位 1 的位置
+inline int lowest_bit(uint64_t mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(mask);
+#else
+    int index = 0;
+    while ((mask & 1) == 0) {
+        mask >>= 1;
+        ++index;
+    }
+    return index;
+#endif
+}
+
+} // namespace
+
+constexpr size_t Router::kMaxRoutes;
+constexpr int Router::kLevelCount;
+
+Router::Router(LogLevel level)
+    : LoggerSink(level)
+    , bound_name_(nullptr)
+    , table_()
+{
+}
+
+bool Router::add_route(std::shared_ptr<LoggerSink> sink, LogLevel level, std::string const & logger_pattern)
+{
+    if (!sink || routes_.size() >= kMaxRoutes) {
+        return false;
+    }
+    routes_.push_back(Route{std::move(sink), level, logger_pattern.empty() ? std::string("*") : logger_pattern});
+    return true;
+}
+
+uint64_t Router::route_mask(LogLevel level) const noexcept
+{
+    int index = static_cast<int>(level);
+    return (index >= 0 && index < kLevelCount) ? table_[index] : 0;
+}
+
+void Router::rebuild()
+{
+    if (bound_name_ == nullptr) {
+        return;
+    }
+    for (int i = 0; i < kLevelCount; ++i) {
+        table_[i] = compute_mask(*bound_name_, static_cast<LogLevel>(i));
+    }
+}
+
+std::shared_ptr<LoggerSink> Router::clone(const std::string & logger_name) const
+{
+    auto router = std::make_shared<Router>(level_);
+    for (Route const & route : routes_) {
+        auto sink = route.sink->clone(logger_name);
+        if (!sink) {
+            return nullptr;
+        }
+        router->add_route(std::move(sink), route.level, route.pattern);
+    }
+    router->setup(logger_name);
+    return router;
+}
+
+bool Router::setup(const std::string & logger_name)
+{
+    for (Route const & route : routes_) {
+        if (!route.sink->setup(logger_name)) {
+            return false;
+        }
+    }
+
+    // clone() 传入的可能是临时字符串，绑定到驻留的名称；Logger 输出时传回的正是这个引用
+    bound_name_ = &detail::intern_logger_name(logger_name).name;
+    rebuild();
+    return true;
+}
+
+const char* Router::name() const
+{
+    return "Router";
+}
+
+void Router::flush()
+{
+    for (Route const & route : routes_) {
+        route.sink->flush();
+    }
+}
+
+uint64_t Router::compute_mask(fmt::string_view logger_name, LogLevel level) const
+{
+    uint64_t mask = 0;
+    for (size_t i = 0; i < routes_.size(); ++i) {
+        Route const & route = routes_[i];
+        LogLevel route_level = std::max(route.level, route.sink->get_level());
+        if (static_cast<int>(level) >= static_cast<int>(route_level) && detail::glob_match(route.pattern, logger_name)) {
+            mask |= (uint64_t(1) << i);
+        }
+    }
+    return mask;
+}
+
+uint64_t Router::mask_for(const std::string & logger_name, LogLevel level) const
+{
+    if (&logger_name == bound_name_) {
+        return route_mask(level);
+    }
+    // 未绑定的 logger 共用了这个 Router：逐条匹配
+    return compute_mask(logger_name, level);
+}
+
+void Router::output(const std::string & logger_name, LogLevel level, std::string const &msg)
+{
+    for (uint64_t mask = mask_for(logger_name, level); mask != 0; mask &= mask - 1) {
+        routes_[lowest_bit(mask)].sink->output(logger_name, level, msg);
+    }
+}
+
+void Router::output_fields(const std::string & logger_name, LogLevel level, fmt::string_view msg, FieldList fields)
+{
+    for (uint64_t mask = mask_for(logger_name, level); mask != 0; mask &= mask - 1) {
+        routes_[lowest_bit(mask)].sink->output_fields(logger_name, level, msg, fields);
+    }
+}
+
+} // namespace sink
+} // namespace slog
@@ -9,6 +9,7 @@
  * 
  */
 
+#include <iostream>
 #include <mutex>
 #include <memory>
 #include <vector>
@@ -18,6 +19,8 @@
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <spdlog/sinks/basic_file_sink.h>
+#include <spdlog/sinks/rotating_file_sink.h>
+#include <spdlog/sinks/daily_file_sink.h>
 #include <spdlog/async.h>
 #include <spdlog/async_logger.h>
 
@@ -47,7 +50,10 @@ static void init_async_thread_pool()
 {
     std::lock_guard<std::mutex> lock(s_async_init_mutex);
     if (!s_async_thread_pool_initialized) {
-        spdlog::init_thread_pool(8192, 2);
+        // 队列长度和线程数来自 slog::set_async_options()
+        AsyncOptions const options = get_async_options();
+        spdlog::init_thread_pool(options.queue_size > 0 ? options.queue_size : 8192,
+                                 options.thread_count > 0 ? options.thread_count : 1);
         s_async_thread_pool_initialized = true;
     }
 }
@@ -82,7 +88,8 @@ std::shared_ptr<LoggerSink> Spdlog::clone(std::string const & logger_name) const
         return nullptr;
     }
     // Create a new sink with same configuration
-    auto sink = std::make_shared<Spdlog>(level_, sink_type_, filepath_, async_);
+    auto sink = std::make_shared<Spdlog>(level_, sink_type_, filepath_, async_, max_file_size_, max_files_);
+    sink->set_daily_rotation_time(rotation_hour_, rotation_minute_);
     // 使用spdlog自带的clone实现，避免重复打开相同文件的问题
     auto logger = pimpl_->logger->clone(logger_name);
     sink->pimpl_ = std::unique_ptr<SpdlogSinkImpl, SpdlogSinkImplDeleter>(new SpdlogSinkImpl(logger, async_));
@@ -97,6 +104,12 @@ bool Spdlog::setup(const std::string & logger_name)
     if (sink_type_ == SpdlogSinkType::NoSink) {
         return false;
     }
+
+    // At most one file sink may be enabled, they would all write to filepath_
+    int const file_flags = sink_type_ & (SpdlogSinkType::ToFile | SpdlogSinkType::ToRotatingFile | SpdlogSinkType::ToDailyFile);
+    if (file_flags & (file_flags - 1)) {
+        return false;
+    }
     
     try {
         // Collect spdlog sinks based on sink_type_
@@ -118,6 +131,34 @@ bool Spdlog::setup(const std::string & logger_name)
             file_sink->set_level(spdlog::level::trace);
             sinks.push_back(file_sink);
         }
+
+        // Add size based rotating file sink if enabled
+        if (sink_type_ & SpdlogSinkType::ToRotatingFile) {
+            if (filepath_.empty() || max_file_size_ == 0) {
+                return false;
+            }
+            auto file_sink = std::make_shared<spdlog::sinks::rotating_file_sink_mt>(
+                filepath_, max_file_size_, max_files_);
+            file_sink->set_level(spdlog::level::trace);
+            sinks.push_back(file_sink);
+        }
+
+        // Add daily rotating file sink if enabled
+        if (sink_type_ & SpdlogSinkType::ToDailyFile) {
+            if (filepath_.empty()) {
+                return false;
+            }
+            // spdlog 按 uint16_t 保存文件数量，超出时拒绝而不是截断
+            if (max_files_ > kMaxDailyFiles) {
+                std::cerr << "**ERROR** Spdlog::setup(): max_files " << max_files_
+                          << " exceeds " << kMaxDailyFiles << std::endl;
+                return false;
+            }
+            auto file_sink = std::make_shared<spdlog::sinks::daily_file_sink_mt>(
+                filepath_, rotation_hour_, rotation_minute_, false, static_cast<uint16_t>(max_files_));
+            file_sink->set_level(spdlog::level::trace);
+            sinks.push_back(file_sink);
+        }
         
         // Create logger based on sync/async mode
         std::shared_ptr<spdlog::logger> logger;
@@ -187,6 +228,21 @@ const char* Spdlog::name() const
     return "Spdlog";
 }
 
+void Spdlog::flush()
+{
+    if (pimpl_ && pimpl_->logger) {
+        pimpl_->logger->flush();
+    }
+}
+
+constexpr size_t Spdlog::kMaxDailyFiles;
+
+void Spdlog::set_daily_rotation_time(int hour, int minute)
+{
+    rotation_hour_ = hour;
+    rotation_minute_ = minute;
+}
+
 } // namespace sink
 } // namespace slog
 
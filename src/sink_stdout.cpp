@@ -11,10 +11,7 @@
 
 
 #include <iostream>
-#include <sstream>
-#include <iomanip>
 #include <chrono>
-#include <ctime>
 #include <mutex>
 
 #include "slog/sink_stdout.hpp"
@@ -31,30 +28,38 @@ std::shared_ptr<LoggerSink> Stdout::clone(const std::string & logger_name) const
 }
 
 
+#if SLOG_STDOUT_COLOR
+// 颜色 ANSI escape codes
+static constexpr const char* _RESET   = "\033[0m";
+static constexpr const char* _RED     = "\033[0;31m";      /* Red */
+static constexpr const char* _GREEN   = "\033[0;32m";      /* Green */
+static constexpr const char* _YELLOW  = "\033[0;33m";      /* Yellow */
+static constexpr const char* _BLUE    = "\033[0;34m";      /* Blue */
+#endif // SLOG_STDOUT_COLOR
+
 void Stdout::output(const std::string & logger_name, LogLevel level, std::string const &msg) 
 {    
-    // 使用全局锁保护所有 stdout 输出，确保多线程环境下日志不会交错
-    std::lock_guard<std::mutex> lock(get_stdout_mutex());
-    
-    auto now = std::chrono::system_clock::now();
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-        now.time_since_epoch()).count();
-    std::time_t time = std::chrono::system_clock::to_time_t(now);
-    std::tm tm = *std::localtime(&time);
-    std::ostringstream oss;
-    
+    detail::LineBuffer line;
+    append_header(line, logger_name, level);
+    detail::append_string(line, msg);
+    write_line(line);
+}
+
+void Stdout::output_fields(const std::string & logger_name, LogLevel level, fmt::string_view msg, FieldList fields)
+{
+    detail::LineBuffer line;
+    append_header(line, logger_name, level);
+    detail::append_string(line, msg);
+    detail::append_fields_text(line, fields);
+    write_line(line);
+}
+
+void Stdout::append_header(detail::LineBuffer & line, fmt::string_view logger_name, LogLevel level)
+{
     // output timestamp
-    oss << std::put_time(&tm, "%Y-%m-%d %H:%M:%S.");
-    oss << std::setfill('0') << std::setw(3) << ms % 1000;
+    detail::append_timestamp(line, detail::current_timestamp());
 
 #if SLOG_STDOUT_COLOR
-    // 颜色 ANSI escape codes
-    constexpr const char* _RESET   = "\033[0m";
-    constexpr const char* _RED     = "\033[0;31m";      /* Red */
-    constexpr const char* _GREEN   = "\033[0;32m";      /* Green */
-    constexpr const char* _YELLOW  = "\033[0;33m";      /* Yellow */
-    constexpr const char* _BLUE    = "\033[0;34m";      /* Blue */
-
     const char *color = _RESET;
     switch(level)
     {
@@ -75,17 +80,55 @@ void Stdout::output(const std::string & logger_name, LogLevel level, std::string
         color = _RESET;    
         break;
     }
-    oss << color;
+    detail::append_string(line, color);
 #endif // SLOG_STDOUT_COLOR
 
     // output log level
-    oss << " <" << log_level_name(level) << "> (" << logger_name << ") ";
+    detail::append_string(line, " <");
+    detail::append_string(line, log_level_name(level));
+    detail::append_string(line, "> (");
+    detail::append_string(line, logger_name);
+    detail::append_string(line, ") ");
+    detail::append_thread_tag(line);
+}
+
+void Stdout::write_line(detail::LineBuffer & line)
+{
+#if SLOG_STDOUT_COLOR
+    detail::append_string(line, _RESET);
+#endif // SLOG_STDOUT_COLOR
+    line.push_back('\n');
+
+    // 使用全局锁保护所有 stdout 输出，确保多线程环境下日志不会交错
+    std::lock_guard<std::mutex> lock(get_stdout_mutex());
+    std::cout.write(line.data(), static_cast<std::streamsize>(line.size()));
+    std::cout.flush();
+}
 
+void Stdout::output_batch(const std::string & logger_name, Batch const & batch, LogLevel level)
+{
+    detail::LineBuffer lines;
+    lines.reserve(batch.bytes() + batch.size() * 48);
+    for (size_t i = 0; i < batch.size(); ++i) {
+        Batch::Record record = batch[i];
+        if (static_cast<int>(record.level) < static_cast<int>(level)) {
+            continue;
+        }
+        detail::RecordTimeScope time_scope(record.timestamp);
+        append_header(lines, logger_name, record.level);
+        detail::append_string(lines, record.msg);
 #if SLOG_STDOUT_COLOR
-    std::cout << oss.str() << msg << _RESET << std::endl;
-#else
-    std::cout << oss.str() << msg << std::endl;
+        detail::append_string(lines, _RESET);
 #endif // SLOG_STDOUT_COLOR
+        lines.push_back('\n');
+    }
+    if (lines.size() == 0) {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(get_stdout_mutex());
+    std::cout.write(lines.data(), static_cast<std::streamsize>(lines.size()));
+    std::cout.flush();
 }
 
 const char* Stdout::name() const 
@@ -93,6 +136,12 @@ const char* Stdout::name() const
     return "Stdout"; 
 }
 
+void Stdout::flush()
+{
+    std::lock_guard<std::mutex> lock(get_stdout_mutex());
+    std::cout.flush();
+}
+
 std::mutex& Stdout::get_stdout_mutex() 
 {
     static std::mutex s_stdout_mutex;
@@ -0,0 +1,409 @@
+/**
+ * @file sink_syslog.cpp
+ * @author LiuChuansen (179712066@qq.com)
+ * @brief Syslog Sink实现
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <algorithm>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "slog/sink_syslog.hpp"
+
+namespace slog {
+namespace sink {
+
+namespace {
+
+/// 等待发送的数据报上限，超过后直接丢弃（发送线程被长时间阻塞时保护内存）
+constexpr size_t kMaxPendingDatagrams = 1024;
+
+/// 单次 sendmmsg 的数据报数量
+constexpr size_t kSendBatch = 64;
+
+/**
+ * @brief 按秒缓存的 syslog 时间戳
+ *
+ * RFC 3164：“Mmm dd hh:mm:ss”；RFC 5424：“YYYY-mm-ddTHH:MM:SS”，毫秒和时区由调用方拼接
+ */
+struct SyslogClock
+{
+    time_t second = -1;
+    SyslogFormat format = SyslogFormat::Rfc3164;
+    char text[32] = {};
+    size_t size = 0;
+    char zone[8] = {};
+};
+
+void append_syslog_timestamp(detail::LineBuffer & line, SyslogFormat format)
+{
+    static thread_local SyslogClock clock;
+
+    auto now = std::chrono::system_clock::now();
+    time_t seconds = std::chrono::system_clock::to_time_t(now);
+    if (seconds != clock.second || format != clock.format) {
+        struct tm tm;
+        localtime_r(&seconds, &tm);
+        if (format == SyslogFormat::Rfc3164) {
+            clock.size = strftime(clock.text, sizeof(clock.text), "%b %e %H:%M:%S", &tm);
+        } else {
+            clock.size = strftime(clock.text, sizeof(clock.text), "%Y-%m-%dT%H:%M:%S", &tm);
+            // "+0800" -> "+08:00"
+            char zone[8] = {};
+            if (strftime(zone, sizeof(zone), "%z", &tm) == 5) {
+                const char text[6] = {zone[0], zone[1], zone[2], ':', zone[3], zone[4]};
+                std::memcpy(clock.zone, text, sizeof(text));
+            } else {
+                std::memcpy(clock.zone, "Z", 2);
+            }
+        }
+        clock.second = seconds;
+        clock.format = format;
+    }
+
+    line.append(clock.text, clock.text + clock.size);
+    if (format == SyslogFormat::Rfc5424) {
+        auto milli = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()).count() % 1000;
+        const char tail[4] = {
+            '.',
+            static_cast<char>('0' + milli / 100),
+            static_cast<char>('0' + milli / 10 % 10),
+            static_cast<char>('0' + milli % 10),
+        };
+        line.append(tail, tail + 4);
+        detail::append_string(line, clock.zone);
+    }
+}
+
+/// RFC 5424 的 HOSTNAME/APP-NAME/MSGID 只允许可打印 ASCII，且有长度限制；空值用 "-"
+void append_header_field(detail::LineBuffer & line, fmt::string_view value, size_t max_size)
+{
+    if (value.size() == 0) {
+        line.push_back('-');
+        return;
+    }
+    size_t size = std::min(value.size(), max_size);
+    for (size_t i = 0; i < size; ++i) {
+        char c = value[i];
+        line.push_back((c > 32 && c < 127) ? c : '_');
+    }
+}
+
+std::string default_ident()
+{
+#if defined(__GLIBC__)
+    return program_invocation_short_name;
+#else
+    char path[256] = {};
+    ssize_t size = readlink("/proc/self/exe", path, sizeof(path) - 1);
+    if (size <= 0) {
+        return "slog";
+    }
+    std::string exe(path, static_cast<size_t>(size));
+    auto pos = exe.rfind('/');
+    return (pos == std::string::npos) ? exe : exe.substr(pos + 1);
+#endif
+}
+
+inline bool is_reconnect_error(int err)
+{
+    return err == ECONNREFUSED || err == ENOTCONN || err == ECONNRESET || err == EPIPE || err == EBADF;
+}
+
+} // namespace
+
+Syslog::Syslog(LogLevel level,
+               std::string const & ident,
+               SyslogFacility facility,
+               SyslogFormat format,
+               std::string const & socket_path)
+    : LoggerSink(level)
+    , ident_(ident)
+    , facility_(facility)
+    , format_(format)
+    , socket_path_(socket_path)
+    , max_datagram_size_(8192)
+    , pid_(0)
+    , fd_(-1)
+    , dropped_(0)
+    , pending_count_(0)
+{
+}
+
+Syslog::~Syslog()
+{
+    close_socket();
+}
+
+std::shared_ptr<LoggerSink> Syslog::clone(const std::string & logger_name) const
+{
+    auto sink = std::make_shared<Syslog>(level_, ident_, facility_, format_, socket_path_);
+    sink->set_max_datagram_size(max_datagram_size_);
+    sink->setup(logger_name);
+    return sink;
+}
+
+bool Syslog::setup(const std::string & logger_name)
+{
+    (void)logger_name;
+
+    if (ident_.empty()) {
+        ident_ = default_ident();
+    }
+    pid_ = static_cast<int>(getpid());
+
+    char host[256] = {};
+    if (gethostname(host, sizeof(host) - 1) == 0) {
+        hostname_ = host;
+    }
+
+    // 守护进程可能晚于程序启动，连接失败时不认为 setup 失败，发送时再重连
+    std::lock_guard<std::mutex> lock(send_mutex_);
+    connect_socket();
+    return true;
+}
+
+const char* Syslog::name() const
+{
+    return "Syslog";
+}
+
+void Syslog::append_stats(std::string & out) const
+{
+    fmt::format_to(std::back_inserter(out), " dropped={}", dropped());
+}
+
+int Syslog::severity(LogLevel level) noexcept
+{
+    switch (level) {
+    case LogLevel::Trace:
+    case LogLevel::Debug:
+        return 7;   // LOG_DEBUG
+    case LogLevel::Info:
+        return 6;   // LOG_INFO
+    case LogLevel::Warning:
+        return 4;   // LOG_WARNING
+    case LogLevel::Error:
+        return 3;   // LOG_ERR
+    default:
+        return 6;
+    }
+}
+
+void Syslog::append_header(detail::LineBuffer & line, fmt::string_view logger_name, LogLevel level)
+{
+    int priority = static_cast<int>(facility_) * 8 + severity(level);
+    line.push_back('<');
+    fmt::format_int pri(priority);
+    line.append(pri.data(), pri.data() + pri.size());
+    line.push_back('>');
+
+    fmt::format_int pid(pid_);
+    if (format_ == SyslogFormat::Rfc3164) {
+        append_syslog_timestamp(line, format_);
+        line.push_back(' ');
+        detail::append_string(line, ident_);
+        line.push_back('[');
+        line.append(pid.data(), pid.data() + pid.size());
+        detail::append_string(line, "]: (");
+        detail::append_string(line, logger_name);
+        detail::append_string(line, ") ");
+    } else {
+        detail::append_string(line, "1 ");
+        append_syslog_timestamp(line, format_);
+        line.push_back(' ');
+        append_header_field(line, hostname_, 255);
+        line.push_back(' ');
+        append_header_field(line, ident_, 48);
+        line.push_back(' ');
+        line.append(pid.data(), pid.data() + pid.size());
+        line.push_back(' ');
+        append_header_field(line, logger_name, 32);
+        detail::append_string(line, " - ");
+    }
+}
+
+void Syslog::output(const std::string & logger_name, LogLevel level, std::string const &msg)
+{
+    detail::LineBuffer line;
+    append_header(line, logger_name, level);
+    detail::append_string(line, msg);
+    submit(line);
+}
+
+void Syslog::output_fields(const std::string & logger_name, LogLevel level, fmt::string_view msg, FieldList fields)
+{
+    detail::LineBuffer line;
+    append_header(line, logger_name, level);
+    detail::append_string(line, msg);
+    detail::append_fields_text(line, fields);
+    submit(line);
+}
+
+void Syslog::submit(detail::LineBuffer & line)
+{
+    size_t size = std::min(line.size(), max_datagram_size_);
+    {
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        if (pending_count_ >= kMaxPendingDatagrams) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        if (pending_count_ == pending_.size()) {
+            pending_.emplace_back();
+        }
+        pending_[pending_count_++].assign(line.data(), size);
+    }
+
+    // 没有线程在发送时由当前线程发送；否则由正在发送的线程顺带发出
+    for (;;) {
+        std::unique_lock<std::mutex> send_lock(send_mutex_, std::try_to_lock);
+        if (!send_lock.owns_lock()) {
+            return;
+        }
+        for (;;) {
+            size_t count = 0;
+            {
+                std::lock_guard<std::mutex> lock(queue_mutex_);
+                if (pending_count_ == 0) {
+                    break;
+                }
+                // 交换后两个数组中的字符串容量都会被复用
+                pending_.swap(sending_);
+                count = pending_count_;
+                pending_count_ = 0;
+            }
+            send_batch(count);
+        }
+        send_lock.unlock();
+
+        // 释放发送锁之前提交、但没抢到发送锁的消息由这里补发
+        std::lock_guard<std::mutex> lock(queue_mutex_);
+        if (pending_count_ == 0) {
+            return;
+        }
+    }
+}
+
+void Syslog::send_batch(size_t count)
+{
+    if (fd_ < 0 && !connect_socket()) {
+        dropped_.fetch_add(count, std::memory_order_relaxed);
+        return;
+    }
+
+    bool reconnected = false;
+    size_t index = 0;
+    while (index < count) {
+#if defined(__linux__)
+        struct mmsghdr msgs[kSendBatch];
+        struct iovec iovs[kSendBatch];
+        size_t batch = std::min(count - index, kSendBatch);
+        std::memset(msgs, 0, sizeof(struct mmsghdr) * batch);
+        for (size_t i = 0; i < batch; ++i) {
+            std::string & datagram = sending_[index + i];
+            iovs[i].iov_base = &datagram[0];
+            iovs[i].iov_len = datagram.size();
+            msgs[i].msg_hdr.msg_iov = &iovs[i];
+            msgs[i].msg_hdr.msg_iovlen = 1;
+        }
+        int sent = sendmmsg(fd_, msgs, static_cast<unsigned int>(batch), MSG_NOSIGNAL);
+#else
+        std::string & datagram = sending_[index];
+        int sent = (send(fd_, datagram.data(), datagram.size(), 0) < 0) ? -1 : 1;
+#endif
+        if (sent > 0) {
+            // 部分成功时，失败的那条在下一次调用中报告错误
+            index += static_cast<size_t>(sent);
+            continue;
+        }
+
+        int err = errno;
+        if (err == EINTR) {
+            continue;
+        }
+        if (err == EAGAIN || err == EWOULDBLOCK || err == ENOBUFS) {
+            // 守护进程来不及接收：丢弃剩余消息，不阻塞调用线程
+            dropped_.fetch_add(count - index, std::memory_order_relaxed);
+            return;
+        }
+        if (err == EMSGSIZE) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            index++;
+            continue;
+        }
+        if (is_reconnect_error(err) && !reconnected) {
+            // 守护进程重启后旧连接失效，重连一次
+            reconnected = true;
+            close_socket();
+            if (connect_socket()) {
+                continue;
+            }
+        }
+        dropped_.fetch_add(count - index, std::memory_order_relaxed);
+        return;
+    }
+}
+
+bool Syslog::connect_socket()
+{
+    if (fd_ >= 0) {
+        return true;
+    }
+
+    auto now = std::chrono::steady_clock::now();
+    if (last_connect_failure_ != std::chrono::steady_clock::time_point() &&
+        now - last_connect_failure_ < std::chrono::seconds(1)) {
+        return false;
+    }
+
+    struct sockaddr_un addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sun_family = AF_UNIX;
+    if (socket_path_.size() >= sizeof(addr.sun_path)) {
+        last_connect_failure_ = now;
+        return false;
+    }
+    std::memcpy(addr.sun_path, socket_path_.c_str(), socket_path_.size() + 1);
+
+    int fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+    if (fd < 0) {
+        last_connect_failure_ = now;
+        return false;
+    }
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+    if (connect(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0) {
+        close(fd);
+        last_connect_failure_ = now;
+        return false;
+    }
+
+    fd_ = fd;
+    last_connect_failure_ = std::chrono::steady_clock::time_point();
+    return true;
+}
+
+void Syslog::close_socket()
+{
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+}
+
+} // namespace sink
+} // namespace slog
@@ -0,0 +1,650 @@
+/**
+ * @file slog_config.cpp
+ * @author LiuChuansen (179712066@qq.com)
+ * @brief 日志配置文件加载与热更新实现
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include "slog/config.hpp"
+#include "slog/sink_stdout.hpp"
+#include "slog/sink_none.hpp"
+#include "slog/sink_file.hpp"
+#include "slog/sink_json_file.hpp"
+#include "slog/sink_isolated.hpp"
+#if !defined(_WIN32)
+#include "slog/sink_syslog.hpp"
+#endif
+#if defined(__linux__)
+#include "slog/sink_journal.hpp"
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace slog {
+
+namespace {
+
+/// [sink.xxx] 段
+struct SinkSpec
+{
+    std::string name;
+    int line = 0;
+    std::map<std::string, std::string> keys;
+};
+
+/// [logger.xxx] 段
+struct LoggerSpec
+{
+    std::string name;
+    std::vector<std::string> sinks;
+    LogLevel level = LogLevel::Unknown;
+    bool is_default = false;
+};
+
+struct ConfigSpec
+{
+    std::vector<std::pair<std::string, LogLevel>> rules;
+    std::map<std::string, SinkSpec> sinks;
+    std::vector<LoggerSpec> loggers;
+};
+
+std::string trim(std::string const & str)
+{
+    size_t start = str.find_first_not_of(" \t\r\n");
+    if (start == std::string::npos) {
+        return std::string();
+    }
+    size_t end = str.find_last_not_of(" \t\r\n");
+    return str.substr(start, end - start + 1);
+}
+
+std::string to_lower(std::string str)
+{
+    for (auto & c : str) {
+        c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+    }
+    return str;
+}
+
+bool parse_bool(std::string const & str, bool *value)
+{
+    std::string in = to_lower(str);
+    if (in == "true" || in == "yes" || in == "on" || in == "1") {
+        *value = true;
+        return true;
+    }
+    if (in == "false" || in == "no" || in == "off" || in == "0") {
+        *value = false;
+        return true;
+    }
+    return false;
+}
+
+/// 解析字节数，支持 K/M/G 后缀（1024 进制）
+bool parse_size(std::string const & str, size_t *value)
+{
+    if (str.empty() || !std::isdigit(static_cast<unsigned char>(str[0]))) {
+        return false;
+    }
+    char *end = nullptr;
+    unsigned long long number = std::strtoull(str.c_str(), &end, 10);
+    std::string suffix = to_lower(trim(end));
+    if (suffix == "k" || suffix == "kb") {
+        number *= 1024ULL;
+    } else if (suffix == "m" || suffix == "mb") {
+        number *= 1024ULL * 1024ULL;
+    } else if (suffix == "g" || suffix == "gb") {
+        number *= 1024ULL * 1024ULL * 1024ULL;
+    } else if (!suffix.empty() && suffix != "b") {
+        return false;
+    }
+    *value = static_cast<size_t>(number);
+    return true;
+}
+
+/// 去掉注释：行首或空白之后的 '#'、';' 到行尾
+std::string strip_comment(std::string const & line)
+{
+    for (size_t i = 0; i < line.size(); ++i) {
+        if ((line[i] == '#' || line[i] == ';') && (i == 0 || line[i - 1] == ' ' || line[i - 1] == '\t')) {
+            return line.substr(0, i);
+        }
+    }
+    return line;
+}
+
+std::vector<std::string> split_list(std::string const & str)
+{
+    std::vector<std::string> items;
+    std::string item;
+    std::istringstream in(str);
+    while (std::getline(in, item, ',')) {
+        item = trim(item);
+        if (!item.empty()) {
+            items.push_back(item);
+        }
+    }
+    return items;
+}
+
+class ConfigError
+{
+public:
+    explicit ConfigError(std::string const & source) : source_(source) {}
+
+    bool fail(int line, std::string const & message)
+    {
+        std::cerr << "**ERROR** slog config " << source_;
+        if (line > 0) {
+            std::cerr << ":" << line;
+        }
+        std::cerr << ": " << message << std::endl;
+        return false;
+    }
+
+private:
+    std::string source_;
+};
+
+/// 校验 sink 段：类型和键名都必须可识别，数值必须合法
+bool check_sink(SinkSpec const & spec, ConfigError & error)
+{
+    static const char *const common_keys[] = {"type", "level", "isolated", "queue_size"};
+    static const char *const file_keys[] = {"path", "max_size", "max_files", "flush", "index"};
+
+    auto it = spec.keys.find("type");
+    if (it == spec.keys.end()) {
+        return error.fail(spec.line, "sink '" + spec.name + "' has no type");
+    }
+    std::string type = to_lower(it->second);
+    bool is_file = (type == "file" || type == "json_file");
+    if (!is_file && type != "stdout" && type != "none" && type != "syslog" && type != "journal") {
+        return error.fail(spec.line, "sink '" + spec.name + "' has unknown type '" + it->second + "'");
+    }
+#if defined(_WIN32)
+    if (type == "syslog") {
+        return error.fail(spec.line, "syslog sink is not supported on this platform");
+    }
+#endif
+#if !defined(__linux__)
+    if (type == "journal") {
+        return error.fail(spec.line, "journal sink is not supported on this platform");
+    }
+#endif
+
+    for (auto const & pair : spec.keys) {
+        bool known = false;
+        for (const char *key : common_keys) {
+            known = known || pair.first == key;
+        }
+        if (is_file) {
+            for (const char *key : file_keys) {
+                known = known || pair.first == key;
+            }
+        }
+        if (type == "syslog") {
+            known = known || pair.first == "ident";
+        }
+        if (!known) {
+            return error.fail(spec.line, "sink '" + spec.name + "' has unknown key '" + pair.first + "'");
+        }
+    }
+
+    size_t size = 0;
+    bool flag = false;
+    for (auto const & pair : spec.keys) {
+        if (pair.first == "level" && log_level_from_name(pair.second) == LogLevel::Unknown) {
+            return error.fail(spec.line, "sink '" + spec.name + "' has invalid level '" + pair.second + "'");
+        }
+        if ((pair.first == "max_size" || pair.first == "max_files" || pair.first == "queue_size")
+            && !parse_size(pair.second, &size)) {
+            return error.fail(spec.line, "sink '" + spec.name + "' has invalid " + pair.first + " '" + pair.second + "'");
+        }
+        if ((pair.first == "flush" || pair.first == "isolated" || pair.first == "index") && !parse_bool(pair.second, &flag)) {
+            return error.fail(spec.line, "sink '" + spec.name + "' has invalid " + pair.first + " '" + pair.second + "'");
+        }
+    }
+    if (is_file && spec.keys.find("path") == spec.keys.end()) {
+        return error.fail(spec.line, "sink '" + spec.name + "' has no path");
+    }
+    return true;
+}
+
+/// 解析整个配置文本，出错时不产生任何副作用
+bool parse_config(std::string const & text, ConfigSpec *spec, ConfigError & error)
+{
+    enum class Section { None, Rules, Sink, Logger };
+    Section section = Section::None;
+    SinkSpec *sink = nullptr;
+    LoggerSpec *logger = nullptr;
+
+    std::istringstream in(text);
+    std::string raw;
+    int line_no = 0;
+    while (std::getline(in, raw)) {
+        line_no++;
+        std::string line = trim(strip_comment(raw));
+        if (line.empty()) {
+            continue;
+        }
+
+        if (line[0] == '[') {
+            if (line.back() != ']') {
+                return error.fail(line_no, "unterminated section header");
+            }
+            std::string name = trim(line.substr(1, line.size() - 2));
+            if (name == "rules") {
+                section = Section::Rules;
+            } else if (name.compare(0, 5, "sink.") == 0 && name.size() > 5) {
+                std::string sink_name = name.substr(5);
+                if (spec->sinks.count(sink_name) != 0) {
+                    return error.fail(line_no, "duplicate sink '" + sink_name + "'");
+                }
+                section = Section::Sink;
+                sink = &spec->sinks[sink_name];
+                sink->name = sink_name;
+                sink->line = line_no;
+            } else if (name.compare(0, 7, "logger.") == 0 && name.size() > 7) {
+                std::string logger_name = name.substr(7);
+                for (auto const & existing : spec->loggers) {
+                    if (existing.name == logger_name) {
+                        return error.fail(line_no, "duplicate logger '" + logger_name + "'");
+                    }
+                }
+                section = Section::Logger;
+                spec->loggers.emplace_back();
+                logger = &spec->loggers.back();
+                logger->name = logger_name;
+            } else {
+                return error.fail(line_no, "unknown section '" + name + "'");
+            }
+            continue;
+        }
+
+        // 规则的 pattern 可能是正则表达式，以最后一个 '=' 分隔；其他段以第一个 '=' 分隔
+        size_t eq = (section == Section::Rules) ? line.rfind('=') : line.find('=');
+        if (eq == std::string::npos) {
+            return error.fail(line_no, "expected 'key = value'");
+        }
+        std::string key = trim(line.substr(0, eq));
+        std::string value = trim(line.substr(eq + 1));
+        if (key.empty()) {
+            return error.fail(line_no, "empty key");
+        }
+
+        switch (section) {
+        case Section::None:
+            return error.fail(line_no, "key outside of a section");
+        case Section::Rules:
+        {
+            LogLevel level = log_level_from_name(value);
+            if (level == LogLevel::Unknown) {
+                return error.fail(line_no, "invalid level '" + value + "'");
+            }
+            spec->rules.emplace_back(key, level);
+            break;
+        }
+        case Section::Sink:
+            sink->keys[to_lower(key)] = value;
+            break;
+        case Section::Logger:
+            key = to_lower(key);
+            if (key == "sinks") {
+                logger->sinks = split_list(value);
+            } else if (key == "level") {
+                logger->level = log_level_from_name(value);
+                if (logger->level == LogLevel::Unknown) {
+                    return error.fail(line_no, "invalid level '" + value + "'");
+                }
+            } else if (key == "default") {
+                if (!parse_bool(value, &logger->is_default)) {
+                    return error.fail(line_no, "invalid boolean '" + value + "'");
+                }
+            } else {
+                return error.fail(line_no, "logger '" + logger->name + "' has unknown key '" + key + "'");
+            }
+            break;
+        }
+    }
+
+    for (auto const & pair : spec->sinks) {
+        if (!check_sink(pair.second, error)) {
+            return false;
+        }
+    }
+    for (auto const & spec_logger : spec->loggers) {
+        if (spec_logger.sinks.empty()) {
+            return error.fail(0, "logger '" + spec_logger.name + "' has no sinks");
+        }
+        for (auto const & sink_name : spec_logger.sinks) {
+            if (spec->sinks.count(sink_name) == 0) {
+                return error.fail(0, "logger '" + spec_logger.name + "' uses undefined sink '" + sink_name + "'");
+            }
+        }
+    }
+    return true;
+}
+
+/// 按已校验的 sink 段创建 sink
+std::shared_ptr<LoggerSink> create_sink(SinkSpec const & spec)
+{
+    auto value = [&spec](const char *key, const char *default_value) {
+        auto it = spec.keys.find(key);
+        return (it != spec.keys.end()) ? it->second : std::string(default_value);
+    };
+    auto size_value = [&value](const char *key, const char *default_value) {
+        size_t size = 0;
+        parse_size(value(key, default_value), &size);
+        return size;
+    };
+    auto bool_value = [&value](const char *key, const char *default_value) {
+        bool flag = false;
+        parse_bool(value(key, default_value), &flag);
+        return flag;
+    };
+
+    std::string type = to_lower(value("type", ""));
+    LogLevel level = log_level_from_name(value("level", "info"));
+
+    std::shared_ptr<LoggerSink> sink;
+    if (type == "stdout") {
+        sink = std::make_shared<sink::Stdout>(level);
+    } else if (type == "none") {
+        sink = std::make_shared<sink::None>(level);
+    } else if (type == "file") {
+        sink = std::make_shared<sink::File>(level, format_log_filename(value("path", "")),
+            size_value("max_size", "10M"), size_value("max_files", "5"), bool_value("flush", "true"));
+    } else if (type == "json_file") {
+        sink = std::make_shared<sink::JsonFile>(level, format_log_filename(value("path", "")),
+            size_value("max_size", "10M"), size_value("max_files", "5"), bool_value("flush", "true"));
+    }
+#if !defined(_WIN32)
+    else if (type == "syslog") {
+        sink = std::make_shared<sink::Syslog>(level, value("ident", ""));
+    }
+#endif
+#if defined(__linux__)
+    else if (type == "journal") {
+        sink = std::make_shared<sink::Journal>(level);
+    }
+#endif
+
+    if (sink && (type == "file" || type == "json_file") && bool_value("index", "false")) {
+        std::static_pointer_cast<sink::File>(sink)->enable_time_index();
+    }
+    if (sink && bool_value("isolated", "false")) {
+        sink = std::make_shared<sink::Isolated>(sink, size_value("queue_size", "8192"));
+    }
+    return sink;
+}
+
+/// 上一次加载的配置发布的规则，重新加载时只替换这些规则
+struct ConfigRules
+{
+    std::mutex mutex;
+    std::vector<std::pair<std::string, LogLevel>> rules;
+};
+
+ConfigRules &config_rules()
+{
+    static ConfigRules state;
+    return state;
+}
+
+bool apply_config(std::string const & text, std::string const & source)
+{
+    ConfigError error(source);
+    ConfigSpec spec;
+    if (!parse_config(text, &spec, error)) {
+        return false;
+    }
+
+    // logger 的 level 作为精确规则加入，替换上一次加载的配置规则后一次发布；
+    // SLOG_LEVEL、--slog-level 和控制端点设置的规则保留
+    std::vector<std::pair<std::string, LogLevel>> rules = spec.rules;
+    for (auto const & logger : spec.loggers) {
+        if (logger.level != LogLevel::Unknown) {
+            rules.emplace_back(logger.name, logger.level);
+        }
+    }
+    {
+        ConfigRules &state = config_rules();
+        std::lock_guard<std::mutex> lock(state.mutex);
+        update_logger_level_rules(state.rules, rules);
+        state.rules = rules;
+    }
+
+    // 先发布规则，新注册的 logger 直接取得最终等级；
+    // 每个 [sink.x] 只创建一次作为原型，各 logger 使用 clone() 得到的独立 sink（等级互不影响），
+    // 文件状态和网络连接等由 clone() 按 sink 类型共享
+    std::map<std::string, std::shared_ptr<LoggerSink>> prototypes;
+    for (auto const & logger : spec.loggers) {
+        if (!has_logger(logger.name)) {
+            std::vector<std::shared_ptr<LoggerSink>> sinks;
+            for (auto const & sink_name : logger.sinks) {
+                auto it = prototypes.find(sink_name);
+                if (it == prototypes.end()) {
+                    it = prototypes.emplace(sink_name, create_sink(spec.sinks[sink_name])).first;
+                }
+                auto sink = it->second ? it->second->clone(logger.name) : nullptr;
+                if (sink) {
+                    sinks.push_back(sink);
+                }
+            }
+            make_logger(logger.name, sinks);
+        }
+        if (logger.is_default) {
+            set_default_logger(logger.name);
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+bool load_config(std::string const & path)
+{
+    std::ifstream file(path, std::ios::in | std::ios::binary);
+    if (!file.is_open()) {
+        return ConfigError(path).fail(0, "cannot open file");
+    }
+    std::ostringstream content;
+    content << file.rdbuf();
+    return apply_config(content.str(), path);
+}
+
+bool load_config_text(std::string const & text)
+{
+    return apply_config(text, "<text>");
+}
+
+#if defined(__linux__)
+
+namespace {
+
+/**
+ * @brief inotify 配置文件监视器
+ *
+ * 监视文件所在目录的 IN_CLOSE_WRITE / IN_MOVED_TO / IN_CREATE 事件并按文件名过滤，
+ * 事件到达后等待 50ms 无新事件再加载，合并编辑器的多次写入。
+ */
+class ConfigWatcher
+{
+public:
+    ConfigWatcher(std::string const & path, std::function<void(bool)> on_reload)
+        : path_(path)
+        , on_reload_(std::move(on_reload))
+        , inotify_fd_(-1)
+        , wake_fd_(-1)
+    {
+    }
+
+    ~ConfigWatcher()
+    {
+        if (thread_.joinable()) {
+            uint64_t one = 1;
+            ssize_t ret = write(wake_fd_, &one, sizeof(one));
+            (void)ret;
+            thread_.join();
+        }
+        if (inotify_fd_ >= 0) {
+            close(inotify_fd_);
+        }
+        if (wake_fd_ >= 0) {
+            close(wake_fd_);
+        }
+    }
+
+    bool start()
+    {
+        size_t slash = path_.rfind('/');
+        std::string dir = (slash == std::string::npos) ? std::string(".") : path_.substr(0, slash);
+        if (dir.empty()) {
+            dir = "/";
+        }
+        file_name_ = (slash == std::string::npos) ? path_ : path_.substr(slash + 1);
+
+        inotify_fd_ = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        wake_fd_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (inotify_fd_ < 0 || wake_fd_ < 0 || file_name_.empty()) {
+            return false;
+        }
+        if (inotify_add_watch(inotify_fd_, dir.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0) {
+            return false;
+        }
+        thread_ = std::thread([this]() { run(); });
+        return true;
+    }
+
+private:
+    std::string path_;
+    std::string file_name_;
+    std::function<void(bool)> on_reload_;
+    int inotify_fd_;
+    int wake_fd_;
+    std::thread thread_;
+
+    /// 读出所有待处理事件，返回其中是否有配置文件
+    bool drain_events()
+    {
+        alignas(struct inotify_event) char buf[4096];
+        bool matched = false;
+        for (;;) {
+            ssize_t n = read(inotify_fd_, buf, sizeof(buf));
+            if (n <= 0) {
+                return matched;
+            }
+            for (char *p = buf; p < buf + n; ) {
+                auto *event = reinterpret_cast<struct inotify_event *>(p);
+                if (event->len > 0 && file_name_ == event->name) {
+                    matched = true;
+                }
+                p += sizeof(struct inotify_event) + event->len;
+            }
+        }
+    }
+
+    /// 等待事件，返回 false 表示需要退出
+    bool wait(int timeout_ms, bool *readable)
+    {
+        struct pollfd fds[2] = {{inotify_fd_, POLLIN, 0}, {wake_fd_, POLLIN, 0}};
+        int ret = poll(fds, 2, timeout_ms);
+        if (fds[1].revents != 0) {
+            return false;
+        }
+        *readable = (ret > 0 && fds[0].revents != 0);
+        return true;
+    }
+
+    void run()
+    {
+        bool readable = false;
+        while (wait(-1, &readable)) {
+            if (!readable || !drain_events()) {
+                continue;
+            }
+            // 合并短时间内的后续写入
+            for (;;) {
+                if (!wait(50, &readable)) {
+                    return;
+                }
+                if (!readable) {
+                    break;
+                }
+                drain_events();
+            }
+
+            bool ok = load_config(path_);
+            if (on_reload_) {
+                on_reload_(ok);
+            }
+        }
+    }
+};
+
+struct WatcherState
+{
+    std::mutex mutex;
+    std::unique_ptr<ConfigWatcher> watcher;
+};
+
+WatcherState &watcher_state()
+{
+    static WatcherState state;
+    return state;
+}
+
+} // namespace
+
+bool watch_config(std::string const & path, std::function<void(bool)> on_reload)
+{
+    // 先构造注册表单例，保证进程退出时监视线程在注册表析构之前停止
+    get_logger_list();
+
+    std::unique_ptr<ConfigWatcher> watcher(new ConfigWatcher(path, std::move(on_reload)));
+    if (!watcher->start()) {
+        return ConfigError(path).fail(0, "cannot watch file");
+    }
+
+    WatcherState &state = watcher_state();
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        state.watcher.swap(watcher);
+    }
+    // 之前的监视器在锁外停止
+    return true;
+}
+
+void unwatch_config()
+{
+    WatcherState &state = watcher_state();
+    std::unique_ptr<ConfigWatcher> watcher;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        watcher = std::move(state.watcher);
+    }
+    // 在锁外停止监视线程；不能在 on_reload 回调中调用
+}
+
+#endif // __linux__
+
+} // namespace slog
@@ -0,0 +1,406 @@
+/**
+ * @file slog_control.cpp
+ * @author LiuChuansen (179712066@qq.com)
+ * @brief 运行时控制端点实现
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ */
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "slog/control.hpp"
+
+namespace slog {
+
+namespace {
+
+/// 单条命令的最大长度
+constexpr size_t kMaxCommandSize = 64 * 1024;
+/// 等待客户端发送命令的最长时间
+constexpr int kClientTimeoutMs = 1000;
+
+const char *level_text(LogLevel level)
+{
+    return (level == LogLevel::Off) ? "OFF" : log_level_name(level);
+}
+
+bool fill_address(std::string const & path, struct sockaddr_un *addr)
+{
+    if (path.empty() || path.size() >= sizeof(addr->sun_path)) {
+        return false;
+    }
+    std::memset(addr, 0, sizeof(*addr));
+    addr->sun_family = AF_UNIX;
+    std::memcpy(addr->sun_path, path.c_str(), path.size() + 1);
+    return true;
+}
+
+bool write_all(int fd, const char *data, size_t size)
+{
+    while (size > 0) {
+        ssize_t n = send(fd, data, size, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+/// 追加一个 logger 的 sink 和统计
+void append_logger_stats(std::string & out, std::string const & name, std::shared_ptr<Logger> const & logger)
+{
+    auto const & sinks = logger->sinks();
+    for (size_t i = 0; i < sinks.size(); ++i) {
+        if (!sinks[i]) {
+            continue;
+        }
+        out += name;
+        out += " sink[" + std::to_string(i) + "]=" + sinks[i]->name();
+        out += " level=";
+        out += level_text(sinks[i]->get_level());
+        sinks[i]->append_stats(out);
+        out += '\n';
+    }
+}
+
+/// 执行一条命令，返回完整回复
+std::string execute(std::string const & line)
+{
+    std::istringstream in(line);
+    std::string command;
+    in >> command;
+
+    if (command == "list") {
+        std::string out = "OK\n";
+        for (auto const & name : get_logger_list()) {
+            auto logger = find_logger(name);
+            out += name + " " + (logger ? level_text(logger->get_level()) : "-") + "\n";
+        }
+        return out;
+    }
+    if (command == "get") {
+        std::string name;
+        in >> name;
+        auto logger = find_logger(name);
+        if (!logger) {
+            return "ERR no such logger: " + name + "\n";
+        }
+        return std::string("OK\n") + level_text(logger->get_level()) + "\n";
+    }
+    if (command == "set") {
+        std::string pattern;
+        std::string level_str;
+        in >> pattern >> level_str;
+        LogLevel level = log_level_from_name(level_str);
+        if (pattern.empty() || level == LogLevel::Unknown) {
+            return "ERR usage: set <pattern> <level>\n";
+        }
+        set_logger_level(pattern, level);
+        return "OK\n";
+    }
+    if (command == "apply") {
+        std::string rules;
+        std::getline(in, rules);
+        int count = apply_logger_rules(rules);
+        if (count == 0) {
+            return "ERR no valid rule\n";
+        }
+        return "OK\n" + std::to_string(count) + " rules applied\n";
+    }
+    if (command == "rules") {
+        std::string out = "OK\n";
+        for (auto const & rule : get_logger_rules()) {
+            out += rule.first + " " + level_text(rule.second) + "\n";
+        }
+        return out;
+    }
+    if (command == "clear-rules") {
+        clear_logger_rules();
+        return "OK\n";
+    }
+    if (command == "flush") {
+        std::string name;
+        in >> name;
+        if (name.empty()) {
+            flush_all_loggers();
+            return "OK\n";
+        }
+        auto logger = find_logger(name);
+        if (!logger) {
+            return "ERR no such logger: " + name + "\n";
+        }
+        logger->flush();
+        return "OK\n";
+    }
+    if (command == "stats") {
+        std::string name;
+        in >> name;
+        std::string out = "OK\n";
+        if (!name.empty()) {
+            auto logger = find_logger(name);
+            if (!logger) {
+                return "ERR no such logger: " + name + "\n";
+            }
+            append_logger_stats(out, name, logger);
+            return out;
+        }
+        for (auto const & logger_name : get_logger_list()) {
+            auto logger = find_logger(logger_name);
+            if (logger) {
+                append_logger_stats(out, logger_name, logger);
+            }
+        }
+        return out;
+    }
+    if (command == "help") {
+        return "OK\n"
+               "list\n"
+               "get <name>\n"
+               "set <pattern> <level>\n"
+               "apply <rules>\n"
+               "rules\n"
+               "clear-rules\n"
+               "flush [name]\n"
+               "stats [name]\n";
+    }
+    return "ERR unknown command: " + command + "\n";
+}
+
+/**
+ * @brief 控制端点：一个监听套接字和一个后台线程，同一时刻只处理一个客户端
+ */
+class ControlServer
+{
+public:
+    explicit ControlServer(std::string const & path)
+        : path_(path)
+        , listen_fd_(-1)
+    {
+        wake_fds_[0] = -1;
+        wake_fds_[1] = -1;
+    }
+
+    ~ControlServer()
+    {
+        if (thread_.joinable()) {
+            char byte = 0;
+            ssize_t ret = write(wake_fds_[1], &byte, 1);
+            (void)ret;
+            thread_.join();
+        }
+        if (listen_fd_ >= 0) {
+            close(listen_fd_);
+            unlink(path_.c_str());
+        }
+        for (int fd : wake_fds_) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+    }
+
+    bool start()
+    {
+        struct sockaddr_un addr;
+        if (!fill_address(path_, &addr) || pipe(wake_fds_) != 0) {
+            return false;
+        }
+        fcntl(wake_fds_[0], F_SETFD, FD_CLOEXEC);
+        fcntl(wake_fds_[1], F_SETFD, FD_CLOEXEC);
+
+        // 只替换残留的套接字文件，不删除同名的普通文件
+        struct stat st;
+        if (lstat(path_.c_str(), &st) == 0 && S_ISSOCK(st.st_mode)) {
+            unlink(path_.c_str());
+        }
+
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0) {
+            return false;
+        }
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+        if (bind(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0) {
+            close(fd);
+            return false;
+        }
+        listen_fd_ = fd;
+        if (chmod(path_.c_str(), 0600) != 0 || listen(fd, 4) != 0) {
+            return false;
+        }
+
+        thread_ = std::thread([this]() { run(); });
+        return true;
+    }
+
+private:
+    std::string path_;
+    int listen_fd_;
+    int wake_fds_[2];
+    std::thread thread_;
+
+    void run()
+    {
+        for (;;) {
+            struct pollfd fds[2] = {{listen_fd_, POLLIN, 0}, {wake_fds_[0], POLLIN, 0}};
+            if (poll(fds, 2, -1) < 0 && errno != EINTR) {
+                return;
+            }
+            if (fds[1].revents != 0) {
+                return;
+            }
+            if (fds[0].revents == 0) {
+                continue;
+            }
+            int client = accept(listen_fd_, nullptr, nullptr);
+            if (client >= 0) {
+                serve(client);
+                close(client);
+            }
+        }
+    }
+
+    /// 读取一行命令并回复
+    void serve(int client)
+    {
+        std::string line;
+        char buf[1024];
+        while (line.find('\n') == std::string::npos && line.size() < kMaxCommandSize) {
+            struct pollfd pfd = {client, POLLIN, 0};
+            if (poll(&pfd, 1, kClientTimeoutMs) <= 0) {
+                break;
+            }
+            ssize_t n = recv(client, buf, sizeof(buf), 0);
+            if (n <= 0) {
+                break;
+            }
+            line.append(buf, static_cast<size_t>(n));
+        }
+        size_t eol = line.find('\n');
+        if (eol == std::string::npos) {
+            // 没有换行：客户端关闭写端时整段作为命令，超时或过长时拒绝
+            if (line.empty() || line.size() >= kMaxCommandSize) {
+                return;
+            }
+            eol = line.size();
+        }
+        line.resize(eol);
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+
+        std::string response = execute(line);
+        write_all(client, response.data(), response.size());
+    }
+};
+
+struct ServerState
+{
+    std::mutex mutex;
+    std::unique_ptr<ControlServer> server;
+};
+
+ServerState &server_state()
+{
+    static ServerState state;
+    return state;
+}
+
+} // namespace
+
+std::string default_control_socket_path(long pid)
+{
+    const char *dir = std::getenv("XDG_RUNTIME_DIR");
+    std::string path = (dir != nullptr && dir[0] != '\0') ? std::string(dir) : std::string("/tmp");
+    return path + "/slog-" + std::to_string(pid) + ".sock";
+}
+
+bool start_control_server(std::string const & socket_path)
+{
+    // 先构造注册表单例，保证进程退出时控制线程在注册表析构之前停止
+    get_logger_list();
+
+    std::string path = socket_path.empty() ? default_control_socket_path(static_cast<long>(getpid())) : socket_path;
+
+    // 先停止旧的端点，同一路径可以重新绑定
+    stop_control_server();
+
+    std::unique_ptr<ControlServer> server(new ControlServer(path));
+    if (!server->start()) {
+        std::cerr << "**ERROR** start_control_server(): cannot listen on " << path << ": " << std::strerror(errno) << std::endl;
+        return false;
+    }
+
+    ServerState &state = server_state();
+    std::lock_guard<std::mutex> lock(state.mutex);
+    state.server.swap(server);
+    return true;
+}
+
+void stop_control_server()
+{
+    ServerState &state = server_state();
+    std::unique_ptr<ControlServer> server;
+    {
+        std::lock_guard<std::mutex> lock(state.mutex);
+        server.swap(state.server);
+    }
+    // 在锁外停止后台线程
+}
+
+bool control_request(std::string const & socket_path, std::string const & command, std::string *response)
+{
+    struct sockaddr_un addr;
+    if (!fill_address(socket_path, &addr)) {
+        return false;
+    }
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd < 0) {
+        return false;
+    }
+    if (connect(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0) {
+        close(fd);
+        return false;
+    }
+
+    std::string line = command + "\n";
+    bool ok = write_all(fd, line.data(), line.size());
+    response->clear();
+    char buf[4096];
+    while (ok) {
+        ssize_t n = recv(fd, buf, sizeof(buf), 0);
+        if (n < 0 && errno == EINTR) {
+            continue;
+        }
+        if (n <= 0) {
+            break;
+        }
+        response->append(buf, static_cast<size_t>(n));
+    }
+    close(fd);
+    return ok && !response->empty();
+}
+
+} // namespace slog
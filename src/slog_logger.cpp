@@ -10,14 +10,34 @@
 #include <sstream>
 #include <cstdio>
 #include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <cstdlib>
 #include <cctype>
 #include <regex>
 #include <mutex>
+#include <atomic>
+#include <deque>
+#include <thread>
+#include <functional>
+#if defined(__linux__)
+#include <sys/syscall.h>
+#endif
+#if !defined(_WIN32)
+#include <pthread.h>
+#endif
 
 #include "slog/slog.hpp"
 #include "slog/sink_stdout.hpp"
 #include "slog/sink_none.hpp"
 #include "slog/sink_file.hpp"
+#include "slog/sink_json_file.hpp"
+#if !defined(_WIN32)
+#include "slog/sink_syslog.hpp"
+#endif
+#if defined(__linux__)
+#include "slog/sink_journal.hpp"
+#endif
 
 #ifdef BUILD_WITH_SPDLOG
 #include "slog/sink_spdlog.hpp"
@@ -38,9 +58,543 @@ namespace slog {
 #define __debug(fmt, ...) ((void)0)
 #endif 
 
+// 异步及消息缓冲区配置
+namespace {
+
+std::mutex s_async_options_mutex;
+AsyncOptions s_async_options;
+
+// 缓冲区参数在每条日志中读取，单独用原子变量保存，避免加锁
+std::atomic<size_t> s_payload_reserve{256};
+std::atomic<size_t> s_payload_retain_max{64 * 1024};
+
+/// 每线程的消息缓冲区
+struct ThreadPayload
+{
+    std::string buf;
+    bool busy = false;
+};
+
+ThreadPayload &thread_payload()
+{
+    static thread_local ThreadPayload payload;
+    return payload;
+}
+
+// 时间戳精度（小数位数），格式化时读取
+std::atomic<int> s_timestamp_digits{3};
+
+/// TSC 与系统时间的对应关系
+struct TscCalibration
+{
+    uint64_t tsc0;
+    int64_t realtime_ns0;
+    double ns_per_tick;
+};
+
+/// 第一次使用时校准：在 20ms 内同时读取计数器和 steady_clock 得到频率，再取一对计数器/系统时间作为基准
+TscCalibration const &tsc_calibration()
+{
+    static TscCalibration const calibration = []() {
+        auto steady_ns = []() {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+        };
+        int64_t t0 = steady_ns();
+        uint64_t c0 = detail::read_tsc();
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        int64_t t1 = steady_ns();
+        uint64_t c1 = detail::read_tsc();
+
+        TscCalibration result;
+        result.ns_per_tick = (c1 > c0) ? static_cast<double>(t1 - t0) / static_cast<double>(c1 - c0) : 1.0;
+        // 系统时间取两次计数器读数的中点
+        uint64_t before = detail::read_tsc();
+        int64_t realtime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        uint64_t after = detail::read_tsc();
+        result.tsc0 = before + (after - before) / 2;
+        result.realtime_ns0 = realtime;
+        return result;
+    }();
+    return calibration;
+}
+
+} // namespace
+
+void set_timestamp_options(TimestampOptions const &options)
+{
+    if (options.clock == TimestampClock::Tsc) {
+        // 先完成校准，再让调用线程开始捕获计数器
+        tsc_calibration();
+    }
+    // 小数位数用于索引 append_fraction() 的除数表，只接受 3/6/9
+    switch (options.precision) {
+    case TimestampPrecision::Milli:
+    case TimestampPrecision::Micro:
+    case TimestampPrecision::Nano:
+        s_timestamp_digits.store(static_cast<int>(options.precision), std::memory_order_relaxed);
+        break;
+    default:
+        break;
+    }
+    detail::timestamp_clock().store(options.clock, std::memory_order_relaxed);
+}
+
+TimestampOptions get_timestamp_options()
+{
+    TimestampOptions options;
+    options.clock = detail::timestamp_clock().load(std::memory_order_relaxed);
+    options.precision = static_cast<TimestampPrecision>(s_timestamp_digits.load(std::memory_order_relaxed));
+    return options;
+}
+
+void set_thread_name(fmt::string_view name)
+{
+    detail::ThreadInfo &info = detail::this_thread_info();
+    size_t size = std::min(name.size(), sizeof(info.name));
+    std::memcpy(info.name, name.data(), size);
+    info.name_size = static_cast<uint8_t>(size);
+
+#if defined(__linux__) || defined(__APPLE__)
+    // pthread 名称最长 15 字节加结尾的 '\0'
+    char short_name[16];
+    size_t short_size = std::min(size, sizeof(short_name) - 1);
+    std::memcpy(short_name, name.data(), short_size);
+    short_name[short_size] = '\0';
+#if defined(__APPLE__)
+    pthread_setname_np(short_name);
+#else
+    pthread_setname_np(pthread_self(), short_name);
+#endif
+#endif
+}
+
+void set_log_thread(bool enable)
+{
+    detail::log_thread_flag().store(enable, std::memory_order_relaxed);
+}
+
+bool get_log_thread()
+{
+    return detail::log_thread_flag().load(std::memory_order_relaxed);
+}
+
+void set_async_options(AsyncOptions const &options)
+{
+    std::lock_guard<std::mutex> lock(s_async_options_mutex);
+    s_async_options = options;
+    s_payload_reserve.store(options.payload_reserve, std::memory_order_relaxed);
+    s_payload_retain_max.store(options.payload_retain_max, std::memory_order_relaxed);
+}
+
+AsyncOptions get_async_options()
+{
+    std::lock_guard<std::mutex> lock(s_async_options_mutex);
+    return s_async_options;
+}
+
+namespace detail {
+
+std::string *acquire_payload_buffer() noexcept
+{
+    ThreadPayload &payload = thread_payload();
+    if (payload.busy) {
+        return nullptr;
+    }
+    payload.busy = true;
+    if (payload.buf.capacity() < s_payload_reserve.load(std::memory_order_relaxed)) {
+        try {
+            payload.buf.reserve(s_payload_reserve.load(std::memory_order_relaxed));
+        } catch (...) {
+            // 预留失败时按需增长即可
+        }
+    }
+    return &payload.buf;
+}
+
+void release_payload_buffer(std::string *buf) noexcept
+{
+    ThreadPayload &payload = thread_payload();
+    if (buf != &payload.buf) {
+        return;
+    }
+    if (payload.buf.capacity() > s_payload_retain_max.load(std::memory_order_relaxed)) {
+        // 大块消息（如 dump）用完后归还内存
+        std::string().swap(payload.buf);
+    } else {
+        payload.buf.clear();
+    }
+    payload.busy = false;
+}
+
+uint64_t init_thread_id() noexcept
+{
+    ThreadInfo &info = this_thread_info();
+#if defined(__linux__)
+    info.id = static_cast<uint64_t>(::syscall(SYS_gettid));
+#else
+    info.id = static_cast<uint64_t>(std::hash<std::thread::id>()(std::this_thread::get_id()));
+#endif
+    return info.id;
+}
+
+void append_thread(LineBuffer &buf, ThreadInfo const &thread)
+{
+    buf.push_back('[');
+    fmt::format_int id(thread.id);
+    buf.append(id.data(), id.data() + id.size());
+    if (thread.name_size > 0) {
+        buf.push_back(':');
+        append_string(buf, thread.thread_name());
+    }
+    append_string(buf, "] ");
+}
+
+namespace {
+
+/// 追加 digits 位小数（frac_ns 为不足一秒的纳秒数）
+inline void append_fraction(LineBuffer &buf, uint32_t frac_ns, int digits)
+{
+    static const uint32_t kDivisors[] = {1, 10, 100, 1000, 10000, 100000, 1000000, 10000000, 100000000};
+    uint32_t value = frac_ns / kDivisors[9 - digits];
+    char text[9];
+    for (int i = digits - 1; i >= 0; --i) {
+        text[i] = static_cast<char>('0' + value % 10);
+        value /= 10;
+    }
+    buf.append(text, text + digits);
+}
+
+} // namespace
+
+void append_timestamp(LineBuffer &buf, std::chrono::system_clock::time_point now)
+{
+    Timestamp ts;
+    ts.ticks = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        now.time_since_epoch()).count());
+    ts.clock = TimestampClock::Realtime;
+    append_timestamp(buf, ts);
+}
+
+int64_t timestamp_epoch_ns(Timestamp ts) noexcept
+{
+    switch (ts.clock) {
+    case TimestampClock::Tsc: {
+        TscCalibration const &calibration = tsc_calibration();
+        double delta = static_cast<double>(static_cast<int64_t>(ts.ticks - calibration.tsc0)) * calibration.ns_per_tick;
+        return calibration.realtime_ns0 + static_cast<int64_t>(delta);
+    }
+    case TimestampClock::Monotonic: {
+        // 按当前系统时间与单调时钟的差值换算
+        int64_t realtime = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        int64_t steady = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+        return realtime - steady + static_cast<int64_t>(ts.ticks);
+    }
+    default:
+        return static_cast<int64_t>(ts.ticks);
+    }
+}
+
+void append_timestamp(LineBuffer &buf, Timestamp ts)
+{
+    constexpr int64_t kNsPerSecond = 1000000000;
+    int const digits = s_timestamp_digits.load(std::memory_order_relaxed);
+
+    if (ts.clock == TimestampClock::Monotonic) {
+        fmt::format_int seconds(ts.ticks / kNsPerSecond);
+        buf.append(seconds.data(), seconds.data() + seconds.size());
+        buf.push_back('.');
+        append_fraction(buf, static_cast<uint32_t>(ts.ticks % kNsPerSecond), digits);
+        return;
+    }
+
+    int64_t const epoch_ns = timestamp_epoch_ns(ts);
+
+    // 缓存 "YYYY-mm-dd HH:MM:SS." 部分，共 20 字节
+    struct SecondCache
+    {
+        std::time_t second = -1;
+        char text[80];
+    };
+    static thread_local SecondCache cache;
+
+    std::time_t const tt = static_cast<std::time_t>(epoch_ns / kNsPerSecond);
+    if (tt != cache.second) {
+        std::tm tm;
+#if defined(_WIN32)
+        localtime_s(&tm, &tt);
+#else
+        localtime_r(&tt, &tm);
+#endif
+        std::snprintf(cache.text, sizeof(cache.text), "%04d-%02d-%02d %02d:%02d:%02d.",
+            tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec);
+        cache.second = tt;
+    }
+
+    buf.append(cache.text, cache.text + 20);
+    append_fraction(buf, static_cast<uint32_t>(epoch_ns % kNsPerSecond), digits);
+}
+
+namespace {
+
+/// logfmt 规则：空值或包含空白、引号、'=' 的值需要加引号
+bool needs_quote(fmt::string_view str)
+{
+    if (str.size() == 0) {
+        return true;
+    }
+    for (char c : str) {
+        if (c == ' ' || c == '"' || c == '=' || c == '\\' || static_cast<unsigned char>(c) < 0x20) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void append_text_value(LineBuffer &buf, fmt::string_view str)
+{
+    if (!needs_quote(str)) {
+        append_string(buf, str);
+        return;
+    }
+    buf.push_back('"');
+    for (char c : str) {
+        switch (c) {
+        case '"':
+            append_string(buf, "\\\"");
+            break;
+        case '\\':
+            append_string(buf, "\\\\");
+            break;
+        case '\n':
+            append_string(buf, "\\n");
+            break;
+        case '\r':
+            append_string(buf, "\\r");
+            break;
+        case '\t':
+            append_string(buf, "\\t");
+            break;
+        default:
+            buf.push_back(c);
+            break;
+        }
+    }
+    buf.push_back('"');
+}
+
+} // namespace
+
+void append_fields_text(LineBuffer &buf, FieldList fields)
+{
+    for (Field const &field : fields) {
+        buf.push_back(' ');
+        append_string(buf, field.key());
+        buf.push_back('=');
+        switch (field.type()) {
+        case Field::Type::String:
+            append_text_value(buf, field.as_string());
+            break;
+        case Field::Type::Custom: {
+            // 自定义类型先格式化到栈上缓冲区，再决定是否加引号
+            LineBuffer value;
+            field.format_value(value);
+            append_text_value(buf, fmt::string_view(value.data(), value.size()));
+            break;
+        }
+        default:
+            field.format_value(buf);
+            break;
+        }
+    }
+}
+
+namespace {
+
+/// 驻留名称表，条目保存在 deque 中，地址稳定且永不释放
+struct NameTable
+{
+    std::mutex mutex;
+    std::deque<InternedName> entries;
+    std::unordered_map<std::string, InternedName const *> index;
+};
+
+NameTable &name_table()
+{
+    // 故意泄漏：静态析构阶段的 logger 仍可能访问名称
+    static NameTable *table = new NameTable();
+    return *table;
+}
+
+std::atomic<uint64_t> s_registry_generation{1};
+
+/// 调用点登记表，调用点是静态对象，链表节点永不释放
+struct SourceSiteTable
+{
+    std::mutex mutex;
+    SourceSite *head = nullptr;
+    LogLevel level = LogLevel::Trace;
+};
+
+SourceSiteTable &source_site_table()
+{
+    // 故意泄漏：静态析构阶段仍可能有调用点首次执行
+    static SourceSiteTable *table = new SourceSiteTable();
+    return *table;
+}
+
+/// 当前默认 logger，只用于地址比较，不会解引用
+std::atomic<Logger const *> s_default_logger_raw{nullptr};
+
+inline uint8_t source_site_state(SourceSite const *site, LogLevel level)
+{
+    return (static_cast<int>(site->level) >= static_cast<int>(level)) ? 2 : 1;
+}
+
+} // namespace
+
+uint8_t register_source_site(SourceSite *site) noexcept
+{
+    SourceSiteTable &table = source_site_table();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    uint8_t state = site->state_.load(std::memory_order_relaxed);
+    if (state == SourceSite::Unregistered) {
+        site->next_ = table.head;
+        table.head = site;
+        state = source_site_state(site, table.level);
+        site->state_.store(state, std::memory_order_relaxed);
+    }
+    return state;
+}
+
+void refresh_source_sites(LogLevel level) noexcept
+{
+    SourceSiteTable &table = source_site_table();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    table.level = level;
+    for (SourceSite *site = table.head; site != nullptr; site = site->next_) {
+        site->state_.store(source_site_state(site, level), std::memory_order_relaxed);
+    }
+}
+
+InternedName const &intern_logger_name(std::string const &name)
+{
+    NameTable &table = name_table();
+    std::lock_guard<std::mutex> lock(table.mutex);
+    auto it = table.index.find(name);
+    if (it != table.index.end()) {
+        return *it->second;
+    }
+    table.entries.push_back(InternedName{
+        static_cast<uint32_t>(table.entries.size() + 1), fnv1a_hash(name.data(), name.size()), name});
+    InternedName const *entry = &table.entries.back();
+    table.index.emplace(name, entry);
+    return *entry;
+}
+
+uint64_t registry_generation() noexcept
+{
+    return s_registry_generation.load(std::memory_order_acquire);
+}
+
+bool glob_match(fmt::string_view pattern, fmt::string_view name) noexcept
+{
+    size_t p = 0;
+    size_t n = 0;
+    bool has_star = false;
+    size_t star = 0;
+    size_t star_name = 0;
+
+    while (n < name.size()) {
+        if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+            ++p;
+            ++n;
+        } else if (p < pattern.size() && pattern[p] == '*') {
+            has_star = true;
+            star = p++;
+            star_name = n;
+        } else if (has_star) {
+            // 回到上一个 '*'，让它多匹配一个字符
+            p = star + 1;
+            n = ++star_name;
+        } else {
+            return false;
+        }
+    }
+    while (p < pattern.size() && pattern[p] == '*') {
+        ++p;
+    }
+    return p == pattern.size();
+}
+
+} // namespace detail
+
+void Field::format_value(detail::LineBuffer &buf) const
+{
+    switch (type_) {
+    case Type::Int: {
+        fmt::format_int str(value_.i);
+        buf.append(str.data(), str.data() + str.size());
+        break;
+    }
+    case Type::UInt: {
+        fmt::format_int str(value_.u);
+        buf.append(str.data(), str.data() + str.size());
+        break;
+    }
+    case Type::Double:
+        fmt::format_to(std::back_inserter(buf), "{}", value_.d);
+        break;
+    case Type::Bool:
+        detail::append_string(buf, value_.b ? "true" : "false");
+        break;
+    case Type::String:
+        buf.append(value_.s.data, value_.s.data + value_.s.size);
+        break;
+    case Type::Custom:
+        value_.custom.format(value_.custom.ptr, buf);
+        break;
+    }
+}
+
+void LoggerSink::output_fields(const std::string & logger_name, LogLevel level, fmt::string_view msg, FieldList fields)
+{
+    detail::LineBuffer line;
+    detail::append_string(line, msg);
+    detail::append_fields_text(line, fields);
+
+    detail::PayloadBuffer payload;
+    payload.str().assign(line.data(), line.size());
+    output(logger_name, level, payload.str());
+}
+
+void Batch::vadd(LogLevel level, fmt::string_view fmt, fmt::format_args args)
+{
+    size_t offset = text_.size();
+    fmt::vformat_to(std::back_inserter(text_), fmt, args);
+    push(level, offset);
+}
+
+void LoggerSink::output_batch(const std::string & logger_name, Batch const & batch, LogLevel level)
+{
+    detail::PayloadBuffer payload;
+    for (size_t i = 0; i < batch.size(); ++i) {
+        Batch::Record record = batch[i];
+        if (static_cast<int>(record.level) < static_cast<int>(level)) {
+            continue;
+        }
+        detail::RecordTimeScope time_scope(record.timestamp);
+        payload.str().assign(record.msg.data(), record.msg.size());
+        output(logger_name, record.level, payload.str());
+    }
+}
+
 // Logger implementation
 Logger::Logger(std::string const &name, std::shared_ptr<LoggerSink> sink)
-    : name_(name), valid_(false)
+    : name_(&detail::intern_logger_name(name)), valid_(false)
 {
     if (sink == nullptr)
     {
@@ -53,7 +607,7 @@ Logger::Logger(std::string const &name, std::shared_ptr<LoggerSink> sink)
     // 建立所有sink
     for (auto& s : sinks_)
     {
-        if (!s->setup(this->name_))
+        if (!s->setup(this->name_->name))
         {
             std::cerr << "setup sink(" << s->name() << ") failed" << std::endl;
             return;
@@ -66,7 +620,7 @@ Logger::Logger(std::string const &name, std::shared_ptr<LoggerSink> sink)
 
 // 多sink构造函数实现
 Logger::Logger(std::string const &name, std::vector<std::shared_ptr<LoggerSink>> sinks)
-    : name_(name), sinks_(std::move(sinks)), valid_(false)
+    : name_(&detail::intern_logger_name(name)), sinks_(std::move(sinks)), valid_(false)
 {
     if (sinks_.empty())
     {
@@ -77,7 +631,7 @@ Logger::Logger(std::string const &name, std::vector<std::shared_ptr<LoggerSink>>
     // 建立所有sink
     for (auto& s : sinks_)
     {
-        if (!s->setup(this->name_))
+        if (!s->setup(this->name_->name))
         {
             std::cerr << "setup sink(" << s->name() << ") failed" << std::endl;
             return;
@@ -90,7 +644,7 @@ Logger::Logger(std::string const &name, std::vector<std::shared_ptr<LoggerSink>>
 
 std::string const &Logger::name() const 
 {
-    return name_;
+    return name_->name;
 }
 
 LogLevel Logger::get_level() const 
@@ -100,7 +654,7 @@ LogLevel Logger::get_level() const
         return LogLevel::Off;
     }
     
-    return min_level_;
+    return min_level_.load(std::memory_order_relaxed);
 }
 
 void Logger::set_level(LogLevel level) 
@@ -117,46 +671,119 @@ void Logger::set_level(LogLevel level)
     update_filter_level();
 }
 
+void Logger::refresh_levels()
+{
+    update_filter_level();
+}
+
+void Logger::flush()
+{
+    for (auto& sink : sinks_)
+    {
+        if (sink)
+        {
+            sink->flush();
+        }
+    }
+}
+
 bool Logger::is_allowed(LogLevel level) const noexcept 
 {
     // 只要有一个sink允许就返回true
     // 多sink情况下，取决于等级值最小的。
     // 如有两个LEVEL， DEBUG， INFO， 应该允许DEBUG的信息通过
-    return static_cast<int>(level) >= static_cast<int>(min_level_);
+    return static_cast<int>(level) >= static_cast<int>(min_level_.load(std::memory_order_relaxed));
 }
 
-void Logger::log(LogLevel level, std::string const &msg) 
+void Logger::dispatch(LogLevel level, std::string const &msg)
+{
+    // 每条日志只读取一次时钟，各 sink 输出相同的时间
+    detail::RecordTimeScope time_scope(detail::current_timestamp());
+
+    // 遍历分发表，不触碰引用计数，等级不够的sink不做虚函数调用
+    for (size_t i = 0; i < plan_size_; ++i)
+    {
+        SinkPlanEntry const &entry = plan_[i];
+        if (static_cast<int>(level) >= static_cast<int>(entry.level.load(std::memory_order_relaxed)))
+        {
+            entry.sink->output(name_->name, level, msg);
+        }
+    }
+}
+
+void Logger::vlog(LogLevel level, fmt::string_view fmt, fmt::format_args args)
 {
-    if (!valid_ || static_cast<int>(level) < static_cast<int>(min_level_))
+    if (!valid_ || !is_allowed(level))
     {
         return;
     }
-    
-    // 遍历所有sink
-    for (auto& sink : sinks_)
+
+    detail::PayloadBuffer payload;
+    fmt::vformat_to(std::back_inserter(payload.str()), fmt, args);
+    dispatch(level, payload.str());
+}
+
+void Logger::log_batch(Batch const &batch)
+{
+    if (!valid_ || batch.empty() || !is_allowed(batch.max_level()))
     {
-        sink->log(name_,level, msg);
+        return;
+    }
+
+    for (size_t i = 0; i < plan_size_; ++i)
+    {
+        SinkPlanEntry const &entry = plan_[i];
+        LogLevel level = entry.level.load(std::memory_order_relaxed);
+        if (static_cast<int>(batch.max_level()) >= static_cast<int>(level))
+        {
+            entry.sink->output_batch(name_->name, batch, level);
+        }
     }
 }
 
+void Logger::log(LogLevel level, std::string const &msg) 
+{
+    if (!valid_ || !is_allowed(level))
+    {
+        return;
+    }
+    
+    dispatch(level, msg);
+}
+
 void Logger::log(LogLevel level, const char* msg) 
 {
-    if (!valid_ || static_cast<int>(level) < static_cast<int>(min_level_))
+    if (!valid_ || !is_allowed(level))
     {
         return;
     }
     
-    // 遍历所有sink
-    std::string msg_str(msg);
-    for (auto& sink : sinks_)
+    dispatch(level, std::string(msg));
+}
+
+void Logger::log_fields(LogLevel level, fmt::string_view msg, FieldList fields)
+{
+    if (!valid_ || !is_allowed(level))
     {
-        sink->log(name_, level, msg);
+        return;
+    }
+
+    detail::RecordTimeScope time_scope(detail::current_timestamp());
+
+    // 字段只在通过等级检查的sink中序列化
+    for (size_t i = 0; i < plan_size_; ++i)
+    {
+        SinkPlanEntry const &entry = plan_[i];
+        if (static_cast<int>(level) >= static_cast<int>(entry.level.load(std::memory_order_relaxed)))
+        {
+            entry.sink->output_fields(name_->name, level, msg, fields);
+        }
     }
 }
 
 void Logger::log_lines(LogLevel level, std::string const &msg) 
 {
-    if (!valid_ || static_cast<int>(level) < static_cast<int>(min_level_))
+    if (!valid_ || !is_allowed(level))
     {
         return;
     }
@@ -206,7 +833,7 @@ void Logger::log_lines(LogLevel level, std::string const &msg)
 
 void Logger::log_data(LogLevel level, void const *data, size_t size, std::string const &msg) 
 {
-    if (!valid_ || static_cast<int>(level) < static_cast<int>(min_level_))
+    if (!valid_ || !is_allowed(level))
     {
         return;
     }
@@ -271,23 +898,21 @@ void Logger::log_data(LogLevel level, void const *data, size_t size, std::string
     }
 
     std::string full_msg = msg + hex;
-    // 遍历所有sink
-    for (auto& sink : sinks_)
-    {
-        sink->log(name_, level, full_msg);
-    }
+    dispatch(level, full_msg);
 }
 
 void Logger::log_limited(std::string const &tag, int allowed_num, LogLevel level, std::string const &msg)
 {
     int left = limited_allowed_left(tag, allowed_num);
-    if (valid_ && (static_cast<int>(level) >= static_cast<int>(min_level_)) && (left > 0))
+    if (valid_ && is_allowed(level) && (left > 0))
     {
-        std::string final_msg = (left == 1) ? (msg + " (more messages will be suppressed)") : msg;
-        // 遍历所有sink
-        for (auto& sink : sinks_)
+        if (left == 1)
+        {
+            dispatch(level, msg + " (more messages will be suppressed)");
+        }
+        else
         {
-            sink->log(name_, level, final_msg);
+            dispatch(level, msg);
         }
     }
 }
@@ -322,27 +947,48 @@ int Logger::limited_allowed_left(std::string const &tag, int allowed_num)
  * 计算所有sink的等级，更新min_level_和max_level_
  * min_level_为所有sink的等级中最小的, 比如一个SINK 是INFO，另一个是DEBUG，则min_level_为DEBUG
  * max_level_为所有sink的等级中最大的, 比如一个SINK 是INFO，另一个是DEBUG，则max_level_为INFO
+ * 
+ * 同时刷新sink分发表：sinks_ 在logger发布前就已确定，分发表只在第一次调用时建立，
+ * 之后只原子地更新每个条目的等级，日志线程无需加锁即可看到新的等级。
  */
 void Logger::update_filter_level()
 {
-    min_level_ = LogLevel::Off;
-    max_level_ = LogLevel::Trace;
-    for (auto& sink : sinks_)
+    if (!plan_)
     {
-        if (sink)
+        plan_size_ = 0;
+        plan_.reset(new SinkPlanEntry[sinks_.size()]);
+        for (auto& sink : sinks_)
         {
-            LogLevel sink_level = sink->get_level();
-            if (static_cast<int>(sink_level) < static_cast<int>(min_level_))
+            if (sink)
             {
-                min_level_ = sink_level;
-            }
-            if (static_cast<int>(sink_level) > static_cast<int>(max_level_))
-            {
-                max_level_ = sink_level;
+                plan_[plan_size_++].sink = sink.get();
             }
         }
     }
-    __debug("update filter level: min=%s, max=%s", log_level_name(min_level_), log_level_name(max_level_));
+
+    LogLevel min_level = LogLevel::Off;
+    max_level_ = LogLevel::Trace;
+    for (size_t i = 0; i < plan_size_; ++i)
+    {
+        LogLevel sink_level = plan_[i].sink->get_level();
+        plan_[i].level.store(sink_level, std::memory_order_relaxed);
+        if (static_cast<int>(sink_level) < static_cast<int>(min_level))
+        {
+            min_level = sink_level;
+        }
+        if (static_cast<int>(sink_level) > static_cast<int>(max_level_))
+        {
+            max_level_ = sink_level;
+        }
+    }
+    min_level_.store(min_level, std::memory_order_relaxed);
+    __debug("update filter level: min=%s, max=%s", log_level_name(min_level), log_level_name(max_level_));
+
+    // 默认 logger 的等级决定 SLOG_* 调用点的开关
+    if (detail::s_default_logger_raw.load(std::memory_order_relaxed) == this)
+    {
+        detail::refresh_source_sites(min_level);
+    }
 }
 
 /**
@@ -365,6 +1011,25 @@ void Logger::set_rule_level(LogLevel level)
 namespace detail
 {
 
+/**
+ * @brief 解析启动时的规则文本（环境变量、命令行参数）
+ * 
+ * 格式同 apply_logger_rules()，另外允许只写一个等级（如 "debug"），等价于 "*:debug"
+ */
+std::vector<std::pair<std::string, LogLevel>> parse_bootstrap_rules(const std::string& text)
+{
+    std::string trimmed = text;
+    trimmed.erase(0, trimmed.find_first_not_of(" \t\r\n"));
+    trimmed.erase(trimmed.find_last_not_of(" \t\r\n") + 1);
+    if (trimmed.find(':') == std::string::npos) {
+        LogLevel level = log_level_from_name(trimmed, LogLevel::Unknown);
+        if (level != LogLevel::Unknown) {
+            return {std::make_pair(std::string("*"), level)};
+        }
+    }
+    return parse_logger_rules(text);
+}
+
 /**
  * @brief 全局日志注册表管理器（使用Meyer's Singleton模式）
  * 
@@ -407,10 +1072,11 @@ public:
             }
             // 如果注册表中有logger，使用第一个
             if (!registry_.empty()) {
-                default_logger_ = registry_.begin()->second;
+                assign_default(registry_.begin()->second);
                 return default_logger_;
             } else {
-                default_logger_ = std::make_shared<Logger>(logger_name, std::make_shared<sink::Stdout>(LogLevel::Info));
+                // 先发布默认logger，注册时应用规则会同步刷新调用点
+                assign_default(std::make_shared<Logger>(logger_name, std::make_shared<sink::Stdout>(LogLevel::Info)));
                 new_default_logger = default_logger_;
             }
         }
@@ -444,9 +1110,49 @@ public:
 
         std::lock_guard<std::mutex> lock(mutex_);
         registry_[logger->name()] = logger;
+        s_registry_generation.fetch_add(1, std::memory_order_release);
         return true;
      }
 
+    /**
+     * @brief 注册一个规则对象（非 Logger，如 StaticLogger）
+     * 
+     * @param target 规则对象
+     * @return true 成功
+     * @return false 失败（target为空）
+     */
+    bool register_rule_target(RuleTarget *target)
+    {
+        if (!target) {
+            return false;
+        }
+
+        auto level = get_logger_level_rule(target->rule_name());
+        if (level != LogLevel::Unknown) {
+            target->set_rule_level(level);
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        rule_targets_.push_back(target);
+        return true;
+    }
+
+    /**
+     * @brief 注销一个规则对象
+     * 
+     * @param target 规则对象
+     */
+    void unregister_rule_target(RuleTarget *target)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (auto it = rule_targets_.begin(); it != rule_targets_.end(); ++it) {
+            if (*it == target) {
+                rule_targets_.erase(it);
+                break;
+            }
+        }
+    }
+
     /**
      * @brief 设置默认logger
      * 
@@ -459,7 +1165,7 @@ public:
         std::lock_guard<std::mutex> lock(mutex_);
         auto it = registry_.find(name);
         if (it != registry_.end()) {
-            default_logger_ = it->second;
+            assign_default(it->second);
             return true;
         }
         return false;
@@ -500,9 +1206,10 @@ public:
     {
         std::lock_guard<std::mutex> lock(mutex_);
         registry_.erase(name);
+        s_registry_generation.fetch_add(1, std::memory_order_release);
         // 如果被移除的是默认logger，重置默认logger
         if (default_logger_ && default_logger_->name() == name) {
-            default_logger_.reset();
+            assign_default(nullptr);
         }
     }
 
@@ -550,79 +1257,212 @@ public:
                     break;
             }
         }
-        
-        return regex_pattern;
+        
+        return regex_pattern;
+    }
+
+    /**
+     * @brief 设置全局日志等级规则
+     * 
+     * 支持三种模式：
+     * 1. 精确匹配：直接使用 logger 名称，如 "my_logger"
+     * 2. Shell 通配符模式：使用 * 和 ?，如 "v4l2-*" 可以匹配所有以 "v4l2-" 开头的 logger
+     * 3. 正则表达式匹配：使用正则表达式模式，如 ".*_debug" 可以匹配所有以 "_debug" 结尾的 logger
+     * 
+     * 优先级：精确匹配 > Shell 通配符 > 正则匹配
+     * 
+     * @param pattern logger名称、shell 通配符模式或正则表达式模式
+     * @param level 日志等级
+     */
+    void set_logger_level_rule(const std::string& pattern, LogLevel level) 
+    {
+        // 不允许 为空
+        if (pattern.empty()) {
+            return;
+        }
+
+        std::vector<std::pair<std::string, LogLevel>> rules;
+        rules.emplace_back(pattern, level);
+        set_logger_level_rules(rules, false);
+    }
+
+    /**
+     * @brief 批量设置全局日志等级规则
+     * 
+     * 规则先在锁外全部编译好，再在一次加锁内整体替换（或追加到）规则表，每个 logger 只计算、发布一次等级。
+     * 日志线程只读取各 logger 的原子等级，不会因为规则数量多而被阻塞。
+     * 
+     * @param rules 规则列表（pattern, level），空 pattern 被忽略
+     * @param replace true 替换全部现有规则，每个 logger 按新规则表重新计算等级（与新注册 logger 的匹配结果一致），
+     *                原先被规则控制、新规则表不再匹配的 logger 恢复自身等级；
+     *                false 追加到现有规则，被本次规则匹配到的已有 logger 取本次匹配到的等级，
+     *                与逐条调用 set_logger_level() 一致（后设置的规则覆盖先前的结果）
+     * @return int 接受的规则数量
+     */
+    int set_logger_level_rules(std::vector<std::pair<std::string, LogLevel>> const& rules, bool replace)
+    {
+        std::map<std::string, LogLevel> exact_rules;
+        std::vector<PatternRule> pattern_rules;
+        int accepted = compile_rules(rules, &exact_rules, &pattern_rules);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+
+        // 追加时受影响的是被本次规则匹配到的 logger，它们直接取本次匹配到的等级（与逐条调用 set_logger_level()
+        // 的效果一致，后设置的规则覆盖先前规则的结果）；替换时受影响的是原先受规则控制的 logger，
+        // 它们和新规则表匹配到的 logger 一起按新规则表重新计算等级（规则被移除后恢复自身等级）
+        std::vector<LogLevel> batch_levels;
+        std::vector<LogLevel> target_batch_levels;
+        std::vector<bool> touched;
+        std::vector<bool> target_touched;
+        if (replace) {
+            touched.reserve(registry_.size());
+            for (const auto& pair : registry_) {
+                touched.push_back(lookup_rule_locked(pair.first) != LogLevel::Unknown);
+            }
+            target_touched.reserve(rule_targets_.size());
+            for (const auto* target : rule_targets_) {
+                target_touched.push_back(lookup_rule_locked(target->rule_name()) != LogLevel::Unknown);
+            }
+        } else {
+            batch_levels.reserve(registry_.size());
+            for (const auto& pair : registry_) {
+                batch_levels.push_back(match_batch(exact_rules, pattern_rules, pair.first));
+            }
+            target_batch_levels.reserve(rule_targets_.size());
+            for (const auto* target : rule_targets_) {
+                target_batch_levels.push_back(match_batch(exact_rules, pattern_rules, target->rule_name()));
+            }
+        }
+
+        if (replace) {
+            level_rules_.swap(exact_rules);
+            regex_level_rules_.swap(pattern_rules);
+        } else {
+            for (const auto& pair : exact_rules) {
+                level_rules_[pair.first] = pair.second;
+            }
+            // 已有相同 pattern 的规则先移除再追加，重新设置同一个通配符时新等级生效
+            for (auto& pattern_rule : pattern_rules) {
+                erase_pattern_rule(regex_level_rules_, pattern_rule.pattern);
+                regex_level_rules_.push_back(std::move(pattern_rule));
+            }
+        }
+
+        size_t index = 0;
+        for (auto& pair : registry_) {
+            if (!replace) {
+                LogLevel level = batch_levels[index++];
+                if (level != LogLevel::Unknown) {
+                    pair.second->set_rule_level(level);
+                }
+                continue;
+            }
+            bool affected = touched[index++];
+            LogLevel level = lookup_rule_locked(pair.first);
+            if (affected || level != LogLevel::Unknown) {
+                pair.second->set_rule_level(level);
+            }
+        }
+        index = 0;
+        for (auto* target : rule_targets_) {
+            if (!replace) {
+                LogLevel level = target_batch_levels[index++];
+                if (level != LogLevel::Unknown) {
+                    target->set_rule_level(level);
+                }
+                continue;
+            }
+            bool affected = target_touched[index++];
+            LogLevel level = lookup_rule_locked(target->rule_name());
+            if (affected || level != LogLevel::Unknown) {
+                target->set_rule_level(level);
+            }
+        }
+        return accepted;
     }
 
     /**
-     * @brief 设置全局日志等级规则
-     * 
-     * 支持三种模式：
-     * 1. 精确匹配：直接使用 logger 名称，如 "my_logger"
-     * 2. Shell 通配符模式：使用 * 和 ?，如 "v4l2-*" 可以匹配所有以 "v4l2-" 开头的 logger
-     * 3. 正则表达式匹配：使用正则表达式模式，如 ".*_debug" 可以匹配所有以 "_debug" 结尾的 logger
+     * @brief 移除一组规则并追加新规则，一次加锁发布
      * 
-     * 优先级：精确匹配 > Shell 通配符 > 正则匹配
+     * removed 中的规则只有 pattern 和等级都与规则表中的一致时才移除（之后被其他来源重新设置过的保留）。
+     * 被新规则匹配到的 logger 取新规则的等级（同追加）；只被移除的规则匹配到的 logger 按剩余规则表重新计算，
+     * 不再匹配任何规则时恢复自身等级。其余 logger 不受影响。
      * 
-     * @param pattern logger名称、shell 通配符模式或正则表达式模式
-     * @param level 日志等级
+     * @param removed 要移除的规则（pattern, level）
+     * @param rules 要追加的规则（pattern, level），空 pattern 被忽略
+     * @return int 接受的新规则数量
      */
-    void set_logger_level_rule(const std::string& pattern, LogLevel level) 
+    int update_logger_level_rules(std::vector<std::pair<std::string, LogLevel>> const& removed,
+                                  std::vector<std::pair<std::string, LogLevel>> const& rules)
     {
-
-        // 不允许 为空
-        if (pattern.empty()) {
-            return;
-        }
+        std::map<std::string, LogLevel> exact_rules;
+        std::vector<PatternRule> pattern_rules;
+        int accepted = compile_rules(rules, &exact_rules, &pattern_rules);
 
         std::lock_guard<std::mutex> lock(mutex_);
-        
-        // 检查是否包含 shell 通配符（* 或 ?），但不包含正则表达式特殊字符
-        bool has_wildcard = false;
-        bool has_regex_special = false;
-        
-        for (char c : pattern) {
-            if (c == '*' || c == '?') {
-                has_wildcard = true;
+
+        // 从规则表中取出仍未被改动的待移除规则
+        std::map<std::string, LogLevel> removed_exact;
+        std::vector<PatternRule> removed_patterns;
+        for (const auto& rule : removed) {
+            auto exact = level_rules_.find(rule.first);
+            if (exact != level_rules_.end()) {
+                if (exact->second == rule.second) {
+                    removed_exact.insert(*exact);
+                    level_rules_.erase(exact);
+                }
+                continue;
             }
-            if (c == '.' || c == '+' || c == '^' || c == '$' || 
-                c == '[' || c == ']' || c == '(' || c == ')' ||
-                c == '{' || c == '}' || c == '|' || c == '\\') {
-                has_regex_special = true;
-                break;
+            auto pattern = std::find_if(regex_level_rules_.begin(), regex_level_rules_.end(),
+                                        [&rule](PatternRule const& r) { return r.pattern == rule.first; });
+            if (pattern != regex_level_rules_.end() && pattern->level == rule.second) {
+                removed_patterns.push_back(std::move(*pattern));
+                regex_level_rules_.erase(pattern);
             }
         }
-        
-        // 如果包含通配符但不包含正则特殊字符，转换为正则表达式
-        std::string regex_pattern_str = pattern;
-        if (has_wildcard && !has_regex_special) {
-            regex_pattern_str = wildcard_to_regex(pattern);
-            __debug("convert wildcard pattern '%s' to regex '%s'", pattern.c_str(), regex_pattern_str.c_str());
+
+        // 受影响的 logger：被新规则匹配到的取本次的等级；只被移除的规则匹配到的记为 Unknown，稍后按剩余规则表计算
+        std::vector<std::pair<bool, LogLevel>> levels;
+        std::vector<std::pair<bool, LogLevel>> target_levels;
+        auto affected = [&](const std::string& name) {
+            LogLevel level = match_batch(exact_rules, pattern_rules, name);
+            bool touched = level != LogLevel::Unknown || match_batch(removed_exact, removed_patterns, name) != LogLevel::Unknown;
+            return std::make_pair(touched, level);
+        };
+        levels.reserve(registry_.size());
+        for (const auto& pair : registry_) {
+            levels.push_back(affected(pair.first));
         }
-        
-        // 尝试编译为正则表达式
-        try {
-            std::regex regex_pattern(regex_pattern_str, std::regex::ECMAScript | std::regex::optimize);
-            
-            // 如果包含通配符或正则特殊字符，作为正则规则
-            if (has_wildcard || has_regex_special) {
-                // 作为正则表达式规则存储（保存原始字符串、编译后的正则表达式和日志等级）
-                regex_level_rules_.emplace_back(std::make_tuple(pattern, std::move(regex_pattern), level));
-                __debug("add regex level rule: %s", pattern.c_str());
-            } else {
-                // 作为精确匹配规则存储
-                level_rules_[pattern] = level;
-                __debug("add exact level rule: %s", pattern.c_str());
+        target_levels.reserve(rule_targets_.size());
+        for (const auto* target : rule_targets_) {
+            target_levels.push_back(affected(target->rule_name()));
+        }
+
+        for (const auto& pair : exact_rules) {
+            level_rules_[pair.first] = pair.second;
+        }
+        for (auto& pattern_rule : pattern_rules) {
+            erase_pattern_rule(regex_level_rules_, pattern_rule.pattern);
+            regex_level_rules_.push_back(std::move(pattern_rule));
+        }
+
+        size_t index = 0;
+        for (auto& pair : registry_) {
+            auto const& entry = levels[index++];
+            if (entry.first) {
+                pair.second->set_rule_level(entry.second != LogLevel::Unknown ? entry.second
+                                                                               : lookup_rule_locked(pair.first));
             }
-        } catch (const std::regex_error&) {
-            // 如果正则表达式编译失败，作为精确匹配规则
-            level_rules_[pattern] = level;
-            __debug("add exact level rule (regex compile failed): %s", pattern.c_str());
         }
-        
-        // 立即应用到所有已存在的匹配的 logger
-        bool is_regex = has_wildcard || has_regex_special;
-        apply_rules_to_existing_loggers(pattern, level, is_regex);
+        index = 0;
+        for (auto* target : rule_targets_) {
+            auto const& entry = target_levels[index++];
+            if (entry.first) {
+                target->set_rule_level(entry.second != LogLevel::Unknown ? entry.second
+                                                                          : lookup_rule_locked(target->rule_name()));
+            }
+        }
+        return accepted;
     }
 
     /**
@@ -636,29 +1476,7 @@ public:
     LogLevel get_logger_level_rule(const std::string& name) const 
     {
         std::lock_guard<std::mutex> lock(mutex_);
-        
-        // 首先检查精确匹配
-        auto it = level_rules_.find(name);
-        if (it != level_rules_.end()) {
-            __debug("get exact level rule for logger: %s %s", name.c_str(), log_level_name(it->second));
-            return it->second;
-        }
-        
-        // 然后检查正则表达式匹配（按添加顺序，第一个匹配的规则生效）
-        for (const auto& regex_rule : regex_level_rules_) {
-            #ifdef SLOG_DEBUG_ENABLE
-            const std::string& pattern_str = std::get<0>(regex_rule);
-            #endif
-            const std::regex& regex_pattern = std::get<1>(regex_rule);
-            LogLevel rule_level = std::get<2>(regex_rule);
-            __debug("try match regex rule: %s to logger: %s", pattern_str.c_str(), name.c_str());
-            if (std::regex_match(name, regex_pattern)) {
-                __debug("get regex level rule for logger: %s %s", name.c_str(), log_level_name(rule_level));
-                return rule_level;
-            }
-        }
-        
-        return LogLevel::Unknown;
+        return lookup_rule_locked(name);
     }
 
     /**
@@ -674,10 +1492,8 @@ public:
         std::map<std::string, LogLevel> all_rules = level_rules_;
         
         // 添加正则匹配规则（使用原始 pattern 字符串）
-        for (const auto& regex_rule : regex_level_rules_) {
-            const std::string& pattern = std::get<0>(regex_rule);
-            LogLevel level = std::get<2>(regex_rule);
-            all_rules[pattern] = level;
+        for (const auto& pattern_rule : regex_level_rules_) {
+            all_rules[pattern_rule.pattern] = pattern_rule.level;
         }
         
         return all_rules;
@@ -699,73 +1515,195 @@ public:
     {
         std::lock_guard<std::mutex> lock(mutex_);
         std::vector<std::string> logger_names;
-        logger_names.reserve(registry_.size());
+        logger_names.reserve(registry_.size() + rule_targets_.size());
         for (const auto& pair : registry_) {
             logger_names.push_back(pair.first);
         }
+        for (const auto* target : rule_targets_) {
+            logger_names.push_back(target->rule_name());
+        }
         return logger_names;
     }
 
+    /**
+     * @brief 让所有 logger 写出已缓冲的日志
+     * 
+     * 在锁外逐个 flush，慢 sink 不会阻塞注册表
+     */
+    void flush_all()
+    {
+        std::vector<std::shared_ptr<Logger>> loggers;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            loggers.reserve(registry_.size());
+            for (const auto& pair : registry_) {
+                loggers.push_back(pair.second);
+            }
+        }
+        for (auto& logger : loggers) {
+            logger->flush();
+        }
+    }
+
 private:
+    /// 非精确匹配的规则：shell 通配符直接按 glob 匹配，其余按正则表达式匹配
+    struct PatternRule
+    {
+        std::string pattern;
+        std::regex regex;
+        LogLevel level;
+        bool glob;
+    };
+
+    /// 移除 pattern 相同的规则
+    static void erase_pattern_rule(std::vector<PatternRule>& rules, std::string const& pattern)
+    {
+        rules.erase(std::remove_if(rules.begin(), rules.end(),
+                                   [&pattern](PatternRule const& rule) { return rule.pattern == pattern; }),
+                    rules.end());
+    }
+
     /**
-     * @brief 应用规则到已存在的 logger
+     * @brief 在锁外编译一批规则，同一批中重复的 pattern 以最后一条为准
      * 
-     * @param pattern 规则模式（精确匹配或正则表达式）
-     * @param level 日志等级（未使用，保留用于未来扩展）
-     * @param is_regex 是否是正则表达式
+     * @return int 接受的规则数量（空 pattern 被忽略）
      */
-    void apply_rules_to_existing_loggers(const std::string& pattern, LogLevel  level, bool is_regex) 
+    static int compile_rules(std::vector<std::pair<std::string, LogLevel>> const& rules,
+                             std::map<std::string, LogLevel>* exact_rules, std::vector<PatternRule>* pattern_rules)
     {
-        if (is_regex) {
-            // 正则表达式匹配：遍历所有 logger
-            try {
-                // 检查是否包含 shell 通配符，需要转换
-                bool has_wildcard = false;
-                bool has_regex_special = false;
-                
-                for (char c : pattern) {
-                    if (c == '*' || c == '?') {
-                        has_wildcard = true;
-                    }
-                    if (c == '.' || c == '+' || c == '^' || c == '$' || 
-                        c == '[' || c == ']' || c == '(' || c == ')' ||
-                        c == '{' || c == '}' || c == '|' || c == '\\') {
-                        has_regex_special = true;
-                        break;
-                    }
-                }
-                
-                std::string regex_pattern_str = pattern;
-                if (has_wildcard && !has_regex_special) {
-                    regex_pattern_str = wildcard_to_regex(pattern);
-                }
-                
-                std::regex regex_pattern(regex_pattern_str, std::regex::ECMAScript | std::regex::optimize);
-                for (auto& pair : registry_) {
-                    __debug("try match regex rule: %s to logger: %s", pattern.c_str(), pair.first.c_str());
-                    if (std::regex_match(pair.first, regex_pattern)) {
-                        auto logger = pair.second;
-                        logger->set_rule_level(level);
-                        __debug("apply regex level rule to logger: %s", pair.first.c_str());
-                    }
-                }
-            } catch (const std::regex_error&) {
-                // 正则表达式编译失败，忽略
+        int accepted = 0;
+        for (const auto& rule : rules) {
+            if (rule.first.empty()) {
+                continue;
             }
-        } else {
-            // 精确匹配
-            for (auto& pair : registry_) {
-                if (pair.first == pattern) {
-                    auto logger = pair.second;
-                    logger->set_rule_level(level);
-                    __debug("apply exact level rule to logger: %s", pair.first.c_str());
-                }
+            PatternRule pattern_rule;
+            if (compile_rule(rule.first, rule.second, &pattern_rule)) {
+                erase_pattern_rule(*pattern_rules, rule.first);
+                pattern_rules->push_back(std::move(pattern_rule));
+                __debug("add pattern level rule: %s", rule.first.c_str());
+            } else {
+                (*exact_rules)[rule.first] = rule.second;
+                __debug("add exact level rule: %s", rule.first.c_str());
+            }
+            accepted++;
+        }
+        return accepted;
+    }
+
+    /**
+     * @brief 编译一条规则
+     * 
+     * @return true 通配符或正则规则，已填充 out
+     * @return false 精确匹配规则（包括正则表达式编译失败的情况）
+     */
+    static bool compile_rule(const std::string& pattern, LogLevel level, PatternRule* out)
+    {
+        // 检查是否包含 shell 通配符（* 或 ?），但不包含正则表达式特殊字符
+        bool has_wildcard = false;
+        bool has_regex_special = false;
+        
+        for (char c : pattern) {
+            if (c == '*' || c == '?') {
+                has_wildcard = true;
+            }
+            if (c == '.' || c == '+' || c == '^' || c == '$' || 
+                c == '[' || c == ']' || c == '(' || c == ')' ||
+                c == '{' || c == '}' || c == '|' || c == '\\') {
+                has_regex_special = true;
+                break;
+            }
+        }
+
+        if (!has_wildcard && !has_regex_special) {
+            return false;
+        }
+
+        out->pattern = pattern;
+        out->level = level;
+        // 纯通配符规则不需要正则引擎，匹配结果与 wildcard_to_regex() 转换后的正则一致
+        out->glob = has_wildcard && !has_regex_special;
+        if (out->glob) {
+            return true;
+        }
+
+        // 尝试编译为正则表达式
+        try {
+            out->regex = std::regex(pattern, std::regex::ECMAScript | std::regex::optimize);
+            return true;
+        } catch (const std::regex_error&) {
+            // 如果正则表达式编译失败，作为精确匹配规则
+            __debug("regex compile failed, use as exact rule: %s", pattern.c_str());
+            return false;
+        }
+    }
+
+    static bool match_rule(const PatternRule& rule, const std::string& name)
+    {
+        return rule.glob ? detail::glob_match(rule.pattern, name) : std::regex_match(name, rule.regex);
+    }
+
+    /**
+     * @brief 名称在一批规则中匹配到的等级
+     * 
+     * 精确匹配优先；通配符/正则规则取最后一条匹配的（同一批中重复的 pattern 已移到最后一次出现的位置），
+     * 即按批内顺序逐条应用的结果。
+     * 
+     * @return LogLevel 没有匹配的规则时返回 LogLevel::Unknown
+     */
+    static LogLevel match_batch(const std::map<std::string, LogLevel>& exact_rules,
+                                const std::vector<PatternRule>& pattern_rules, const std::string& name)
+    {
+        auto it = exact_rules.find(name);
+        if (it != exact_rules.end()) {
+            return it->second;
+        }
+        for (auto rule = pattern_rules.rbegin(); rule != pattern_rules.rend(); ++rule) {
+            if (match_rule(*rule, name)) {
+                return rule->level;
+            }
+        }
+        return LogLevel::Unknown;
+    }
+
+    /**
+     * @brief 查找 logger 的规则等级（需持有 mutex_）
+     * 
+     * 优先级：精确匹配 > 通配符/正则匹配（按添加顺序，第一个匹配的规则生效）
+     */
+    LogLevel lookup_rule_locked(const std::string& name) const
+    {
+        // 首先检查精确匹配
+        auto it = level_rules_.find(name);
+        if (it != level_rules_.end()) {
+            __debug("get exact level rule for logger: %s %s", name.c_str(), log_level_name(it->second));
+            return it->second;
+        }
+
+        // 然后检查通配符和正则表达式匹配（按添加顺序，第一个匹配的规则生效）
+        for (const auto& rule : regex_level_rules_) {
+            __debug("try match rule: %s to logger: %s", rule.pattern.c_str(), name.c_str());
+            if (match_rule(rule, name)) {
+                __debug("get pattern level rule for logger: %s %s", name.c_str(), log_level_name(rule.level));
+                return rule.level;
             }
         }
+
+        return LogLevel::Unknown;
     }
 
 private:
-    LoggerRegistry() = default;
+    /**
+     * @brief 构造时读取环境变量 SLOG_LEVEL 中的规则
+     * 
+     * 注册表在第一个 logger 注册前构造，因此静态初始化阶段创建的 logger 同样受这些规则控制。
+     */
+    LoggerRegistry()
+    {
+        const char* env = std::getenv("SLOG_LEVEL");
+        if (env != nullptr && env[0] != '\0') {
+            set_logger_level_rules(parse_bootstrap_rules(env), false);
+        }
+    }
     ~LoggerRegistry() = default;
     LoggerRegistry(const LoggerRegistry&) = delete;
     LoggerRegistry& operator=(const LoggerRegistry&) = delete;
@@ -773,10 +1711,33 @@ private:
     mutable std::mutex mutex_;  ///< 使用 mutable 以便在 const 方法中锁定
     std::unordered_map<std::string, std::shared_ptr<Logger>> registry_;
     std::shared_ptr<Logger> default_logger_;
+
+    /**
+     * @brief 更换默认logger并刷新所有调用点（需持有 mutex_）
+     * 
+     * 没有默认logger时所有调用点保持打开，由首次调用时创建的默认logger决定是否输出。
+     */
+    void assign_default(std::shared_ptr<Logger> logger)
+    {
+        default_logger_ = std::move(logger);
+        s_default_logger_raw.store(default_logger_.get(), std::memory_order_relaxed);
+        refresh_source_sites(default_logger_ ? default_logger_->get_level() : LogLevel::Trace);
+    }
     std::map<std::string, LogLevel> level_rules_;  ///< 全局日志等级规则（精确匹配）
-    std::vector<std::tuple<std::string, std::regex, LogLevel>> regex_level_rules_;  ///< 全局日志等级规则（正则表达式匹配）：存储原始字符串、编译后的正则表达式和日志等级
+    std::vector<PatternRule> regex_level_rules_;  ///< 全局日志等级规则（通配符和正则表达式匹配），按添加顺序保存
+    std::vector<RuleTarget*> rule_targets_;  ///< 受规则控制的非 Logger 对象（如 StaticLogger），不持有所有权
 };
 
+bool register_rule_target(RuleTarget *target)
+{
+    return LoggerRegistry::instance().register_rule_target(target);
+}
+
+void unregister_rule_target(RuleTarget *target)
+{
+    LoggerRegistry::instance().unregister_rule_target(target);
+}
+
 } // namespace detail
 
 std::shared_ptr<Logger> Logger::clone(std::string const & logger_name) const
@@ -785,7 +1746,7 @@ std::shared_ptr<Logger> Logger::clone(std::string const & logger_name) const
         return detail::LoggerRegistry::instance().get_default(logger_name);
     }
 
-    if (logger_name == name_)
+    if (logger_name == name_->name)
     {
         return default_logger();
     }
@@ -812,7 +1773,7 @@ std::shared_ptr<Logger> Logger::clone(std::string const & logger_name) const
     __debug("clone logger: %s", logger_name.c_str());
 
     auto logger = std::make_shared<Logger>();
-    logger->name_ = logger_name;
+    logger->name_ = &detail::intern_logger_name(logger_name);
     logger->sinks_ = cloned_sinks;
     logger->valid_ = true;
     logger->update_filter_level();
@@ -827,7 +1788,7 @@ std::shared_ptr<Logger> Logger::clone(std::string const & logger_name, LogLevel
         return detail::LoggerRegistry::instance().get_default(logger_name);
     }
 
-    if (logger_name == name_)
+    if (logger_name == name_->name)
     {
         return default_logger();
     }
@@ -854,7 +1815,7 @@ std::shared_ptr<Logger> Logger::clone(std::string const & logger_name, LogLevel
     __debug("clone logger: %s", logger_name.c_str());
 
     auto logger = std::make_shared<Logger>();
-    logger->name_ = logger_name;
+    logger->name_ = &detail::intern_logger_name(logger_name);
     logger->sinks_ = cloned_sinks;
     logger->valid_ = true;
     logger->update_filter_level();
@@ -868,6 +1829,34 @@ std::shared_ptr<Logger> default_logger() {
     return detail::LoggerRegistry::instance().get_default();
 }
 
+void vlog(LogLevel level, fmt::string_view fmt, fmt::format_args args)
+{
+    default_logger()->vlog(level, fmt, args);
+}
+
+namespace detail {
+
+void log_default(LogLevel level, std::string const &msg)
+{
+    default_logger()->log(level, msg);
+}
+
+void vlog_site_limited(int left, LogLevel level, fmt::string_view fmt, fmt::format_args args)
+{
+    auto logger = default_logger();
+    if (!logger->is_allowed(level)) {
+        return;
+    }
+    PayloadBuffer payload;
+    fmt::vformat_to(std::back_inserter(payload.str()), fmt, args);
+    if (left == 1) {
+        payload.str() += " (more messages will be suppressed)";
+    }
+    logger->log(level, payload.str());
+}
+
+} // namespace detail
+
 bool register_logger(std::shared_ptr<Logger> logger) 
 {
     return detail::LoggerRegistry::instance().register_logger(logger);
@@ -893,6 +1882,11 @@ std::shared_ptr<Logger> get_logger(const std::string& name)
     return default_logger()->clone(name);
 }
 
+std::shared_ptr<Logger> find_logger(const std::string& name)
+{
+    return detail::LoggerRegistry::instance().get_logger(name);
+}
+
 bool has_logger(const std::string& name) 
 {
     return detail::LoggerRegistry::instance().has_logger(name);
@@ -958,6 +1952,26 @@ std::shared_ptr<Logger> make_rotating_file_logger(std::string const &name, std::
     return make_logger(name, sinks);
 }
 
+std::shared_ptr<Logger> make_json_file_logger(std::string const &name, std::string const &filepath,
+    LogLevel level, size_t max_file_size, size_t max_files, bool flush_on_write)
+{
+    return make_logger(name, std::make_shared<sink::JsonFile>(level, filepath, max_file_size, max_files, flush_on_write));
+}
+
+#if !defined(_WIN32)
+std::shared_ptr<Logger> make_syslog_logger(std::string const &name, LogLevel level, std::string const &ident)
+{
+    return make_logger(name, std::make_shared<sink::Syslog>(level, ident));
+}
+#endif // !_WIN32
+
+#if defined(__linux__)
+std::shared_ptr<Logger> make_journal_logger(std::string const &name, LogLevel level)
+{
+    return make_logger(name, std::make_shared<sink::Journal>(level));
+}
+#endif // __linux__
+
 #ifdef BUILD_WITH_SPDLOG
 std::shared_ptr<Logger> make_spdlog_logger(std::string const &name, LogLevel level, bool async)
 {
@@ -981,6 +1995,46 @@ std::shared_ptr<Logger> make_spdlog_logger(std::string const &name, std::string
     auto sink = std::make_shared<sink::Spdlog>(level, sink_type, filepath, async);
     return make_logger(name, sink);
 }
+
+std::shared_ptr<Logger> make_spdlog_rotating_file_logger(std::string const &name, std::string const &filepath,
+    LogLevel level, size_t max_file_size, size_t max_files, bool to_console, bool async)
+{
+    if (filepath.empty()) {
+        std::cerr << "**ERROR** make_spdlog_rotating_file_logger(): filepath is empty" << std::endl;
+        return nullptr;
+    }
+
+    int sink_type = sink::SpdlogSinkType::ToRotatingFile;
+    if (to_console) {
+        sink_type |= sink::SpdlogSinkType::ToConsole;
+    }
+
+    auto sink = std::make_shared<sink::Spdlog>(level, sink_type, filepath, async, max_file_size, max_files);
+    return make_logger(name, sink);
+}
+
+std::shared_ptr<Logger> make_spdlog_daily_file_logger(std::string const &name, std::string const &filepath,
+    LogLevel level, int hour, int minute, size_t max_files, bool to_console, bool async)
+{
+    if (filepath.empty()) {
+        std::cerr << "**ERROR** make_spdlog_daily_file_logger(): filepath is empty" << std::endl;
+        return nullptr;
+    }
+    if (max_files > sink::Spdlog::kMaxDailyFiles) {
+        std::cerr << "**ERROR** make_spdlog_daily_file_logger(): max_files " << max_files
+                  << " exceeds " << sink::Spdlog::kMaxDailyFiles << std::endl;
+        return nullptr;
+    }
+
+    int sink_type = sink::SpdlogSinkType::ToDailyFile;
+    if (to_console) {
+        sink_type |= sink::SpdlogSinkType::ToConsole;
+    }
+
+    auto sink = std::make_shared<sink::Spdlog>(level, sink_type, filepath, async, 0, max_files);
+    sink->set_daily_rotation_time(hour, minute);
+    return make_logger(name, sink);
+}
 #endif // BUILD_WITH_SPDLOG
 
 
@@ -1010,8 +2064,18 @@ int apply_logger_rules(const std::string& rule_text)
     if (rule_text.empty()) {
         return 0;
     }
-    
-    int applied_count = 0;
+
+    // 先解析全部规则，再一次性发布，每个 logger 只更新一次等级
+    std::vector<std::pair<std::string, LogLevel>> rules = parse_logger_rules(rule_text);
+    if (rules.empty()) {
+        return 0;
+    }
+    return detail::LoggerRegistry::instance().set_logger_level_rules(rules, false);
+}
+
+std::vector<std::pair<std::string, LogLevel>> parse_logger_rules(const std::string& rule_text)
+{
+    std::vector<std::pair<std::string, LogLevel>> rules;
     std::string current_rule;
     
     // 遍历规则文本，分割规则（支持逗号和分号作为分隔符）
@@ -1051,10 +2115,8 @@ int apply_logger_rules(const std::string& rule_text)
                             LogLevel level = log_level_from_name(level_str, LogLevel::Unknown);
                             
                             if (level != LogLevel::Unknown) {
-                                // 应用规则
-                                set_logger_level(pattern, level);
-                                applied_count++;
-                                __debug("applied rule: pattern='%s', level='%s'", pattern.c_str(), level_str.c_str());
+                                rules.emplace_back(std::move(pattern), level);
+                                __debug("parsed rule: pattern='%s', level='%s'", rules.back().first.c_str(), level_str.c_str());
                             } else {
                                 __debug("invalid log level in rule: '%s'", trimmed_rule.c_str());
                             }
@@ -1073,7 +2135,41 @@ int apply_logger_rules(const std::string& rule_text)
         }
     }
     
-    return applied_count;
+    return rules;
+}
+
+int set_logger_level_rules(std::vector<std::pair<std::string, LogLevel>> const& rules, bool replace)
+{
+    return detail::LoggerRegistry::instance().set_logger_level_rules(rules, replace);
+}
+
+int update_logger_level_rules(std::vector<std::pair<std::string, LogLevel>> const& removed,
+                              std::vector<std::pair<std::string, LogLevel>> const& rules)
+{
+    return detail::LoggerRegistry::instance().update_logger_level_rules(removed, rules);
+}
+
+int apply_logger_rules_from_args(int argc, char const* const* argv, const std::string& option)
+{
+    std::vector<std::pair<std::string, LogLevel>> rules;
+    std::string prefix = option + "=";
+    for (int i = 1; i < argc; ++i) {
+        if (argv[i] == nullptr) {
+            continue;
+        }
+        std::string arg = argv[i];
+        if (arg.compare(0, prefix.size(), prefix) == 0) {
+            auto parsed = detail::parse_bootstrap_rules(arg.substr(prefix.size()));
+            rules.insert(rules.end(), parsed.begin(), parsed.end());
+        } else if (arg == option && i + 1 < argc && argv[i + 1] != nullptr) {
+            auto parsed = detail::parse_bootstrap_rules(argv[++i]);
+            rules.insert(rules.end(), parsed.begin(), parsed.end());
+        }
+    }
+    if (rules.empty()) {
+        return 0;
+    }
+    return detail::LoggerRegistry::instance().set_logger_level_rules(rules, false);
 }
 
 std::map<std::string, LogLevel> get_logger_rules()
@@ -1091,5 +2187,10 @@ std::vector<std::string> get_logger_list()
     return detail::LoggerRegistry::instance().get_logger_list();
 }
 
+void flush_all_loggers()
+{
+    detail::LoggerRegistry::instance().flush_all();
+}
+
 } // namespace slog
 
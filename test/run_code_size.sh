@@ -0,0 +1,39 @@
+#!/bin/bash
+# 调用点代码体积测试脚本
+# 比较 584 个不同参数类型组合的调用点在 vlog() 路径和逐调用点 format_to 展开下的代码段大小
+
+SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
+BUILD_DIR="${SCRIPT_DIR}/../build"
+VLOG_TEST="${BUILD_DIR}/bin/test_slog_code_size"
+INLINE_TEST="${BUILD_DIR}/bin/test_slog_code_size_inline"
+
+if [ ! -f "${BUILD_DIR}/CMakeCache.txt" ]; then
+    echo "❌ Error: build directory not configured!"
+    echo "Please configure the project first:"
+    echo "  cmake -S . -B build -DSLOG_BUILD_TEST=ON"
+    exit 1
+fi
+
+# 两个目标不在默认构建中，按需编译
+cmake --build "$BUILD_DIR" --target test_slog_code_size test_slog_code_size_inline || exit 1
+
+echo "=========================================="
+echo "   Call-Site Code Size (584 sites)"
+echo "=========================================="
+echo ""
+
+text_size() {
+    size -A "$1" | awk '$1 == ".text" { print $2 }'
+}
+
+VLOG_TEXT=$(text_size "$VLOG_TEST")
+INLINE_TEXT=$(text_size "$INLINE_TEST")
+
+printf "%-20s %10s bytes\n" "inline format_to:" "$INLINE_TEXT"
+printf "%-20s %10s bytes\n" "vlog:" "$VLOG_TEXT"
+printf "%-20s %10s bytes (%d%%)\n" "saved:" "$((INLINE_TEXT - VLOG_TEXT))" \
+    "$(( (INLINE_TEXT - VLOG_TEXT) * 100 / INLINE_TEXT ))"
+
+echo ""
+"$INLINE_TEST"
+"$VLOG_TEST"
@@ -18,29 +18,36 @@ echo ""
 
 # Stdout测试
 echo "┌─────────────────────────────────────────┐"
-echo "│ [1/4] Stdout Single Thread (10k logs)  │"
+echo "│ [1/5] Stdout Single Thread (10k logs)  │"
 echo "└─────────────────────────────────────────┘"
 $PERF_TEST -t stdout -n 10000
 
 echo ""
 echo "┌─────────────────────────────────────────────────┐"
-echo "│ [2/4] Stdout Multi-Thread (10k logs, 4 threads)│"
+echo "│ [2/5] Stdout Multi-Thread (10k logs, 4 threads)│"
 echo "└─────────────────────────────────────────────────┘"
 $PERF_TEST -t stdout -n 10000 -j 4
 
 # File测试
 echo ""
 echo "┌──────────────────────────────────────────────────┐"
-echo "│ [3/4] File Single Thread (10k logs, no flush)   │"
+echo "│ [3/5] File Single Thread (10k logs, no flush)   │"
 echo "└──────────────────────────────────────────────────┘"
 $PERF_TEST -t file -n 10000
 
 echo ""
 echo "┌────────────────────────────────────────────────────────┐"
-echo "│ [4/4] File Multi-Thread (10k logs, 4 threads, no flush)│"
+echo "│ [4/5] File Multi-Thread (10k logs, 4 threads, no flush)│"
 echo "└────────────────────────────────────────────────────────┘"
 $PERF_TEST -t file -n 10000 -j 4
 
+# JSON Lines 测试（与 File 对比）
+echo ""
+echo "┌──────────────────────────────────────────────────┐"
+echo "│ [5/5] JSON Single Thread (10k logs, no flush)   │"
+echo "└──────────────────────────────────────────────────┘"
+$PERF_TEST -t json -n 10000
+
 echo ""
 echo "=========================================="
 echo "   Quick Test Suite Completed!"
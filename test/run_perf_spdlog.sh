@@ -5,6 +5,7 @@
 SCRIPT_DIR="$(cd "$(dirname "${BASH_SOURCE[0]}")" && pwd)"
 PERF_TEST="${SCRIPT_DIR}/../build/bin/test_slog_performance"
 LOG_FILE="/tmp/perf_test_spdlog.log"
+ROTATING_LOG_FILE="/tmp/perf_test_spdlog_rotating.log"
 
 if [ ! -f "$PERF_TEST" ]; then
     echo "❌ Error: test_slog_performance not found!"
@@ -24,6 +25,7 @@ if [ -f "$LOG_FILE" ]; then
     echo "[Cleanup] Removed old log file: $LOG_FILE"
     echo ""
 fi
+rm -f /tmp/perf_test_spdlog_rotating*.log
 
 # ========== 同步模式测试 ==========
 echo "┌────────────────────────────────────────────────────────────┐"
@@ -34,21 +36,21 @@ echo ""
 # 同步模式 - 单线程
 echo ""
 echo "┌────────────────────────────────────────────────────────────┐"
-echo "│ [1/6] Sync Mode - Single Thread (100k logs)               │"
+echo "│ [1/8] Sync Mode - Single Thread (100k logs)               │"
 echo "└────────────────────────────────────────────────────────────┘"
 $PERF_TEST -t spdlog-file -f "$LOG_FILE" -n 100000
 
 # 同步模式 - 4线程
 echo ""
 echo "┌────────────────────────────────────────────────────────────┐"
-echo "│ [2/6] Sync Mode - Multi-Thread (100k logs, 4 threads)     │"
+echo "│ [2/8] Sync Mode - Multi-Thread (100k logs, 4 threads)     │"
 echo "└────────────────────────────────────────────────────────────┘"
 $PERF_TEST -t spdlog-file -f "$LOG_FILE" -n 100000 -j 4
 
 # 同步模式 - 8线程
 echo ""
 echo "┌────────────────────────────────────────────────────────────┐"
-echo "│ [3/6] Sync Mode - Multi-Thread (100k logs, 8 threads)     │"
+echo "│ [3/8] Sync Mode - Multi-Thread (100k logs, 8 threads)     │"
 echo "└────────────────────────────────────────────────────────────┘"
 $PERF_TEST -t spdlog-file -f "$LOG_FILE" -n 100000 -j 8
 
@@ -62,24 +64,45 @@ echo ""
 # 异步模式 - 单线程
 echo ""
 echo "┌────────────────────────────────────────────────────────────┐"
-echo "│ [4/6] Async Mode - Single Thread (100k logs)              │"
+echo "│ [4/8] Async Mode - Single Thread (100k logs)              │"
 echo "└────────────────────────────────────────────────────────────┘"
 $PERF_TEST -t spdlog-file -f "$LOG_FILE" -n 100000 -a
 
 # 异步模式 - 4线程
 echo ""
 echo "┌────────────────────────────────────────────────────────────┐"
-echo "│ [5/6] Async Mode - Multi-Thread (100k logs, 4 threads)    │"
+echo "│ [5/8] Async Mode - Multi-Thread (100k logs, 4 threads)    │"
 echo "└────────────────────────────────────────────────────────────┘"
 $PERF_TEST -t spdlog-file -f "$LOG_FILE" -n 100000 -j 4 -a
 
 # 异步模式 - 8线程
 echo ""
 echo "┌────────────────────────────────────────────────────────────┐"
-echo "│ [6/6] Async Mode - Multi-Thread (100k logs, 8 threads)    │"
+echo "│ [6/8] Async Mode - Multi-Thread (100k logs, 8 threads)    │"
 echo "└────────────────────────────────────────────────────────────┘"
 $PERF_TEST -t spdlog-file -f "$LOG_FILE" -n 100000 -j 8 -a
 
+# ========== 异步轮转测试 ==========
+echo ""
+echo "┌────────────────────────────────────────────────────────────┐"
+echo "│              ASYNC ROTATING FILE TESTS                     │"
+echo "└────────────────────────────────────────────────────────────┘"
+echo ""
+
+# 异步轮转 - 单线程，1MB 轮转一次，约每 1 万条触发一次轮转
+echo ""
+echo "┌────────────────────────────────────────────────────────────┐"
+echo "│ [7/8] Async Rotating - Single Thread (100k logs, 1MB x 5) │"
+echo "└────────────────────────────────────────────────────────────┘"
+$PERF_TEST -t spdlog-rotating -f "$ROTATING_LOG_FILE" -n 100000 -s 1048576 -r 5 -a
+
+# 异步轮转 - 8线程
+echo ""
+echo "┌────────────────────────────────────────────────────────────┐"
+echo "│ [8/8] Async Rotating - Multi-Thread (100k logs, 8 threads)│"
+echo "└────────────────────────────────────────────────────────────┘"
+$PERF_TEST -t spdlog-rotating -f "$ROTATING_LOG_FILE" -n 100000 -j 8 -s 1048576 -r 5 -a
+
 echo ""
 echo "=========================================="
 echo "   spdlog Test Suite Completed!"
@@ -20,9 +20,16 @@
 #include <sys/stat.h>
 #include <unistd.h>
 #include <cstdio>
+#include <stdexcept>
 
 #include <slog/slog.hpp>
 #include <slog/sink_file.hpp>
+#include <slog/sink_stdout.hpp>
+#include <slog/sink_json_file.hpp>
+#include <slog/sink_router.hpp>
+#include <slog/sink_isolated.hpp>
+
+#include "test_util.hpp"
 
 // Test basic logger creation and logging
 void test_basic_logging() {
@@ -175,6 +182,12 @@ void test_log_level_utilities() {
     std::cout << "  \"W\" -> " << slog::log_level_name(level4) << std::endl;
     std::cout << "  \"error\" -> " << slog::log_level_name(level5) << std::endl;
     std::cout << "  \"invalid\" (default Info) -> " << slog::log_level_name(level6) << std::endl;
+
+    // 日志输出中的 "WARN" 和关闭日志的 "off"
+    if (slog::log_level_from_name("WARN") != slog::LogLevel::Warning
+        || slog::log_level_from_name("Off") != slog::LogLevel::Off) {
+        throw std::runtime_error("log_level_from_name does not accept WARN/off");
+    }
 }
 
 // Test dynamic level change
@@ -725,9 +738,432 @@ void test_global_logger_level_rules() {
     std::cout << "Should remain Info (empty pattern ignored):" << std::endl;
     logger10->debug("Debug message (should not appear)");
     logger10->info("Info message (should appear)");
+
+    // Test 11: Re-issue a wildcard rule with a new level
+    std::cout << "\nTest 11: Re-issue a wildcard rule with a new level:" << std::endl;
+    auto logger11 = slog::make_stdout_logger("reissue_net", slog::LogLevel::Info);
+    slog::set_logger_level("reissue_*", slog::LogLevel::Warning);
+    std::cout << "After reissue_*=Warning: " << slog::log_level_name(logger11->get_level()) << std::endl;
+    slog::set_logger_level("reissue_*", slog::LogLevel::Debug);
+    auto logger11b = slog::make_stdout_logger("reissue_db", slog::LogLevel::Info);
+    std::cout << "After reissue_*=Debug: existing " << slog::log_level_name(logger11->get_level())
+              << ", new " << slog::log_level_name(logger11b->get_level()) << std::endl;
+    if (logger11->get_level() != slog::LogLevel::Debug || logger11b->get_level() != slog::LogLevel::Debug
+        || slog::get_logger_rules()["reissue_*"] != slog::LogLevel::Debug) {
+        throw std::runtime_error("re-issued wildcard rule did not replace the previous level");
+    }
+
+    // Test 12: A narrower rule set after a broader one applies to the loggers it matches
+    std::cout << "\nTest 12: Narrower rule after a broader one:" << std::endl;
+    auto logger12 = slog::make_stdout_logger("narrow_a1", slog::LogLevel::Info);
+    auto logger12b = slog::make_stdout_logger("narrow_b1", slog::LogLevel::Info);
+    slog::set_logger_level("narrow_*", slog::LogLevel::Warning);
+    slog::set_logger_level("narrow_a*", slog::LogLevel::Debug);
+    std::cout << "After narrow_a*=Debug: " << slog::log_level_name(logger12->get_level()) << ", "
+              << slog::log_level_name(logger12b->get_level()) << std::endl;
+    if (logger12->get_level() != slog::LogLevel::Debug || logger12b->get_level() != slog::LogLevel::Warning) {
+        throw std::runtime_error("narrower wildcard rule did not override the broader one");
+    }
+    slog::apply_logger_rules("narrow_.*1:trace");
+    std::cout << "After narrow_.*1=Trace: " << slog::log_level_name(logger12->get_level()) << ", "
+              << slog::log_level_name(logger12b->get_level()) << std::endl;
+    if (logger12->get_level() != slog::LogLevel::Trace || logger12b->get_level() != slog::LogLevel::Trace) {
+        throw std::runtime_error("newest regex rule did not apply to the loggers it matches");
+    }
+}
+
+
+// 格式化时会再次打印日志的类型，用于验证消息缓冲区的重入
+struct Reentrant { int value; };
+
+template<>
+struct fmt::formatter<Reentrant> : fmt::formatter<int> {
+    template<typename FormatContext>
+    auto format(Reentrant const & r, FormatContext & ctx) const -> decltype(ctx.out()) {
+        slog::get_logger("payload_inner")->info("inner log while formatting outer message");
+        return fmt::formatter<int>::format(r.value, ctx);
+    }
+};
+
+void test_payload_buffer() {
+    std::cout << "\n=== Test 17: Payload Buffer ===" << std::endl;
+
+    slog::AsyncOptions options = slog::get_async_options();
+    options.payload_reserve = 512;
+    options.payload_retain_max = 4096;
+    slog::set_async_options(options);
+
+    auto logger = slog::make_stdout_logger("payload_test", slog::LogLevel::Info);
+    logger->info("Short message {}", 1);
+    logger->debug("Filtered message is not formatted {}", 2);
+
+    // 超过 payload_reserve、不超过 payload_retain_max 的消息结束后，增长的容量保留给下一条
+    logger->info("Long message: {}", std::string(2048, 'x'));
+    std::string *long_buf = slog::detail::acquire_payload_buffer();
+    size_t long_capacity = long_buf ? long_buf->capacity() : 0;
+    slog::detail::release_payload_buffer(long_buf);
+    std::cout << "Buffer capacity after long message: " << long_capacity << " (expected 2048..4096)" << std::endl;
+    if (long_buf == nullptr || long_capacity < 2048 || long_capacity > options.payload_retain_max) {
+        throw std::runtime_error("payload buffer growth not retained after long message");
+    }
+
+    // 超过 payload_retain_max 的消息结束后，缓冲区容量归还，下次取用时回到 payload_reserve
+    const std::string big_file = "/tmp/test_payload_buffer.log";
+    std::remove(big_file.c_str());
+    auto big_logger = slog::make_file_logger("payload_big", big_file, slog::LogLevel::Info);
+    big_logger->info("Big message: {}", std::string(16384, 'x'));
+    std::string *buf = slog::detail::acquire_payload_buffer();
+    size_t capacity = buf ? buf->capacity() : 0;
+    slog::detail::release_payload_buffer(buf);
+    std::cout << "Buffer capacity after big message: " << capacity << " (expected <= 4096)" << std::endl;
+    if (buf == nullptr || capacity > options.payload_retain_max) {
+        throw std::runtime_error("payload buffer not released after big message");
+    }
+
+    // 外层消息格式化期间内层再次打印，内层应先输出，外层消息保持完整
+    logger->info("Outer message with nested value {}", Reentrant{42});
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&logger, t]() {
+            for (int i = 0; i < 3; ++i) {
+                logger->info("Thread {} payload message {}", t, i);
+            }
+        });
+    }
+    for (auto & th : threads) {
+        th.join();
+    }
+
+    slog::AsyncOptions applied = slog::get_async_options();
+    if (applied.payload_reserve != 512 || applied.payload_retain_max != 4096) {
+        throw std::runtime_error("payload options not applied");
+    }
+    std::string big = slog_test::read_file(big_file);
+    if (big.find("Big message: " + std::string(16384, 'x')) == std::string::npos) {
+        throw std::runtime_error("big message not written in full");
+    }
+}
+
+void test_sink_plan() {
+    std::cout << "\n=== Test 18: Sink Plan Dispatch ===" << std::endl;
+
+    const std::string plan_file = "/tmp/test_sink_plan.log";
+    std::remove(plan_file.c_str());
+
+    // stdout 为 Debug，文件为 Warning：Debug/Info 只到 stdout，Warning 以上两者都有
+    std::vector<std::shared_ptr<slog::LoggerSink>> sinks;
+    sinks.push_back(std::make_shared<slog::sink::Stdout>(slog::LogLevel::Debug));
+    sinks.push_back(std::make_shared<slog::sink::File>(slog::LogLevel::Warning, plan_file, 0, 1, true));
+    auto logger = slog::make_logger("sink_plan", sinks);
+
+    logger->debug("Debug message (stdout only)");
+    logger->info("Info message (stdout only)");
+    logger->warning("Warning message (stdout and file)");
+
+    // 修改等级后分发表随之更新
+    logger->set_level(slog::LogLevel::Info);
+    logger->debug("Debug message (should not appear)");
+    logger->info("Info message after set_level (stdout and file)");
+
+    // 直接修改 sink 等级时分发表仍使用缓存的等级，refresh_levels() 之后才生效
+    logger->sinks()[1]->set_level(slog::LogLevel::Error);
+    logger->warning("Warning message before refresh_levels (stdout and file)");
+    logger->refresh_levels();
+    logger->warning("Warning message after refresh_levels (stdout only)");
+    logger->error("Error message after refresh_levels (stdout and file)");
+
+    std::ifstream file(plan_file);
+    std::string line;
+    int count = 0;
+    while (std::getline(file, line)) {
+        count++;
+    }
+    std::cout << "File lines: " << count << " (expected 4)" << std::endl;
+    if (count != 4) {
+        throw std::runtime_error("sink plan did not follow the sink levels");
+    }
+}
+
+void test_source_site() {
+    std::cout << "\n=== Test 19: Source Site Flags ===" << std::endl;
+
+    const std::string site_file = "/tmp/test_source_site.log";
+    std::remove(site_file.c_str());
+
+    auto previous = slog::default_logger();
+    auto logger = slog::make_file_logger("source_site", site_file, slog::LogLevel::Info);
+    slog::set_default_logger("source_site");
+
+    // 同一个调用点在等级变化前后分别被关闭/打开
+    for (int i = 0; i < 2; i++) {
+        SLOG_DEBUG("Site debug message {}", i);
+        SLOG_INFO("Site info message {}", i);
+        logger->set_level(slog::LogLevel::Debug);
+    }
+
+    // 调用点级别的日志抑制，不需要 tag
+    for (int i = 0; i < 5; i++) {
+        SLOG_WARNING_LIMITED(2, "Site limited message {}", i);
+    }
+
+    slog::set_default_logger(previous->name());
+
+    std::ifstream file(site_file);
+    std::string line;
+    int count = 0;
+    while (std::getline(file, line)) {
+        count++;
+    }
+    // info x2 + debug x1 + limited x2
+    std::cout << "File lines: " << count << " (expected 5)" << std::endl;
+    if (count != 5) {
+        throw std::runtime_error("source site flags not refreshed");
+    }
+}
+
+struct CountedValue {
+    int value;
+};
+
+static int s_counted_formats = 0;
+
+template<>
+struct fmt::formatter<CountedValue> : fmt::formatter<int> {
+    template<typename FormatContext>
+    auto format(CountedValue const& v, FormatContext& ctx) const -> decltype(ctx.out()) {
+        s_counted_formats++;
+        return fmt::formatter<int>::format(v.value, ctx);
+    }
+};
+
+void test_structured_fields() {
+    std::cout << "\n=== Test 20: Structured Fields ===" << std::endl;
+
+    const std::string kv_file = "/tmp/test_structured_fields.log";
+    std::remove(kv_file.c_str());
+
+    std::vector<std::shared_ptr<slog::LoggerSink>> sinks;
+    sinks.push_back(std::make_shared<slog::sink::Stdout>(slog::LogLevel::Debug));
+    sinks.push_back(std::make_shared<slog::sink::File>(slog::LogLevel::Warning, kv_file, 0, 1, true));
+    auto logger = slog::make_logger("structured", sinks);
+
+    std::string path = "/api/v1/users";
+    logger->info("request done", slog::kv("latency_us", 1234), slog::kv("path", path),
+                 slog::kv("ok", true), slog::kv("ratio", 0.5));
+    logger->warning("slow request", slog::kv("latency_us", 98765u), slog::kv("note", "has space"),
+                    slog::kv("value", CountedValue{7}));
+
+    // 等级不允许时字段不做序列化
+    int before = s_counted_formats;
+    logger->trace("filtered", slog::kv("value", CountedValue{8}));
+    std::cout << "Filtered field formats: " << (s_counted_formats - before) << " (expected 0)" << std::endl;
+    if (s_counted_formats != before) {
+        throw std::runtime_error("filtered structured field was serialized");
+    }
+
+    // 格式化接口不受影响
+    logger->info("formatted {}", 42);
+
+    std::ifstream file(kv_file);
+    std::string line;
+    std::getline(file, line);
+    std::cout << "File line: " << line << std::endl;
+    if (line.find("slow request latency_us=98765 note=\"has space\" value=7") == std::string::npos) {
+        throw std::runtime_error("unexpected structured field encoding");
+    }
+}
+
+void test_json_file_sink() {
+    std::cout << "\n=== Test 21: JSON File Sink ===" << std::endl;
+
+    const std::string json_file = "/tmp/test_json_file_sink.log";
+    std::remove(json_file.c_str());
+
+    auto logger = slog::make_json_file_logger("json_test", json_file, slog::LogLevel::Debug, 0, 1, true);
+    logger->info("plain message {}", 1);
+    // 超过 16 字节的消息，转义字符分布在 SIMD 块内和尾部
+    logger->warning("quote \" backslash \\ newline \n tab \t control \x01 tail \"");
+    logger->info("request done", slog::kv("latency_us", 1234), slog::kv("path", "/a\"b"),
+                 slog::kv("ok", false), slog::kv("ratio", 0.25));
+
+    std::ifstream file(json_file);
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(file, line)) {
+        std::cout << line << std::endl;
+        lines.push_back(line);
+    }
+    if (lines.size() != 3) {
+        throw std::runtime_error("unexpected JSON line count");
+    }
+    if (lines[0].compare(0, 7, "{\"ts\":\"") != 0 || lines[0][17] != 'T'
+        || lines[0].find("\"level\":\"INFO\",\"logger\":\"json_test\",\"thread\":") == std::string::npos
+        || lines[0].find(",\"msg\":\"plain message 1\"}") == std::string::npos) {
+        throw std::runtime_error("unexpected JSON record layout");
+    }
+    if (lines[1].find("\"msg\":\"quote \\\" backslash \\\\ newline \\n tab \\t control \\u0001 tail \\\"\"}")
+        == std::string::npos) {
+        throw std::runtime_error("unexpected JSON string escaping");
+    }
+    if (lines[2].find(",\"fields\":{\"latency_us\":1234,\"path\":\"/a\\\"b\",\"ok\":false,\"ratio\":0.25}}")
+        == std::string::npos) {
+        throw std::runtime_error("unexpected JSON fields");
+    }
+}
+
+void test_router_sink() {
+    std::cout << "\n=== Test 22: Router Sink ===" << std::endl;
+
+    const std::string alert_file = "/tmp/test_router_alert.log";
+    const std::string main_file = "/tmp/test_router_main.log";
+    const std::string net_file = "/tmp/test_router_net.log";
+    std::remove(alert_file.c_str());
+    std::remove(main_file.c_str());
+    std::remove(net_file.c_str());
+
+    auto router = std::make_shared<slog::sink::Router>(slog::LogLevel::Debug);
+    router->add_route(std::make_shared<slog::sink::File>(slog::LogLevel::Trace, alert_file, 0, 1, true),
+                      slog::LogLevel::Error);
+    // 子 sink 自身为 Info，路由等级为 Trace，合并后为 Info
+    router->add_route(std::make_shared<slog::sink::File>(slog::LogLevel::Info, main_file, 0, 1, true));
+    router->add_route(std::make_shared<slog::sink::File>(slog::LogLevel::Trace, net_file, 0, 1, true),
+                      slog::LogLevel::Trace, "net_*");
+
+    auto app = slog::make_logger("router_app", router);
+    auto net = app->clone("net_io");
+
+    app->debug("app debug (nowhere)");
+    app->info("app info (main)");
+    app->error("app error (alert, main)");
+    net->debug("net debug (net)");
+    net->warning("net warning (main, net)", slog::kv("peer", "10.0.0.1"));
+
+    // 路由表：Debug 没有路由，Error 为 alert|main
+    if (router->route_mask(slog::LogLevel::Debug) != 0 || router->route_mask(slog::LogLevel::Error) != 0x3) {
+        throw std::runtime_error("unexpected router table");
+    }
+
+    auto count_lines = [](std::string const & path) {
+        std::ifstream file(path);
+        std::string line;
+        int count = 0;
+        while (std::getline(file, line)) {
+            count++;
+        }
+        return count;
+    };
+    int alert_lines = count_lines(alert_file);
+    int main_lines = count_lines(main_file);
+    int net_lines = count_lines(net_file);
+    std::cout << "alert: " << alert_lines << " (expected 1), main: " << main_lines
+              << " (expected 3), net: " << net_lines << " (expected 2)" << std::endl;
+    if (alert_lines != 1 || main_lines != 3 || net_lines != 2) {
+        throw std::runtime_error("router dispatched to wrong sinks");
+    }
+
+    // clone() 传入临时名称，之后的规则变化和 rebuild() 仍按驻留名称计算路由表
+    auto cloned = app->clone(std::string("net_rpc"));
+    auto cloned_router = std::dynamic_pointer_cast<slog::sink::Router>(cloned->sinks().front());
+    slog::set_logger_level("net_rpc", slog::LogLevel::Warning);
+    cloned_router->rebuild();
+    cloned->warning("net rpc warning (main, net)");
+    // 克隆的 main 子 sink 为 Info，net 子 sink 为 Trace
+    if (cloned_router->route_mask(slog::LogLevel::Debug) != 0x4
+        || cloned_router->route_mask(slog::LogLevel::Error) != 0x7) {
+        throw std::runtime_error("unexpected router table after clone");
+    }
+    if (count_lines(main_file) != 4 || count_lines(net_file) != 3) {
+        throw std::runtime_error("cloned router dispatched to wrong sinks");
+    }
 }
 
+/// 每条日志耗时 10ms 的 sink，模拟阻塞的 NFS 文件或管道
+class SlowSink : public slog::LoggerSink {
+public:
+    SlowSink() : slog::LoggerSink(slog::LogLevel::Trace) {}
+
+    std::shared_ptr<slog::LoggerSink> clone(const std::string &) const override {
+        return std::make_shared<SlowSink>();
+    }
+
+    const char* name() const override { return "Slow"; }
+
+    std::vector<std::string> lines;
+
+protected:
+    void output(const std::string &, slog::LogLevel, std::string const &msg) override {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        lines.push_back(msg);
+    }
+};
+
+void test_isolated_sink() {
+    std::cout << "\n=== Test 23: Isolated Sink ===" << std::endl;
 
+    const std::string fast_file = "/tmp/test_isolated_fast.log";
+    std::remove(fast_file.c_str());
+
+    auto slow = std::make_shared<SlowSink>();
+    auto isolated = std::make_shared<slog::sink::Isolated>(slow, 8);
+    std::vector<std::shared_ptr<slog::LoggerSink>> sinks;
+    sinks.push_back(std::make_shared<slog::sink::File>(slog::LogLevel::Info, fast_file, 0, 1, true));
+    sinks.push_back(isolated);
+    auto logger = slog::make_logger("isolated_test", sinks);
+
+    const int total = 50;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < total; i++) {
+        logger->info("isolated message {}", i);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    // 结构化字段在队列中保存副本，调用返回后原数据可以失效
+    isolated->flush(std::chrono::milliseconds(2000));
+    {
+        std::string peer = "10.0.0.1";
+        logger->warning("with fields", slog::kv("peer", peer), slog::kv("port", 8080));
+    }
+
+    isolated->flush(std::chrono::milliseconds(2000));
+    slog::sink::IsolatedStats stats = isolated->stats();
+    std::cout << "elapsed: " << elapsed.count() << "ms, enqueued: " << stats.enqueued
+              << ", processed: " << stats.processed << ", dropped: " << stats.dropped
+              << ", max lag: " << stats.max_lag_us << "us" << std::endl;
+
+    std::ifstream file(fast_file);
+    std::string line;
+    int count = 0;
+    while (std::getline(file, line)) {
+        count++;
+    }
+    // 同步调用需要 500ms 以上；隔离后调用线程不等待慢 sink
+    if (count != total + 1 || elapsed.count() >= 250) {
+        throw std::runtime_error("fast sink stalled by slow sink");
+    }
+    if (stats.dropped == 0 || stats.processed + stats.dropped != static_cast<uint64_t>(total + 1)
+        || stats.processed != slow->lines.size() || stats.max_lag_us == 0) {
+        throw std::runtime_error("unexpected isolated sink metrics");
+    }
+    if (slow->lines.back() != "with fields peer=10.0.0.1 port=8080") {
+        throw std::runtime_error("fields not copied into isolated queue: " + slow->lines.back());
+    }
+
+    // 克隆和清除规则时 Isolated 只清除子 sink 的规则等级，子 sink 保持自身等级继续接收
+    auto cloned = logger->clone(std::string("isolated_clone"));
+    auto cloned_isolated = std::dynamic_pointer_cast<slog::sink::Isolated>(cloned->sinks().back());
+    cloned->info("cloned info");
+    slog::set_logger_level("isolated_clone", slog::LogLevel::Warning);
+    cloned->info("cloned info under rule (filtered)");
+    cloned->warning("cloned warning under rule");
+    slog::set_logger_level_rules({}, true);
+    cloned->info("cloned info after rule cleared");
+    cloned_isolated->flush(std::chrono::milliseconds(2000));
+    uint64_t cloned_processed = cloned_isolated->stats().processed;
+    std::cout << "cloned processed: " << cloned_processed << " (expected 3)" << std::endl;
+    if (cloned_processed != 3) {
+        throw std::runtime_error("cloned isolated sink lost its child level");
+    }
+}
 
 int main() {
     std::cout << "========================================" << std::endl;
@@ -752,6 +1188,13 @@ int main() {
         test_log_limiting();
         test_file_sink();
         test_global_logger_level_rules();
+        test_payload_buffer();
+        test_sink_plan();
+        test_source_site();
+        test_structured_fields();
+        test_json_file_sink();
+        test_router_sink();
+        test_isolated_sink();
         
         std::cout << "\n========================================" << std::endl;
         std::cout << "  All Tests Completed Successfully!" << std::endl;
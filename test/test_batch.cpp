@@ -0,0 +1,184 @@
+/**
+ * @file test_batch.cpp
+ * @brief 测试批量输出：每个 sink 按自己的等级过滤、保留顺序和添加时的时间戳、按行轮转、JSON 及默认逐条实现
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <slog/slog.hpp>
+#include <slog/sink_file.hpp>
+#include <slog/sink_json_file.hpp>
+
+#include "test_util.hpp"
+
+namespace {
+
+using slog_test::expect;
+using slog_test::read_lines;
+
+size_t file_size(std::string const & path)
+{
+    struct stat st;
+    return stat(path.c_str(), &st) == 0 ? static_cast<size_t>(st.st_size) : 0;
+}
+
+void remove_files(std::string const & path)
+{
+    for (const char *suffix : {"", ".1", ".2", ".3", ".4", ".5"}) {
+        std::remove((path + suffix).c_str());
+    }
+}
+
+/// 逐条输出的 sink，记录 output() 的调用，检查默认的 output_batch()
+class Collect : public slog::LoggerSink
+{
+public:
+    explicit Collect(slog::LogLevel level) : LoggerSink(level) {}
+
+    std::shared_ptr<slog::LoggerSink> clone(const std::string &) const override { return nullptr; }
+    const char *name() const override { return "Collect"; }
+
+    std::vector<std::string> lines;
+
+protected:
+    void output(const std::string & logger_name, slog::LogLevel level, std::string const & msg) override
+    {
+        slog::detail::LineBuffer line;
+        slog::detail::append_timestamp(line, slog::detail::current_timestamp());
+        lines.push_back(std::string(line.data(), line.size()) + " " + logger_name + " " +
+                        slog::log_level_name(level) + " " + msg);
+    }
+};
+
+} // namespace
+
+void test_levels_and_order(std::string const & path)
+{
+    std::cout << "=== Test: per-sink level filter, order and timestamps ===" << std::endl;
+    std::string error_path = path + ".error";
+    remove_files(path);
+    std::remove(error_path.c_str());
+
+    auto collect = std::make_shared<Collect>(slog::LogLevel::Warning);
+    auto logger = slog::make_logger("batch", std::vector<std::shared_ptr<slog::LoggerSink>>{
+        std::make_shared<slog::sink::File>(slog::LogLevel::Info, path, 0, 1),
+        std::make_shared<slog::sink::File>(slog::LogLevel::Error, error_path, 0, 1),
+        collect});
+
+    slog::Batch batch;
+    batch.add(slog::LogLevel::Debug, "hidden {}", 0);
+    batch.add(slog::LogLevel::Info, "row {}", 1);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    batch.add(slog::LogLevel::Warning, "row {}", 2);
+    batch.add(slog::LogLevel::Error, "row {}", 3);
+    expect(batch.size() == 4 && batch.max_level() == slog::LogLevel::Error, "batch bookkeeping");
+    logger->log_batch(batch);
+
+    auto lines = read_lines(path);
+    for (auto const & line : lines) {
+        std::cout << line << std::endl;
+    }
+    expect(lines.size() == 3, "info sink gets three rows");
+    expect(lines[0].find("<INFO> (batch) row 1") != std::string::npos, "first row");
+    expect(lines[2].find("<ERROR> (batch) row 3") != std::string::npos, "last row");
+    expect(lines[0].substr(0, 23) != lines[1].substr(0, 23), "each row keeps the time it was added");
+
+    auto errors = read_lines(error_path);
+    expect(errors.size() == 1 && errors[0].find("row 3") != std::string::npos, "error sink gets one row");
+
+    expect(collect->lines.size() == 2, "default output_batch filters by level");
+    expect(collect->lines[0].substr(0, 23) == lines[1].substr(0, 23), "default output_batch uses the record time");
+    expect(collect->lines[1].find(" batch ERROR row 3") != std::string::npos, "default output_batch passes name and level");
+
+    // 清空后复用，批量中没有允许的等级时什么也不输出
+    batch.clear();
+    batch.add(slog::LogLevel::Debug, "still hidden");
+    logger->log_batch(batch);
+    expect(read_lines(path).size() == 3, "nothing written for a filtered batch");
+
+    slog::drop_logger("batch");
+    remove_files(path);
+    std::remove(error_path.c_str());
+}
+
+void test_rotation(std::string const & path)
+{
+    std::cout << "=== Test: batch split at line ends on rotation ===" << std::endl;
+    remove_files(path);
+    constexpr size_t kMaxSize = 4096;
+    auto logger = slog::make_logger("batch_rotate", std::make_shared<slog::sink::File>(slog::LogLevel::Info, path, kMaxSize, 5));
+
+    slog::Batch batch;
+    for (int i = 0; i < 150; ++i) {
+        batch.add(slog::LogLevel::Info, "rotating batch row {:04d} with padding", i);
+    }
+    logger->log_batch(batch);
+    slog::drop_logger("batch_rotate");
+
+    // 从最旧的文件读起，行号连续且每个文件不超过上限
+    std::vector<std::string> all;
+    for (const char *suffix : {".3", ".2", ".1", ""}) {
+        std::string file = path + suffix;
+        size_t size = file_size(file);
+        expect(size > 0 && size <= kMaxSize, "rotated file within the size limit: " + file);
+        for (auto const & line : read_lines(file)) {
+            all.push_back(line);
+        }
+    }
+    expect(file_size(path + ".4") == 0, "only as many files as needed");
+    expect(all.size() == 150, "all rows written: " + std::to_string(all.size()));
+    for (int i = 0; i < 150; ++i) {
+        char row[16];
+        std::snprintf(row, sizeof(row), "row %04d ", i);
+        expect(all[static_cast<size_t>(i)].find(row) != std::string::npos, std::string("rows in order: ") + row);
+    }
+    remove_files(path);
+}
+
+void test_json(std::string const & path)
+{
+    std::cout << "=== Test: json batch ===" << std::endl;
+    remove_files(path);
+    auto logger = slog::make_logger("batch_json", std::make_shared<slog::sink::JsonFile>(slog::LogLevel::Info, path, 0, 1));
+
+    slog::Batch batch;
+    batch.add(slog::LogLevel::Info, "quoted \"{}\"", "value");
+    batch.add(slog::LogLevel::Warning, "second");
+    logger->log_batch(batch);
+    slog::drop_logger("batch_json");
+
+    auto lines = read_lines(path);
+    for (auto const & line : lines) {
+        std::cout << line << std::endl;
+    }
+    expect(lines.size() == 2, "two json records");
+    expect(lines[0].compare(0, 7, "{\"ts\":\"") == 0 && lines[0].back() == '}', "json object");
+    expect(lines[0].find("\"msg\":\"quoted \\\"value\\\"\"}") != std::string::npos, "escaped message");
+    expect(lines[1].find("\"level\":\"WARN\"") != std::string::npos, "level kept");
+    remove_files(path);
+}
+
+int main()
+{
+    std::string path = "/tmp/slog_test_batch_" + std::to_string(getpid()) + ".log";
+    try {
+        test_levels_and_order(path);
+        test_rotation(path);
+        test_json(path);
+    } catch (std::exception const & e) {
+        std::cerr << "Test failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "All batch tests passed" << std::endl;
+    return 0;
+}
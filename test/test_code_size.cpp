@@ -0,0 +1,131 @@
+/**
+ * @file test_code_size.cpp
+ * @brief 调用点代码体积测试：584 个参数类型组合各不相同的调用点
+ *
+ * 8 种参数类型的 1/2/3 参数全部组合（8 + 64 + 512 = 584），每个组合一个不内联的调用点函数。
+ * 定义 SLOG_CODE_SIZE_INLINE 时调用点按 vlog() 之前的方式展开（每个调用点实例化 fmt::format_to 并直接分发），
+ * 两个版本的代码段大小之差即类型擦除路径节省的体积，见 run_code_size.sh。
+ * 运行时对 None sink 循环调用全部调用点，输出每次调用的耗时。
+ */
+
+#include <chrono>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include <slog/slog.hpp>
+#include <slog/sink_none.hpp>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SLOG_CODE_SIZE_NOINLINE __attribute__((noinline))
+#else
+#define SLOG_CODE_SIZE_NOINLINE
+#endif
+
+namespace {
+
+using Types = std::tuple<int, unsigned, long long, unsigned long long, double, bool, const char *, std::string>;
+constexpr size_t kTypeCount = std::tuple_size<Types>::value;
+
+template<size_t I>
+using TypeAt = typename std::tuple_element<I, Types>::type;
+
+template<typename T> T sample() { return T(7); }
+template<> bool sample<bool>() { return true; }
+template<> const char *sample<const char *>() { return "text"; }
+template<> std::string sample<std::string>() { return std::string("string value"); }
+
+#if defined(SLOG_CODE_SIZE_INLINE)
+/// vlog() 之前 Logger::log<Args...> 的展开
+template<typename... Args>
+inline void log_site(slog::Logger & logger, fmt::format_string<Args...> fmt, Args const &... args)
+{
+    if (!logger.is_allowed(slog::LogLevel::Info)) {
+        return;
+    }
+    slog::detail::PayloadBuffer payload;
+    fmt::format_to(std::back_inserter(payload.str()), fmt, args...);
+    logger.log(slog::LogLevel::Info, payload.str());
+}
+#else
+template<typename... Args>
+inline void log_site(slog::Logger & logger, fmt::format_string<Args const &...> fmt, Args const &... args)
+{
+    logger.info(fmt, args...);
+}
+#endif
+
+template<typename A>
+SLOG_CODE_SIZE_NOINLINE void site(slog::Logger & logger, A const & a)
+{
+    log_site(logger, "site {}", a);
+}
+
+template<typename A, typename B>
+SLOG_CODE_SIZE_NOINLINE void site(slog::Logger & logger, A const & a, B const & b)
+{
+    log_site(logger, "site {} {}", a, b);
+}
+
+template<typename A, typename B, typename C>
+SLOG_CODE_SIZE_NOINLINE void site(slog::Logger & logger, A const & a, B const & b, C const & c)
+{
+    log_site(logger, "site {} {} {}", a, b, c);
+}
+
+template<size_t... I>
+void run_one_arg(slog::Logger & logger, std::index_sequence<I...>)
+{
+    int expand[] = {(site(logger, sample<TypeAt<I>>()), 0)...};
+    (void)expand;
+}
+
+template<size_t... I>
+void run_two_args(slog::Logger & logger, std::index_sequence<I...>)
+{
+    int expand[] = {(site(logger, sample<TypeAt<I / kTypeCount>>(), sample<TypeAt<I % kTypeCount>>()), 0)...};
+    (void)expand;
+}
+
+template<size_t... I>
+void run_three_args(slog::Logger & logger, std::index_sequence<I...>)
+{
+    int expand[] = {(site(logger, sample<TypeAt<I / (kTypeCount * kTypeCount)>>(),
+                          sample<TypeAt<(I / kTypeCount) % kTypeCount>>(), sample<TypeAt<I % kTypeCount>>()), 0)...};
+    (void)expand;
+}
+
+void run_all(slog::Logger & logger)
+{
+    run_one_arg(logger, std::make_index_sequence<kTypeCount>());
+    run_two_args(logger, std::make_index_sequence<kTypeCount * kTypeCount>());
+    run_three_args(logger, std::make_index_sequence<kTypeCount * kTypeCount * kTypeCount>());
+}
+
+} // namespace
+
+int main()
+{
+    constexpr size_t kSites = kTypeCount + kTypeCount * kTypeCount + kTypeCount * kTypeCount * kTypeCount;
+    constexpr int kRounds = 200;
+
+    slog::Logger logger("code_size", std::make_shared<slog::sink::None>(slog::LogLevel::Trace));
+    run_all(logger);
+
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kRounds; ++i) {
+        run_all(logger);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+
+#if defined(SLOG_CODE_SIZE_INLINE)
+    const char *mode = "inline format_to";
+#else
+    const char *mode = "vlog";
+#endif
+    std::cout << mode << ": " << kSites << " call sites, "
+              << elapsed.count() / static_cast<int64_t>(kSites * kRounds) << " ns/call" << std::endl;
+    return 0;
+}
@@ -0,0 +1,126 @@
+/**
+ * @file test_compiled_format.cpp
+ * @brief 测试 SLOG_COMPILED_FORMAT：宏输出与 FMT_STRING 路径一致、结构化字段和等级过滤不变，
+ *        并比较整数/字符串为主的消息在两种路径下的格式化耗时
+ *
+ * 本文件以 C++17 和 SLOG_COMPILED_FORMAT=1 编译；使用内置 fmt 时宏退回 FMT_STRING，测试同样应通过。
+ */
+
+#define SLOG_COMPILED_FORMAT 1
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+#include <slog/slog.hpp>
+#include <slog/sink_file.hpp>
+#include <slog/sink_none.hpp>
+
+#include "test_util.hpp"
+
+namespace {
+
+using slog_test::expect;
+using slog_test::read_lines;
+
+/// 消息部分（去掉时间戳、等级和 logger 名称）
+std::string message_of(std::string const & line)
+{
+    size_t pos = line.find(") ");
+    return pos == std::string::npos ? line : line.substr(pos + 2);
+}
+
+} // namespace
+
+void test_output(std::string const & path)
+{
+    std::cout << "=== Test: macro output (compiled format: " << SLOG_HAS_COMPILED_FORMAT << ") ===" << std::endl;
+    std::remove(path.c_str());
+    auto logger = slog::make_logger("compiled", std::make_shared<slog::sink::File>(slog::LogLevel::Info, path, 0, 1));
+    auto previous = slog::default_logger()->name();
+    slog::set_default_logger("compiled");
+
+    std::string name = "alice";
+    SLOG_INFO("int {} str {} hex {:#x} float {:.2f}", 42, name, 255, 3.14159);
+    SLOG_INFO("single {}", "argument");
+    SLOG_WARNING("with fields", slog::kv("k", 1), slog::kv("who", name));
+    SLOG_DEBUG("filtered {}", 1);
+    LOCAL_INFO(logger, "local {} {}", name, -7);
+    LOCAL_DEBUG(logger, "local filtered {}", 1);
+    LOCAL_ERROR(logger, "local fields", slog::kv("code", 500));
+
+    slog::set_default_logger(previous);
+    slog::drop_logger("compiled");
+
+    auto lines = read_lines(path);
+    for (auto const & line : lines) {
+        std::cout << line << std::endl;
+    }
+    expect(lines.size() == 5, "five lines, debug filtered");
+    expect(message_of(lines[0]) == "int 42 str alice hex 0xff float 3.14", "formatted arguments");
+    expect(message_of(lines[1]) == "single argument", "string literal argument");
+    expect(message_of(lines[2]) == "with fields k=1 who=alice", "structured fields");
+    expect(message_of(lines[3]) == "local alice -7", "local logger");
+    expect(message_of(lines[4]) == "local fields code=500", "local logger fields");
+    std::remove(path.c_str());
+}
+
+/// 运行 n 次 body，返回每次的纳秒数
+template<typename Body>
+double time_ns(int n, Body body)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < n; ++i) {
+        body(i);
+    }
+    return std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() / n;
+}
+
+void bench()
+{
+    std::cout << "=== Benchmark: FMT_STRING vs macro path ===" << std::endl;
+    // None sink 丢弃输出，只测量格式化和分发
+    auto logger = std::make_shared<slog::Logger>("bench", std::make_shared<slog::sink::None>(slog::LogLevel::Info));
+    constexpr int kRounds = 1000000;
+    std::string user = "user_name";
+    std::string path = "/api/v1/items";
+    std::string method = "GET";
+
+    for (int pass = 0; pass < 2; ++pass) {
+        double int_runtime = time_ns(kRounds, [&](int i) {
+            logger->info(FMT_STRING("req {} status {} bytes {} us {} retries {}"), i, 200, i * 3, i % 977, i & 3);
+        });
+        double int_macro = time_ns(kRounds, [&](int i) {
+            LOCAL_INFO(logger, "req {} status {} bytes {} us {} retries {}", i, 200, i * 3, i % 977, i & 3);
+        });
+        double str_runtime = time_ns(kRounds, [&](int) {
+            logger->info(FMT_STRING("user {} {} {} from {}"), user, method, path, "10.0.0.1");
+        });
+        double str_macro = time_ns(kRounds, [&](int) {
+            LOCAL_INFO(logger, "user {} {} {} from {}", user, method, path, "10.0.0.1");
+        });
+        std::printf("  integers: FMT_STRING %.1f ns, macro %.1f ns\n", int_runtime, int_macro);
+        std::printf("  strings : FMT_STRING %.1f ns, macro %.1f ns\n", str_runtime, str_macro);
+    }
+}
+
+int main()
+{
+    std::string path = "/tmp/slog_test_compiled_format_" + std::to_string(getpid()) + ".log";
+    try {
+        test_output(path);
+        bench();
+    } catch (std::exception const & e) {
+        std::cerr << "Test failed: " << e.what() << std::endl;
+        std::remove(path.c_str());
+        return 1;
+    }
+
+    std::cout << "All compiled format tests passed" << std::endl;
+    return 0;
+}
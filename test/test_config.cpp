@@ -0,0 +1,325 @@
+/**
+ * @file test_config.cpp
+ * @brief 测试配置文件加载、批量规则发布和 inotify 热更新
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <stdexcept>
+#include <cstdio>
+#include <unistd.h>
+
+#include <slog/slog.hpp>
+#include <slog/config.hpp>
+#include <slog/sink_none.hpp>
+#include <slog/sink_isolated.hpp>
+
+#include "test_util.hpp"
+
+namespace {
+
+using slog_test::expect;
+using slog_test::read_file;
+
+std::string temp_path(std::string const & name)
+{
+    return "/tmp/slog_test_config_" + std::to_string(getpid()) + "_" + name;
+}
+
+void write_file(std::string const & path, std::string const & content)
+{
+    std::ofstream file(path, std::ios::trunc);
+    file << content;
+}
+
+} // namespace
+
+void test_load_sinks_and_rules()
+{
+    std::cout << "=== Test: load sinks, loggers and rules ===" << std::endl;
+    std::string log_path = temp_path("app.log");
+    std::remove(log_path.c_str());
+
+    std::string text =
+        "# application logging\n"
+        "[rules]\n"
+        "cfg_net_* = debug\n"
+        "^cfg_db_.* = trace    ; regex rule\n"
+        "\n"
+        "[sink.main]\n"
+        "type      = file\n"
+        "path      = " + log_path + "\n"
+        "level     = info\n"
+        "max_size  = 1M\n"
+        "max_files = 2\n"
+        "\n"
+        "[logger.cfg_app]\n"
+        "sinks = main\n"
+        "level = warning\n"
+        "\n"
+        "[logger.cfg_net_io]\n"
+        "sinks = main\n";
+    expect(slog::load_config_text(text), "config loaded");
+
+    auto app = slog::get_logger("cfg_app");
+    auto net = slog::get_logger("cfg_net_io");
+    expect(app && net, "declared loggers created");
+    expect(app->get_level() == slog::LogLevel::Warning, "logger level applied as rule");
+    expect(net->get_level() == slog::LogLevel::Debug, "wildcard rule applied");
+
+    // 之后创建的 logger 同样受规则控制
+    auto db = slog::make_stdout_logger("cfg_db_pool", slog::LogLevel::Error);
+    expect(db->get_level() == slog::LogLevel::Trace, "regex rule applied to new logger");
+
+    app->info("app info dropped");
+    app->warning("app warning kept");
+    net->debug("net debug kept");
+    std::string content = read_file(log_path);
+    expect(content.find("app info dropped") == std::string::npos, "below rule level filtered");
+    expect(content.find("app warning kept") != std::string::npos, "app record written");
+    expect(content.find("net debug kept") != std::string::npos, "net record written");
+
+    auto rules = slog::get_logger_rules();
+    expect(rules.size() == 3 && rules["cfg_app"] == slog::LogLevel::Warning, "rule table");
+
+    slog::drop_logger("cfg_app");
+    slog::drop_logger("cfg_net_io");
+    slog::drop_logger("cfg_db_pool");
+    std::remove(log_path.c_str());
+}
+
+void test_shared_sink_cloned_per_logger()
+{
+    std::cout << "=== Test: sink shared by loggers is cloned per logger ===" << std::endl;
+    std::string log_path = temp_path("shared.log");
+    std::remove(log_path.c_str());
+
+    std::string text =
+        "[sink.shared]\n"
+        "type     = file\n"
+        "path     = " + log_path + "\n"
+        "level    = info\n"
+        "isolated = true\n"
+        "\n"
+        "[logger.cfg_shared_a]\n"
+        "sinks = shared\n"
+        "\n"
+        "[logger.cfg_shared_b]\n"
+        "sinks = shared\n";
+    expect(slog::load_config_text(text), "config loaded");
+
+    auto a = slog::get_logger("cfg_shared_a");
+    auto b = slog::get_logger("cfg_shared_b");
+    expect(a->sinks().size() == 1 && b->sinks().size() == 1, "one sink per logger");
+    expect(a->sinks().front() != b->sinks().front(), "each logger has its own sink instance");
+
+    // 一个 logger 的等级不影响另一个
+    a->set_level(slog::LogLevel::Error);
+    expect(b->sinks().front()->get_level() == slog::LogLevel::Info, "sink level independent per logger");
+    a->set_level(slog::LogLevel::Info);
+
+    for (int i = 0; i < 10; i++) {
+        (i % 2 ? b : a)->info("shared record {}", i);
+    }
+    auto isolated_a = std::dynamic_pointer_cast<slog::sink::Isolated>(a->sinks().front());
+    auto isolated_b = std::dynamic_pointer_cast<slog::sink::Isolated>(b->sinks().front());
+    expect(isolated_a && isolated_a->flush(std::chrono::milliseconds(2000)), "queue a drained");
+    expect(isolated_b && isolated_b->flush(std::chrono::milliseconds(2000)), "queue b drained");
+    expect(isolated_a->stats().processed == 5 && isolated_b->stats().processed == 5, "one queue per logger");
+
+    // 两个克隆写入同一个文件
+    std::string content = read_file(log_path);
+    for (int i = 0; i < 10; i++) {
+        expect(content.find("shared record " + std::to_string(i)) != std::string::npos,
+               "record " + std::to_string(i) + " written");
+    }
+
+    slog::drop_logger("cfg_shared_a");
+    slog::drop_logger("cfg_shared_b");
+    std::remove(log_path.c_str());
+}
+
+void test_invalid_config_is_not_applied()
+{
+    std::cout << "=== Test: invalid config leaves state untouched ===" << std::endl;
+    slog::clear_logger_rules();
+    expect(slog::load_config_text("[rules]\ncfg_keep = error\n"), "baseline config");
+
+    std::vector<std::string> bad = {
+        "[rules]\ncfg_x = loud\n",
+        "[sink.s]\ntype = tape\n",
+        "[sink.s]\ntype = file\n",
+        "[sink.s]\ntype = stdout\ncolour = red\n",
+        "[logger.cfg_y]\nsinks = missing\n",
+        "[rules]\ncfg_z = info\n[sink.s\n",
+        "cfg_w = info\n",
+    };
+    for (auto const & text : bad) {
+        expect(!slog::load_config_text(text), "rejected: " + text);
+        auto rules = slog::get_logger_rules();
+        expect(rules.size() == 1 && rules.count("cfg_keep") == 1, "rules untouched after: " + text);
+    }
+    expect(!slog::load_config(temp_path("does_not_exist.conf")), "missing file rejected");
+    slog::clear_logger_rules();
+}
+
+void test_reload_restores_level()
+{
+    std::cout << "=== Test: reload replaces rules ===" << std::endl;
+    slog::clear_logger_rules();
+    auto logger = slog::make_stdout_logger("cfg_reload", slog::LogLevel::Info);
+
+    expect(slog::load_config_text("[rules]\ncfg_reload = trace\n"), "first load");
+    expect(logger->get_level() == slog::LogLevel::Trace, "rule applied");
+
+    expect(slog::load_config_text("[rules]\ncfg_re* = error\n"), "second load");
+    expect(logger->get_level() == slog::LogLevel::Error, "exact rule replaced by wildcard");
+
+    expect(slog::load_config_text("# no rules\n"), "empty config");
+    expect(logger->get_level() == slog::LogLevel::Info, "own level restored when rule removed");
+
+    slog::drop_logger("cfg_reload");
+}
+
+void test_bulk_reload_under_load()
+{
+    std::cout << "=== Test: 500-rule reload while logging ===" << std::endl;
+    slog::clear_logger_rules();
+
+    const int logger_count = 100;
+    std::vector<std::shared_ptr<slog::Logger>> loggers;
+    for (int i = 0; i < logger_count; ++i) {
+        loggers.push_back(slog::make_logger("cfg_bulk_" + std::to_string(i), std::make_shared<slog::sink::None>(slog::LogLevel::Info)));
+    }
+
+    // 500 条规则：一半精确匹配，一半通配符，最后一条正则
+    auto make_config = [](const char *level) {
+        std::string text = "[rules]\n";
+        for (int i = 0; i < 250; ++i) {
+            text += "cfg_bulk_" + std::to_string(i) + " = " + level + "\n";
+        }
+        for (int i = 0; i < 249; ++i) {
+            text += "cfg_other_" + std::to_string(i) + "_* = " + level + "\n";
+        }
+        text += "^cfg_bulk_[0-9]+$ = " + std::string(level) + "\n";
+        return text;
+    };
+    std::string debug_config = make_config("debug");
+    std::string error_config = make_config("error");
+
+    std::atomic<bool> stop(false);
+    std::atomic<uint64_t> calls(0);
+    std::vector<std::thread> workers;
+    for (int t = 0; t < 4; ++t) {
+        workers.emplace_back([&, t]() {
+            uint64_t local = 0;
+            while (!stop.load(std::memory_order_relaxed)) {
+                loggers[(local + t) % logger_count]->debug("bulk {}", local);
+                local++;
+            }
+            calls.fetch_add(local);
+        });
+    }
+
+    const int reloads = 20;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < reloads; ++i) {
+        expect(slog::load_config_text((i % 2 == 0) ? debug_config : error_config), "bulk reload");
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    stop.store(true);
+    for (auto & worker : workers) {
+        worker.join();
+    }
+
+    std::cout << "reload: " << elapsed.count() / reloads << " us/reload (500 rules, "
+              << logger_count << " loggers), log calls during reloads: " << calls.load() << std::endl;
+    for (auto const & logger : loggers) {
+        expect(logger->get_level() == slog::LogLevel::Error, "last reload published to every logger");
+    }
+    expect(slog::get_logger_rules().size() == 500, "rule table replaced, not appended");
+
+    for (int i = 0; i < logger_count; ++i) {
+        slog::drop_logger("cfg_bulk_" + std::to_string(i));
+    }
+    slog::clear_logger_rules();
+}
+
+void test_watch_config()
+{
+    std::cout << "=== Test: inotify watcher reloads on change ===" << std::endl;
+    std::string path = temp_path("watch.conf");
+    write_file(path, "[rules]\ncfg_watch = info\n");
+
+    auto logger = slog::make_stdout_logger("cfg_watch", slog::LogLevel::Warning);
+    expect(slog::load_config(path), "initial load");
+    expect(logger->get_level() == slog::LogLevel::Info, "initial level");
+
+    std::mutex mutex;
+    std::condition_variable cv;
+    int reloads = 0;
+    bool last_ok = false;
+    expect(slog::watch_config(path, [&](bool ok) {
+        std::lock_guard<std::mutex> lock(mutex);
+        reloads++;
+        last_ok = ok;
+        cv.notify_all();
+    }), "watch started");
+
+    auto wait_reload = [&](int count) {
+        std::unique_lock<std::mutex> lock(mutex);
+        return cv.wait_for(lock, std::chrono::seconds(3), [&]() { return reloads >= count; });
+    };
+
+    // 原地改写
+    write_file(path, "[rules]\ncfg_watch = trace\n");
+    expect(wait_reload(1) && last_ok, "reload after in-place write");
+    expect(logger->get_level() == slog::LogLevel::Trace, "level after in-place write");
+
+    // 写临时文件再重命名（编辑器的常见保存方式）
+    std::string tmp = path + ".tmp";
+    write_file(tmp, "[rules]\ncfg_watch = error\n");
+    std::rename(tmp.c_str(), path.c_str());
+    expect(wait_reload(2) && last_ok, "reload after rename");
+    expect(logger->get_level() == slog::LogLevel::Error, "level after rename");
+
+    // 写坏的配置被拒绝，等级保持不变
+    write_file(path, "[rules]\ncfg_watch = nonsense\n");
+    expect(wait_reload(3) && !last_ok, "broken config reported");
+    expect(logger->get_level() == slog::LogLevel::Error, "level kept after broken config");
+
+    slog::unwatch_config();
+    write_file(path, "[rules]\ncfg_watch = debug\n");
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    expect(reloads == 3 && logger->get_level() == slog::LogLevel::Error, "no reload after unwatch");
+
+    slog::drop_logger("cfg_watch");
+    slog::clear_logger_rules();
+    std::remove(path.c_str());
+}
+
+int main()
+{
+    try {
+        test_load_sinks_and_rules();
+        test_shared_sink_cloned_per_logger();
+        test_invalid_config_is_not_applied();
+        test_reload_restores_level();
+        test_bulk_reload_under_load();
+        test_watch_config();
+    } catch (std::exception const & e) {
+        std::cerr << "Test failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "All config tests passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,140 @@
+/**
+ * @file test_control.cpp
+ * @brief 测试控制端点：通过 Unix 域套接字查询、修改等级，刷新和读取统计
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <stdexcept>
+#include <cstdio>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <slog/slog.hpp>
+#include <slog/control.hpp>
+#include <slog/sink_file.hpp>
+#include <slog/sink_isolated.hpp>
+#include <slog/sink_none.hpp>
+
+#include "test_util.hpp"
+
+namespace {
+
+using slog_test::expect;
+using slog_test::read_file;
+
+std::string g_socket;
+
+/// 发送命令，返回去掉 "OK\n" 的回复；ERR 时抛出异常
+std::string request(std::string const & command)
+{
+    std::string response;
+    expect(slog::control_request(g_socket, command, &response), "request sent: " + command);
+    expect(response.compare(0, 3, "OK\n") == 0, "command accepted: " + command + " -> " + response);
+    return response.substr(3);
+}
+
+std::string request_error(std::string const & command)
+{
+    std::string response;
+    expect(slog::control_request(g_socket, command, &response), "request sent: " + command);
+    expect(response.compare(0, 4, "ERR ") == 0, "command rejected: " + command);
+    return response;
+}
+
+} // namespace
+
+void test_levels_and_rules()
+{
+    std::cout << "=== Test: list/get/set/apply/rules ===" << std::endl;
+    auto net = slog::make_logger("ctl_net", std::make_shared<slog::sink::None>(slog::LogLevel::Info));
+    auto db = slog::make_logger("ctl_db", std::make_shared<slog::sink::None>(slog::LogLevel::Info));
+
+    std::string list = request("list");
+    expect(list.find("ctl_net INFO\n") != std::string::npos && list.find("ctl_db INFO\n") != std::string::npos, "list: " + list);
+
+    request("set ctl_n* debug");
+    expect(net->get_level() == slog::LogLevel::Debug, "set applied");
+    expect(request("get ctl_net") == "DEBUG\n", "get");
+
+    expect(request("apply ctl_db:trace; ctl_net:error") == "2 rules applied\n", "apply");
+    expect(db->get_level() == slog::LogLevel::Trace, "apply db");
+    expect(request("get ctl_net") == "ERROR\n", "exact rule beats wildcard");
+
+    std::string rules = request("rules");
+    expect(rules.find("ctl_n* DEBUG\n") != std::string::npos && rules.find("ctl_db TRACE\n") != std::string::npos, "rules: " + rules);
+
+    request("set ctl_db off");
+    expect(db->get_level() == slog::LogLevel::Off, "level off");
+
+    request("clear-rules");
+    expect(request("rules").empty(), "rules cleared");
+
+    request_error("get ctl_missing");
+    request_error("set ctl_db loud");
+    request_error("frobnicate");
+
+    slog::drop_logger("ctl_net");
+    slog::drop_logger("ctl_db");
+}
+
+void test_flush_and_stats()
+{
+    std::cout << "=== Test: flush/stats ===" << std::endl;
+    std::string path = "/tmp/slog_test_control_" + std::to_string(getpid()) + ".log";
+    std::remove(path.c_str());
+
+    // 不在每次写入后刷新，内容留在文件流缓冲区里，直到 flush 命令
+    auto file = std::make_shared<slog::sink::File>(slog::LogLevel::Info, path, 0, 1, false);
+    auto isolated = std::make_shared<slog::sink::Isolated>(std::make_shared<slog::sink::None>(slog::LogLevel::Info), 16);
+    auto logger = slog::make_logger("ctl_file", std::vector<std::shared_ptr<slog::LoggerSink>>{file, isolated});
+
+    logger->info("buffered record");
+    expect(read_file(path).find("buffered record") == std::string::npos, "record still buffered");
+    request("flush ctl_file");
+    expect(read_file(path).find("buffered record") != std::string::npos, "record flushed");
+
+    logger->info("second record");
+    request("flush");
+    expect(read_file(path).find("second record") != std::string::npos, "flush all");
+
+    std::string stats = request("stats ctl_file");
+    std::cout << stats;
+    expect(stats.find("ctl_file sink[0]=File level=INFO\n") != std::string::npos, "file sink stats");
+    expect(stats.find("ctl_file sink[1]=Isolated level=INFO enqueued=2 processed=2 dropped=0") != std::string::npos,
+           "isolated counters");
+
+    slog::drop_logger("ctl_file");
+    std::remove(path.c_str());
+}
+
+int main()
+{
+    try {
+        g_socket = "/tmp/slog_test_control_" + std::to_string(getpid()) + ".sock";
+        expect(slog::start_control_server(g_socket), "control server started");
+        struct stat st;
+        expect(stat(g_socket.c_str(), &st) == 0 && (st.st_mode & 0777) == 0600, "socket is owner-only");
+
+        test_levels_and_rules();
+        test_flush_and_stats();
+
+        // 重新启动同一路径
+        expect(slog::start_control_server(g_socket), "control server restarted");
+        request("list");
+
+        slog::stop_control_server();
+        std::string response;
+        expect(!slog::control_request(g_socket, "list", &response), "no server after stop");
+        expect(stat(g_socket.c_str(), &st) != 0, "socket removed");
+    } catch (std::exception const & e) {
+        std::cerr << "Test failed: " << e.what() << std::endl;
+        slog::stop_control_server();
+        return 1;
+    }
+
+    std::cout << "All control tests passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,128 @@
+/**
+ * @file test_env_rules.cpp
+ * @brief 测试 SLOG_LEVEL 环境变量和命令行规则：在子进程中检查静态初始化阶段创建的 logger
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <cstdlib>
+#include <cstring>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <slog/slog.hpp>
+#include <slog/config.hpp>
+
+#include "test_util.hpp"
+
+namespace {
+
+using slog_test::expect;
+
+// 在 main() 之前创建，SLOG_LEVEL 必须已经生效
+std::shared_ptr<slog::Logger> s_net_logger = slog::make_stdout_logger("net_io", slog::LogLevel::Error);
+std::shared_ptr<slog::Logger> s_db_logger = slog::make_stdout_logger("db", slog::LogLevel::Error);
+std::shared_ptr<slog::Logger> s_app_logger = slog::make_stdout_logger("app", slog::LogLevel::Error);
+
+/// 以指定环境变量和参数重新执行自身，返回子进程退出码
+int run_child(char const *slog_level, std::vector<std::string> const & args)
+{
+    pid_t pid = fork();
+    if (pid < 0) {
+        throw std::runtime_error("fork failed");
+    }
+    if (pid == 0) {
+        if (slog_level != nullptr) {
+            setenv("SLOG_LEVEL", slog_level, 1);
+        } else {
+            unsetenv("SLOG_LEVEL");
+        }
+        std::vector<char *> argv;
+        argv.push_back(const_cast<char *>("test_slog_env_rules"));
+        for (auto const & arg : args) {
+            argv.push_back(const_cast<char *>(arg.c_str()));
+        }
+        argv.push_back(nullptr);
+        execv("/proc/self/exe", argv.data());
+        _exit(127);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 128;
+}
+
+/// 子进程：按第二个参数检查各 logger 的等级
+int child_main(int argc, char **argv)
+{
+    std::string mode = argv[2];
+    slog::apply_logger_rules_from_args(argc, argv);
+
+    if (mode == "env") {
+        // SLOG_LEVEL="net_*:debug;db:trace"
+        expect(s_net_logger->get_level() == slog::LogLevel::Debug, "wildcard rule from env");
+        expect(s_db_logger->get_level() == slog::LogLevel::Trace, "exact rule from env");
+        expect(s_app_logger->get_level() == slog::LogLevel::Error, "unmatched logger unchanged");
+        expect(slog::get_logger_rules().size() == 2, "two env rules");
+    } else if (mode == "global") {
+        // SLOG_LEVEL="warning"
+        expect(s_net_logger->get_level() == slog::LogLevel::Warning, "bare level applies to all");
+        expect(s_app_logger->get_level() == slog::LogLevel::Warning, "bare level applies to all");
+    } else if (mode == "args") {
+        // SLOG_LEVEL="net_*:debug" + --slog-level=app:info --slog-level db:warning
+        expect(s_net_logger->get_level() == slog::LogLevel::Debug, "env rule kept");
+        expect(s_app_logger->get_level() == slog::LogLevel::Info, "rule from --slog-level=");
+        expect(s_db_logger->get_level() == slog::LogLevel::Warning, "rule from --slog-level <value>");
+    } else if (mode == "config") {
+        // SLOG_LEVEL="net_*:debug"，配置文件重新加载只替换配置自己的规则
+        expect(slog::load_config_text("[rules]\nnet_io = warning\ndb = trace\n"), "first config");
+        expect(s_net_logger->get_level() == slog::LogLevel::Warning, "config rule applied");
+        expect(s_db_logger->get_level() == slog::LogLevel::Trace, "config rule applied");
+        expect(slog::load_config_text("[rules]\napp = info\n"), "reloaded config");
+        expect(s_net_logger->get_level() == slog::LogLevel::Debug, "env rule survives the reload");
+        expect(s_db_logger->get_level() == slog::LogLevel::Error, "dropped config rule removed");
+        expect(s_app_logger->get_level() == slog::LogLevel::Info, "new config rule applied");
+        auto rules = slog::get_logger_rules();
+        expect(rules.size() == 2 && rules.count("net_*") == 1 && rules.count("app") == 1, "env and config rules");
+    } else if (mode == "none") {
+        expect(s_net_logger->get_level() == slog::LogLevel::Error, "no env, no rules");
+        expect(slog::get_logger_rules().empty(), "rule table empty");
+    } else {
+        return 2;
+    }
+    return 0;
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    try {
+        if (argc >= 3 && std::strcmp(argv[1], "--child") == 0) {
+            return child_main(argc, argv);
+        }
+
+        std::cout << "=== Test: SLOG_LEVEL applied before static-init loggers ===" << std::endl;
+        expect(run_child("net_*:debug;db:trace", {"--child", "env"}) == 0, "env rules");
+
+        std::cout << "=== Test: SLOG_LEVEL with a bare level ===" << std::endl;
+        expect(run_child("warning", {"--child", "global"}) == 0, "bare level");
+
+        std::cout << "=== Test: --slog-level arguments ===" << std::endl;
+        expect(run_child("net_*:debug", {"--child", "args", "--slog-level=app:info", "--slog-level", "db:warning"}) == 0,
+               "argv rules");
+
+        std::cout << "=== Test: SLOG_LEVEL rules survive a config reload ===" << std::endl;
+        expect(run_child("net_*:debug", {"--child", "config"}) == 0, "config reload");
+
+        std::cout << "=== Test: no SLOG_LEVEL ===" << std::endl;
+        expect(run_child(nullptr, {"--child", "none"}) == 0, "no env");
+    } catch (std::exception const & e) {
+        std::cerr << "Test failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "All env rule tests passed" << std::endl;
+    return 0;
+}
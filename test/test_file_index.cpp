@@ -0,0 +1,259 @@
+/**
+ * @file test_file_index.cpp
+ * @brief 测试 File sink 的时间索引：按字节数和时间间隔记录、偏移指向行首、随轮转改名
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <slog/slog.hpp>
+#include <slog/sink_file.hpp>
+
+#include "test_util.hpp"
+
+namespace {
+
+using slog_test::expect;
+using slog_test::read_file;
+
+std::vector<slog::sink::TimeIndexEntry> read_index(std::string const & path)
+{
+    std::string data = read_file(path);
+    expect(data.size() >= sizeof(slog::sink::kTimeIndexMagic), "index has a header: " + path);
+    expect(std::memcmp(data.data(), slog::sink::kTimeIndexMagic, sizeof(slog::sink::kTimeIndexMagic)) == 0,
+           "index magic: " + path);
+    size_t body = data.size() - sizeof(slog::sink::kTimeIndexMagic);
+    expect(body % sizeof(slog::sink::TimeIndexEntry) == 0, "whole records: " + path);
+
+    std::vector<slog::sink::TimeIndexEntry> entries(body / sizeof(slog::sink::TimeIndexEntry));
+    if (!entries.empty()) {
+        std::memcpy(&entries[0], data.data() + sizeof(slog::sink::kTimeIndexMagic), body);
+    }
+    return entries;
+}
+
+/// 行首时间戳 "YYYY-mm-dd HH:MM:SS.mmm" 转为 epoch 毫秒
+int64_t line_ms(std::string const & log, size_t offset)
+{
+    std::tm tm;
+    std::memset(&tm, 0, sizeof(tm));
+    int ms = 0;
+    int n = std::sscanf(log.c_str() + offset, "%d-%d-%d %d:%d:%d.%d",
+        &tm.tm_year, &tm.tm_mon, &tm.tm_mday, &tm.tm_hour, &tm.tm_min, &tm.tm_sec, &ms);
+    expect(n == 7, "timestamp at offset " + std::to_string(offset));
+    tm.tm_year -= 1900;
+    tm.tm_mon -= 1;
+    tm.tm_isdst = -1;
+    return static_cast<int64_t>(std::mktime(&tm)) * 1000 + ms;
+}
+
+/// 检查索引与日志文件一致：偏移递增且指向行首，时间不早于该行的时间戳
+void check_index(std::string const & log_path, std::vector<slog::sink::TimeIndexEntry> const & entries)
+{
+    std::string log = read_file(log_path);
+    for (size_t i = 0; i < entries.size(); ++i) {
+        size_t offset = static_cast<size_t>(entries[i].offset);
+        expect(offset < log.size(), "offset inside the file");
+        expect(offset == 0 || log[offset - 1] == '\n', "offset at a line start");
+        expect(line_ms(log, offset) <= entries[i].timestamp_ms, "index time not before the line");
+        if (i > 0) {
+            expect(entries[i].offset > entries[i - 1].offset, "offsets increase");
+            expect(entries[i].timestamp_ms >= entries[i - 1].timestamp_ms, "timestamps do not go back");
+        }
+    }
+}
+
+void remove_files(std::string const & path)
+{
+    for (const char *suffix : {"", ".idx", ".1", ".1.idx", ".2", ".2.idx"}) {
+        std::remove((path + suffix).c_str());
+    }
+}
+
+} // namespace
+
+void test_index_by_bytes()
+{
+    std::cout << "=== Test: index entry every N bytes ===" << std::endl;
+    std::string path = "/tmp/slog_test_index_bytes_" + std::to_string(getpid()) + ".log";
+    remove_files(path);
+
+    auto file = std::make_shared<slog::sink::File>(slog::LogLevel::Info, path, 0, 1);
+    file->enable_time_index(1024, std::chrono::hours(1));
+    auto logger = slog::make_logger("index_bytes", file);
+    for (int i = 0; i < 200; ++i) {
+        logger->info("message number {} with some padding text", i);
+    }
+
+    auto entries = read_index(path + ".idx");
+    size_t log_size = read_file(path).size();
+    std::cout << entries.size() << " entries for " << log_size << " bytes" << std::endl;
+    expect(entries.size() >= log_size / 1200 && entries.size() <= log_size / 1024 + 1, "about one entry per KB");
+    expect(entries[0].offset == 0, "first line indexed");
+    for (size_t i = 1; i < entries.size(); ++i) {
+        expect(entries[i].offset - entries[i - 1].offset >= 1024, "entries at least N bytes apart");
+    }
+    check_index(path, entries);
+
+    slog::drop_logger("index_bytes");
+    remove_files(path);
+}
+
+void test_index_by_time()
+{
+    std::cout << "=== Test: index entry every interval, enabled after setup ===" << std::endl;
+    std::string path = "/tmp/slog_test_index_time_" + std::to_string(getpid()) + ".log";
+    remove_files(path);
+
+    auto file = std::make_shared<slog::sink::File>(slog::LogLevel::Info, path, 0, 1);
+    auto logger = slog::make_logger("index_time", file);
+    logger->info("written before the index");
+    file->enable_time_index(1024 * 1024, std::chrono::milliseconds(30));
+
+    for (int i = 0; i < 10; ++i) {
+        logger->info("tick {}", i);
+        std::this_thread::sleep_for(std::chrono::milliseconds(15));
+    }
+
+    auto entries = read_index(path + ".idx");
+    expect(entries.size() >= 3 && entries.size() <= 8, "entries follow the interval: " + std::to_string(entries.size()));
+    expect(entries[0].offset > 0, "index starts at the current end of the file");
+    check_index(path, entries);
+
+    slog::drop_logger("index_time");
+    remove_files(path);
+}
+
+void test_index_record_time()
+{
+    std::cout << "=== Test: index uses the record time of delayed writes ===" << std::endl;
+    std::string path = "/tmp/slog_test_index_record_" + std::to_string(getpid()) + ".log";
+    remove_files(path);
+
+    auto file = std::make_shared<slog::sink::File>(slog::LogLevel::Info, path, 0, 1);
+    file->enable_time_index(64);
+    auto logger = slog::make_logger("index_record", file);
+
+    // 记录在 1.2 秒前产生，写入时索引仍按记录自身的时间
+    slog::Batch batch;
+    for (int i = 0; i < 20; ++i) {
+        batch.add(slog::LogLevel::Info, "delayed batch row {:02d} with padding", i);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1200));
+    logger->log_batch(batch);
+
+    std::string log = read_file(path);
+    auto entries = read_index(path + ".idx");
+    expect(entries.size() >= 10, "batch split into indexed chunks");
+    check_index(path, entries);
+    for (auto const & entry : entries) {
+        int64_t lag = entry.timestamp_ms - line_ms(log, static_cast<size_t>(entry.offset));
+        expect(lag < 500, "index time is the record time, lag " + std::to_string(lag) + "ms");
+    }
+
+    slog::drop_logger("index_record");
+    remove_files(path);
+}
+
+void test_index_late_record()
+{
+    std::cout << "=== Test: late records stay before the --to cut ===" << std::endl;
+    std::string path = "/tmp/slog_test_index_late_" + std::to_string(getpid()) + ".log";
+    remove_files(path);
+
+    auto file = std::make_shared<slog::sink::File>(slog::LogLevel::Info, path, 0, 1);
+    file->enable_time_index(64);
+    auto logger = slog::make_logger("index_late", file);
+
+    // Batch 在 1.5 秒前产生，在一条新日志之后才写入，时间早于它前面的行
+    slog::Batch batch;
+    for (int i = 0; i < 10; ++i) {
+        batch.add(slog::LogLevel::Info, "late batch row {:02d} with padding", i);
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(1500));
+    logger->info("fresh line written before the batch");
+    logger->log_batch(batch);
+    logger->info("fresh line written after the batch");
+
+    std::string log = read_file(path);
+    auto entries = read_index(path + ".idx");
+    check_index(path, entries);
+    int64_t max_lag = entries.back().max_lag_ms;
+    expect(max_lag >= 1400, "lag of the batch recorded: " + std::to_string(max_lag) + "ms");
+
+    // 与 slog_cat --to 相同的截断：第一条时间超过 to + max_lag 的记录之后不能再有时间不晚于 to 的行
+    size_t late_offset = log.find("late batch row 09");
+    expect(late_offset != std::string::npos, "batch written");
+    late_offset = log.rfind('\n', late_offset) + 1;
+    int64_t to = line_ms(log, late_offset);
+    for (auto const & entry : entries) {
+        if (entry.timestamp_ms > to + max_lag) {
+            expect(entry.offset > late_offset, "late record not cut off by --to");
+            break;
+        }
+    }
+    for (auto const & entry : entries) {
+        for (size_t pos = static_cast<size_t>(entry.offset); pos < log.size(); pos = log.find('\n', pos) + 1) {
+            expect(line_ms(log, pos) >= entry.timestamp_ms - max_lag, "no line later than the recorded lag");
+        }
+    }
+
+    slog::drop_logger("index_late");
+    remove_files(path);
+}
+
+void test_index_rotation()
+{
+    std::cout << "=== Test: index rotates with the log file ===" << std::endl;
+    std::string path = "/tmp/slog_test_index_rotate_" + std::to_string(getpid()) + ".log";
+    remove_files(path);
+
+    auto file = std::make_shared<slog::sink::File>(slog::LogLevel::Info, path, 4096, 2);
+    file->enable_time_index(512);
+    auto logger = slog::make_logger("index_rotate", file);
+    for (int i = 0; i < 150; ++i) {
+        logger->info("rotating message number {} with some padding text", i);
+    }
+
+    struct stat st;
+    expect(stat((path + ".1.idx").c_str(), &st) == 0, "rotated index exists");
+    expect(stat((path + ".2.idx").c_str(), &st) == 0, "second rotated index exists");
+    expect(stat((path + ".3.idx").c_str(), &st) != 0, "oldest index removed");
+
+    for (std::string const & log_path : {path, path + ".1", path + ".2"}) {
+        auto entries = read_index(log_path + ".idx");
+        expect(!entries.empty() && entries[0].offset == 0, "each file indexed from its start: " + log_path);
+        check_index(log_path, entries);
+    }
+
+    slog::drop_logger("index_rotate");
+    remove_files(path);
+}
+
+int main()
+{
+    try {
+        test_index_by_bytes();
+        test_index_by_time();
+        test_index_record_time();
+        test_index_late_record();
+        test_index_rotation();
+    } catch (std::exception const & e) {
+        std::cerr << "Test failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "All file index tests passed" << std::endl;
+    return 0;
+}
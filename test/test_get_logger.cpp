@@ -11,8 +11,13 @@
  */
 
 #include <iostream>
+#include <stdexcept>
 #include <slog/slog.hpp>
 
+#include "test_util.hpp"
+
+using slog_test::expect;
+
 
 void test_case1()
 {
@@ -38,6 +43,30 @@ void test_case3()
     slog::info("This logger name should be default");
 }
 
+void test_case4()
+{
+    // 字面量名称在编译期求哈希，每个线程只查找一次注册表
+    static_assert(slog::detail::fnv1a_hash("net") == slog::detail::fnv1a_hash("net", 3), "fnv1a_hash mismatch");
+
+    auto net1 = SLOG_GET_LOGGER("net");
+    net1->info("logger name should be net");
+    auto net2 = SLOG_GET_LOGGER("net");
+    expect(net1 == net2 && net1 == slog::get_logger("net"), "cached handle is the registered logger");
+
+    // 同名 logger 共享驻留名称
+    auto other = slog::make_stdout_logger("net_other");
+    auto again = slog::get_logger("net_other");
+    expect(other->id() == again->id() && other->id() != net1->id(), "same id for same name");
+
+    // logger 被移除并重建后，缓存自动失效；之前取得的 logger 不变
+    slog::drop_logger("net");
+    auto replaced = slog::make_stdout_logger("net", slog::LogLevel::Debug);
+    auto net3 = SLOG_GET_LOGGER("net");
+    expect(net3 == replaced && net3 == slog::get_logger("net"), "cache refreshed after re-registration");
+    expect(net1 != net3 && net1 == net2, "earlier handle unchanged by the refresh");
+    SLOG_GET_LOGGER("net")->debug("debug from replaced net logger");
+    std::cout << "cached logger checks passed" << std::endl;
+}
 
 int main(int argc, const char *argv[]) {
 
@@ -52,6 +81,13 @@ int main(int argc, const char *argv[]) {
         test_case2();
     }else if (test_case == 3){
         test_case3();
+    } else if (test_case == 4){
+        try {
+            test_case4();
+        } catch (std::exception const & e) {
+            std::cerr << "Test failed: " << e.what() << std::endl;
+            return 1;
+        }
     } else {
         std::cout << "Invalid test case" << std::endl;
         return 1;
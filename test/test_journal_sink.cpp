@@ -0,0 +1,249 @@
+/**
+ * @file test_journal_sink.cpp
+ * @brief 测试 Journal sink：用临时 Unix 数据报套接字模拟 journald，解析原生协议字段
+ */
+
+#include <iostream>
+#include <map>
+#include <string>
+#include <vector>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <slog/slog.hpp>
+#include <slog/sink_journal.hpp>
+
+#include "test_util.hpp"
+
+namespace {
+
+using slog_test::expect;
+
+const char *kSocketPath = "/tmp/test_slog_journal.sock";
+
+using Record = std::map<std::string, std::string>;
+
+/// 解析原生协议记录："KEY=value\n" 或 "KEY\n" + 64 位小端长度 + value + "\n"
+Record parse_record(std::string const & data)
+{
+    Record record;
+    size_t pos = 0;
+    while (pos < data.size()) {
+        size_t eol = data.find('\n', pos);
+        expect(eol != std::string::npos, "field not terminated");
+        size_t eq = data.find('=', pos);
+        if (eq != std::string::npos && eq < eol) {
+            record[data.substr(pos, eq - pos)] = data.substr(eq + 1, eol - eq - 1);
+            pos = eol + 1;
+            continue;
+        }
+
+        std::string key = data.substr(pos, eol - pos);
+        pos = eol + 1;
+        expect(pos + 8 <= data.size(), "binary field length truncated");
+        uint64_t size = 0;
+        for (int i = 0; i < 8; ++i) {
+            size |= static_cast<uint64_t>(static_cast<uint8_t>(data[pos + i])) << (8 * i);
+        }
+        pos += 8;
+        expect(pos + size < data.size() && data[pos + size] == '\n', "binary field body");
+        record[key] = data.substr(pos, size);
+        pos += size + 1;
+    }
+    return record;
+}
+
+/// 模拟 journald：绑定到临时路径的数据报套接字，支持接收 SCM_RIGHTS 传递的 memfd
+class FakeJournald
+{
+public:
+    FakeJournald()
+    {
+        unlink(kSocketPath);
+        fd_ = socket(AF_UNIX, SOCK_DGRAM, 0);
+        struct sockaddr_un addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, kSocketPath, sizeof(addr.sun_path) - 1);
+        if (fd_ < 0 || bind(fd_, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0) {
+            throw std::runtime_error("bind fake journald socket failed");
+        }
+        struct timeval tv = {1, 0};
+        setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    }
+
+    ~FakeJournald()
+    {
+        close(fd_);
+        unlink(kSocketPath);
+    }
+
+    /// 接收一条记录；memfd 记录读取文件内容，并通过 sealed 返回是否已密封
+    std::string receive(bool *via_memfd = nullptr, bool *sealed = nullptr)
+    {
+        std::vector<char> buf(256 * 1024);
+        union
+        {
+            struct cmsghdr header;
+            char data[CMSG_SPACE(sizeof(int))];
+        } control;
+
+        struct iovec iov = {buf.data(), buf.size()};
+        struct msghdr msg;
+        std::memset(&msg, 0, sizeof(msg));
+        msg.msg_iov = &iov;
+        msg.msg_iovlen = 1;
+        msg.msg_control = control.data;
+        msg.msg_controllen = sizeof(control.data);
+
+        ssize_t size = recvmsg(fd_, &msg, MSG_CMSG_CLOEXEC);
+        if (size < 0) {
+            return std::string();
+        }
+
+        struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+        bool has_fd = (cmsg != nullptr && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS);
+        if (via_memfd != nullptr) {
+            *via_memfd = has_fd;
+        }
+        if (!has_fd) {
+            return std::string(buf.data(), static_cast<size_t>(size));
+        }
+
+        int memfd;
+        std::memcpy(&memfd, CMSG_DATA(cmsg), sizeof(int));
+        if (sealed != nullptr) {
+            int seals = fcntl(memfd, F_GET_SEALS);
+            *sealed = (seals >= 0 && (seals & F_SEAL_WRITE) && (seals & F_SEAL_SEAL));
+        }
+
+        std::string content;
+        ssize_t n;
+        off_t offset = 0;
+        while ((n = pread(memfd, buf.data(), buf.size(), offset)) > 0) {
+            content.append(buf.data(), static_cast<size_t>(n));
+            offset += n;
+        }
+        close(memfd);
+        return content;
+    }
+
+private:
+    int fd_;
+};
+
+} // namespace
+
+void test_fields()
+{
+    std::cout << "=== Test: journal fields ===" << std::endl;
+    FakeJournald journald;
+
+    auto sink = std::make_shared<slog::sink::Journal>(slog::LogLevel::Debug, kSocketPath);
+    auto logger = slog::make_logger("journal_test", sink);
+
+    logger->warning("disk {}% full", 93);
+    logger->error("request failed", slog::kv("latency_us", 1250), slog::kv("user.name", "alice bob"),
+        slog::kv("_private", true), slog::kv("path", "a\nb"));
+    logger->trace("filtered");
+
+    Record warning = parse_record(journald.receive());
+    expect(warning["MESSAGE"] == "disk 93% full", "MESSAGE");
+    expect(warning["PRIORITY"] == "4", "warning priority");
+    expect(warning["SYSLOG_IDENTIFIER"] == "journal_test", "SYSLOG_IDENTIFIER");
+    expect(warning.count("CODE_FILE") == 0, "no CODE_* outside SLOG_* macros");
+
+    Record error = parse_record(journald.receive());
+    expect(error["MESSAGE"] == "request failed", "fields MESSAGE");
+    expect(error["PRIORITY"] == "3", "error priority");
+    expect(error["LATENCY_US"] == "1250", "int field");
+    expect(error["USER_NAME"] == "alice bob", "string field with sanitized key");
+    expect(error["FIELD__PRIVATE"] == "true", "key starting with underscore is prefixed");
+    expect(error["PATH"] == "a\nb", "value with newline uses binary encoding");
+    expect(sink->dropped() == 0, "no drops");
+}
+
+void test_code_location()
+{
+    std::cout << "=== Test: CODE_FILE/CODE_LINE/CODE_FUNC ===" << std::endl;
+    FakeJournald journald;
+
+    std::string previous = slog::default_logger()->name();
+    auto logger = slog::make_logger("journal_default", std::make_shared<slog::sink::Journal>(slog::LogLevel::Info, kSocketPath));
+    slog::set_default_logger("journal_default");
+
+    int line = __LINE__ + 1;
+    SLOG_INFO("from macro {}", 1);
+    slog::set_default_logger(previous);
+
+    Record record = parse_record(journald.receive());
+    expect(record["MESSAGE"] == "from macro 1", "macro MESSAGE");
+    expect(record["CODE_FILE"].find("test_journal_sink.cpp") != std::string::npos, "CODE_FILE");
+    expect(record["CODE_LINE"] == std::to_string(line), "CODE_LINE");
+    expect(record["CODE_FUNC"].find("test_code_location") != std::string::npos, "CODE_FUNC");
+}
+
+void test_large_record_memfd()
+{
+    std::cout << "=== Test: large record through sealed memfd ===" << std::endl;
+    FakeJournald journald;
+
+    auto sink = std::make_shared<slog::sink::Journal>(slog::LogLevel::Info, kSocketPath);
+    auto logger = slog::make_logger("journal_large", sink);
+
+    std::vector<uint8_t> data(16 * 1024);
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<uint8_t>(i);
+    }
+    logger->dump(slog::LogLevel::Info, data, "dump {}", data.size());
+
+    bool via_memfd = false;
+    bool sealed = false;
+    Record record = parse_record(journald.receive(&via_memfd, &sealed));
+    expect(via_memfd, "large record sent as memfd");
+    expect(sealed, "memfd sealed before sending");
+    std::string const & message = record["MESSAGE"];
+    std::cout << "MESSAGE size: " << message.size() << std::endl;
+    expect(message.compare(0, 10, "dump 16384") == 0, "dump header");
+    expect(message.find("\r\n3ff0  f0 f1 f2 f3") != std::string::npos, "dump body preserved");
+
+    // 小记录仍走普通数据报
+    logger->info("small");
+    record = parse_record(journald.receive(&via_memfd));
+    expect(!via_memfd && record["MESSAGE"] == "small", "small record as datagram");
+    expect(sink->dropped() == 0, "no drops");
+}
+
+void test_journald_unavailable()
+{
+    std::cout << "=== Test: journald unavailable ===" << std::endl;
+    unlink(kSocketPath);
+
+    auto sink = std::make_shared<slog::sink::Journal>(slog::LogLevel::Info, kSocketPath);
+    auto logger = slog::make_logger("journal_missing", sink);
+    expect(logger->is_valid(), "logger stays valid without journald");
+
+    logger->info("nobody listens");
+    expect(sink->dropped() == 1, "message dropped while journald is missing");
+}
+
+int main()
+{
+    try {
+        test_fields();
+        test_code_location();
+        test_large_record_memfd();
+        test_journald_unavailable();
+    } catch (std::exception const & e) {
+        std::cerr << "Test failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "All journal sink tests passed" << std::endl;
+    return 0;
+}
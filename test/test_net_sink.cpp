@@ -0,0 +1,319 @@
+/**
+ * @file test_net_sink.cpp
+ * @brief 测试 Net sink：同一进程内的回环 TCP/UDP 监听端接收并解析批次
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <thread>
+#include <stdexcept>
+#include <cstring>
+#include <cstdint>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <slog/slog.hpp>
+#include <slog/sink_net.hpp>
+
+#include "test_util.hpp"
+
+namespace {
+
+using slog_test::expect;
+
+/// 绑定 127.0.0.1 的临时端口
+int bind_loopback(int type, uint16_t *port)
+{
+    int fd = socket(AF_INET, type, 0);
+    struct sockaddr_in addr;
+    std::memset(&addr, 0, sizeof(addr));
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t len = sizeof(addr);
+    if (fd < 0 || bind(fd, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0
+        || getsockname(fd, reinterpret_cast<struct sockaddr *>(&addr), &len) != 0) {
+        throw std::runtime_error("bind loopback socket failed");
+    }
+    *port = ntohs(addr.sin_port);
+    struct timeval tv = {2, 0};
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    return fd;
+}
+
+uint32_t get_be32(const char *data)
+{
+    const uint8_t *p = reinterpret_cast<const uint8_t *>(data);
+    return (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+}
+
+/// 按行拆分，每行必须以 '\n' 结尾
+std::vector<std::string> split_lines(std::string const & data)
+{
+    std::vector<std::string> lines;
+    size_t pos = 0;
+    while (pos < data.size()) {
+        size_t eol = data.find('\n', pos);
+        expect(eol != std::string::npos, "record not terminated");
+        lines.push_back(data.substr(pos, eol - pos));
+        pos = eol + 1;
+    }
+    return lines;
+}
+
+class TcpListener
+{
+public:
+    TcpListener()
+    {
+        fd_ = bind_loopback(SOCK_STREAM, &port_);
+        listen(fd_, 4);
+    }
+
+    ~TcpListener()
+    {
+        close(fd_);
+    }
+
+    uint16_t port() const { return port_; }
+
+    /// 接受一个连接，超时抛出异常
+    int accept_client()
+    {
+        struct pollfd pfd = {fd_, POLLIN, 0};
+        expect(poll(&pfd, 1, 3000) == 1, "no connection from net sink");
+        int client = accept(fd_, nullptr, nullptr);
+        struct timeval tv = {2, 0};
+        setsockopt(client, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+        return client;
+    }
+
+private:
+    int fd_;
+    uint16_t port_;
+};
+
+bool read_exact(int fd, char *data, size_t size)
+{
+    while (size > 0) {
+        ssize_t n = recv(fd, data, size, 0);
+        if (n <= 0) {
+            return false;
+        }
+        data += n;
+        size -= static_cast<size_t>(n);
+    }
+    return true;
+}
+
+/// 读取一帧，返回标志和数据；连接关闭或超时返回 false
+bool read_frame(int fd, char *flags, std::string *payload)
+{
+    char header[5];
+    if (!read_exact(fd, header, sizeof(header))) {
+        return false;
+    }
+    uint32_t size = get_be32(header);
+    expect(size >= 1, "frame length includes flags");
+    *flags = header[4];
+    payload->resize(size - 1);
+    return read_exact(fd, &(*payload)[0], payload->size());
+}
+
+} // namespace
+
+void test_tcp_batches()
+{
+    std::cout << "=== Test: TCP length-prefixed batches ===" << std::endl;
+    TcpListener listener;
+
+    slog::sink::NetOptions options;
+    options.batch_records = 100;
+    options.flush_interval = std::chrono::milliseconds(20);
+    auto sink = std::make_shared<slog::sink::Net>(slog::LogLevel::Info, "127.0.0.1", listener.port(),
+        slog::sink::NetProtocol::Tcp, options);
+    auto logger = slog::make_logger("net_tcp", sink);
+
+    const int total = 1000;
+    for (int i = 0; i < total; ++i) {
+        logger->info(fmt::format("record {}", i), slog::kv("seq", i));
+    }
+
+    int client = listener.accept_client();
+    std::vector<std::string> lines;
+    int frames = 0;
+    char flags;
+    std::string payload;
+    while (lines.size() < static_cast<size_t>(total) && read_frame(client, &flags, &payload)) {
+        expect(flags == 0, "uncompressed frame");
+        std::vector<std::string> batch = split_lines(payload);
+        expect(!batch.empty() && batch.size() <= options.batch_records, "batch size within limit");
+        lines.insert(lines.end(), batch.begin(), batch.end());
+        frames++;
+    }
+    close(client);
+
+    std::cout << "frames: " << frames << ", records: " << lines.size() << std::endl;
+    expect(lines.size() == static_cast<size_t>(total), "all records received");
+    for (int i = 0; i < total; ++i) {
+        std::string tail = "<INFO> (net_tcp) record " + std::to_string(i) + " seq=" + std::to_string(i);
+        expect(lines[i].find(tail) != std::string::npos, "record order and layout: " + lines[i]);
+    }
+    expect(frames >= total / 100, "records batched into frames");
+    expect(sink->sent() == static_cast<uint64_t>(total) && sink->dropped() == 0, "counters");
+    slog::drop_logger("net_tcp");
+}
+
+void test_tcp_reconnect()
+{
+    std::cout << "=== Test: TCP reconnect ===" << std::endl;
+    TcpListener listener;
+
+    slog::sink::NetOptions options;
+    options.flush_interval = std::chrono::milliseconds(5);
+    options.reconnect_min = std::chrono::milliseconds(10);
+    auto sink = std::make_shared<slog::sink::Net>(slog::LogLevel::Info, "127.0.0.1", listener.port(),
+        slog::sink::NetProtocol::Tcp, options);
+    auto logger = slog::make_logger("net_reconnect", sink);
+
+    logger->info("before");
+    int client = listener.accept_client();
+    char flags;
+    std::string payload;
+    expect(read_frame(client, &flags, &payload) && payload.find("before\n") != std::string::npos, "first connection");
+
+    // 服务端关闭连接，后续记录应在新连接上送达
+    close(client);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    logger->info("after");
+
+    client = listener.accept_client();
+    expect(read_frame(client, &flags, &payload) && payload.find("after\n") != std::string::npos, "second connection");
+    close(client);
+
+    std::cout << "reconnects: " << sink->reconnects() << std::endl;
+    expect(sink->reconnects() == 1, "one reconnect");
+    expect(sink->dropped() == 0, "nothing lost across reconnect");
+    slog::drop_logger("net_reconnect");
+}
+
+void test_spill_and_drop()
+{
+    std::cout << "=== Test: bounded spill buffer while disconnected ===" << std::endl;
+    // 绑定后立即关闭，得到一个没有监听者的端口
+    uint16_t port;
+    close(bind_loopback(SOCK_STREAM, &port));
+
+    slog::sink::NetOptions options;
+    options.spill_bytes = 4096;
+    options.linger = std::chrono::milliseconds(10);
+    auto sink = std::make_shared<slog::sink::Net>(slog::LogLevel::Info, "127.0.0.1", port,
+        slog::sink::NetProtocol::Tcp, options);
+    auto logger = slog::make_logger("net_spill", sink);
+
+    const int total = 1000;
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < total; ++i) {
+        logger->info("spill record {}", i);
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+    std::cout << "dropped: " << sink->dropped() << ", elapsed: " << elapsed.count() << "ms" << std::endl;
+    // 每条记录超过 40 字节，缓冲区最多保存约 100 条
+    expect(sink->dropped() >= static_cast<uint64_t>(total - 4096 / 40), "overflow counted as dropped");
+    expect(sink->sent() == 0, "nothing sent without peer");
+    expect(elapsed.count() < 1000, "logging does not block while disconnected");
+    slog::drop_logger("net_spill");
+}
+
+void test_udp_packing()
+{
+    std::cout << "=== Test: UDP packed datagrams ===" << std::endl;
+    uint16_t port;
+    int server = bind_loopback(SOCK_DGRAM, &port);
+
+    slog::sink::NetOptions options;
+    options.max_datagram_size = 512;
+    options.flush_interval = std::chrono::milliseconds(10);
+    auto sink = std::make_shared<slog::sink::Net>(slog::LogLevel::Info, "127.0.0.1", port,
+        slog::sink::NetProtocol::Udp, options);
+    auto logger = slog::make_logger("net_udp", sink);
+
+    const int total = 200;
+    for (int i = 0; i < total; ++i) {
+        logger->info("datagram record {}", i);
+    }
+
+    std::vector<std::string> lines;
+    size_t max_per_datagram = 0;
+    char buf[2048];
+    while (lines.size() < static_cast<size_t>(total)) {
+        ssize_t n = recv(server, buf, sizeof(buf), 0);
+        expect(n > 0, "datagram received");
+        expect(static_cast<size_t>(n) <= options.max_datagram_size, "datagram within size limit");
+        std::vector<std::string> batch = split_lines(std::string(buf, static_cast<size_t>(n)));
+        max_per_datagram = std::max(max_per_datagram, batch.size());
+        lines.insert(lines.end(), batch.begin(), batch.end());
+    }
+    close(server);
+
+    std::cout << "records: " << lines.size() << ", max records per datagram: " << max_per_datagram << std::endl;
+    for (int i = 0; i < total; ++i) {
+        expect(lines[i].find("(net_udp) datagram record " + std::to_string(i)) != std::string::npos, "udp record order");
+    }
+    expect(max_per_datagram > 1, "several records packed per datagram");
+    slog::drop_logger("net_udp");
+}
+
+void test_compression()
+{
+    std::cout << "=== Test: LZ4 compressed frames ===" << std::endl;
+    if (!slog::sink::Net::compression_supported()) {
+        std::cout << "LZ4 not available, skipped" << std::endl;
+        return;
+    }
+
+    TcpListener listener;
+    slog::sink::NetOptions options;
+    options.compress = true;
+    options.flush_interval = std::chrono::milliseconds(10);
+    auto sink = std::make_shared<slog::sink::Net>(slog::LogLevel::Info, "127.0.0.1", listener.port(),
+        slog::sink::NetProtocol::Tcp, options);
+    auto logger = slog::make_logger("net_lz4", sink);
+
+    for (int i = 0; i < 100; ++i) {
+        logger->info("highly compressible record, highly compressible record {}", i);
+    }
+
+    int client = listener.accept_client();
+    char flags;
+    std::string payload;
+    expect(read_frame(client, &flags, &payload), "compressed frame received");
+    close(client);
+    expect(flags == 1, "LZ4 flag set");
+    uint32_t raw_size = get_be32(payload.data());
+    std::cout << "raw: " << raw_size << ", compressed: " << payload.size() - 4 << std::endl;
+    expect(payload.size() - 4 < raw_size, "payload compressed");
+    slog::drop_logger("net_lz4");
+}
+
+int main()
+{
+    try {
+        test_tcp_batches();
+        test_tcp_reconnect();
+        test_spill_and_drop();
+        test_udp_packing();
+        test_compression();
+    } catch (std::exception const & e) {
+        std::cerr << "Test failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "All net sink tests passed" << std::endl;
+    return 0;
+}
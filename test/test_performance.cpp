@@ -22,6 +22,7 @@
 
 
 #include <slog/slog.hpp>
+#include <slog/sink_none.hpp>
 
 #ifdef BUILD_WITH_SPDLOG
 #define ENABLE_SPDLOG 1
@@ -30,14 +31,17 @@
 // 测试配置
 struct TestConfig 
 {
-    std::string log_type = "stdout";    // stdout 或 file 或 spdlog-file 或 spdlog-console
+    std::string log_type = "stdout";    // stdout 或 file 或 json 或 null 或 spdlog-file 或 spdlog-rotating 或 spdlog-console
     std::string log_file = "/tmp/perf_test.log";
     int log_count = 100000;             // 日志总数
     int thread_count = 1;               // 线程数量
+    int burst_size = 0;                 // 突发测试每批条数，0 表示不测试
     bool flush_on_write = false;        // 是否立即刷新(file专用)
 #ifdef ENABLE_SPDLOG
     bool spdlog = false;                // 是否使用spdlog
     bool async = false;                // 是否使用异步模式(spdlog专用)
+    size_t max_file_size = 1024 * 1024; // 轮转文件大小(spdlog-rotating专用)
+    size_t max_files = 5;               // 保留的轮转文件数量(spdlog-rotating专用)
 #endif 
     slog::LogLevel level = slog::LogLevel::Info;
     
@@ -47,22 +51,29 @@ struct TestConfig
         std::cout << "  Performance Test Configuration" << std::endl;
         std::cout << "========================================" << std::endl;
         std::cout << "Log Type        : " << log_type << std::endl;
-        if (log_type == "file") {
+        if (log_type == "file" || log_type == "json") {
             std::cout << "Log File        : " << log_file << std::endl;
             std::cout << "Flush On Write  : " << (flush_on_write ? "Yes" : "No") << std::endl;
         }
 #ifdef ENABLE_SPDLOG
-        if (log_type == "spdlog-file") {
+        if (log_type == "spdlog-file" || log_type == "spdlog-rotating") {
             std::cout << "Log File        : " << log_file << std::endl;
         }
+        if (log_type == "spdlog-rotating") {
+            std::cout << "Max File Size   : " << max_file_size << " bytes" << std::endl;
+            std::cout << "Max Files       : " << max_files << std::endl;
+        }
 #endif
 #ifdef ENABLE_SPDLOG
-        if (log_type == "spdlog-file" || log_type == "spdlog-console") {
+        if (log_type == "spdlog-file" || log_type == "spdlog-rotating" || log_type == "spdlog-console") {
             std::cout << "Async          : " << (async ? "Yes" : "No") << std::endl;
         }
 #endif 
         std::cout << "Total Logs      : " << log_count << std::endl;
         std::cout << "Thread Count    : " << thread_count << std::endl;
+        if (burst_size > 0) {
+            std::cout << "Burst Size      : " << burst_size << std::endl;
+        }
         std::cout << "Log Level       : " << slog::log_level_name(level) << std::endl;
         std::cout << "========================================" << std::endl;
     }
@@ -117,6 +128,30 @@ std::shared_ptr<slog::Logger> create_logger(TestConfig const & config, bool clea
             config.flush_on_write
         );
     } 
+    else if (config.log_type == "json") 
+    {
+        if (clean_file) {
+            struct stat st;
+            if (stat(config.log_file.c_str(), &st) == 0) {
+                std::remove(config.log_file.c_str());
+            }
+        }
+
+        // JSON Lines 文件logger，不轮转（max_file_size = 0）
+        return slog::make_json_file_logger(
+            "perf_test",
+            config.log_file,
+            config.level,
+            0,
+            1,
+            config.flush_on_write
+        );
+    }
+    else if (config.log_type == "null")
+    {
+        // 只做格式化和分发，输出丢弃，用于测量调用点本身的开销
+        return std::make_shared<slog::Logger>("perf_test", std::make_shared<slog::sink::None>(config.level));
+    }
     #ifdef ENABLE_SPDLOG
     else if (config.log_type == "spdlog-file") 
     {
@@ -137,6 +172,19 @@ std::shared_ptr<slog::Logger> create_logger(TestConfig const & config, bool clea
             config.async
         );
     }
+    else if (config.log_type == "spdlog-rotating") 
+    {
+        // 按大小轮转，用于观察异步模式下轮转带来的开销
+        return slog::make_spdlog_rotating_file_logger(
+            "perf_test",
+            config.log_file,
+            config.level,
+            config.max_file_size,
+            config.max_files,
+            false,
+            config.async
+        );
+    }
     else if (config.log_type == "spdlog-console") 
     {
         return slog::make_spdlog_logger(
@@ -227,6 +275,56 @@ TestResult test_multi_thread(TestConfig const & config)
     return result;
 }
 
+/**
+ * @brief 突发输出测试：每 burst_size 条一批，分别逐条调用 info() 和使用 log_batch()
+ */
+std::vector<TestResult> test_burst(TestConfig const & config)
+{
+    auto logger = create_logger(config);
+    int bursts = config.log_count / config.burst_size;
+    int actual_logs = bursts * config.burst_size;
+
+    std::cout << "\n[Running] Burst Test, " << bursts << " bursts of " << config.burst_size << " lines..." << std::endl;
+
+    auto make_result = [&](std::string const & name, long long duration) {
+        TestResult result;
+        result.test_name = name;
+        result.total_logs = actual_logs;
+        result.thread_count = 1;
+        result.elapsed_ms = duration / 1000.0;
+        result.logs_per_second = (actual_logs * 1000000.0) / duration;
+        result.us_per_log = static_cast<double>(duration) / actual_logs;
+        return result;
+    };
+
+    std::vector<TestResult> results;
+
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int b = 0; b < bursts; ++b) {
+        for (int i = 0; i < config.burst_size; ++i) {
+            logger->info("Burst {} row {}, with some additional text to simulate a table dump", b, i);
+        }
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    results.push_back(make_result("Burst Per-Record",
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()));
+
+    slog::Batch batch;
+    start = std::chrono::high_resolution_clock::now();
+    for (int b = 0; b < bursts; ++b) {
+        for (int i = 0; i < config.burst_size; ++i) {
+            batch.add(slog::LogLevel::Info, "Burst {} row {}, with some additional text to simulate a table dump", b, i);
+        }
+        logger->log_batch(batch);
+        batch.clear();
+    }
+    end = std::chrono::high_resolution_clock::now();
+    results.push_back(make_result("Burst log_batch",
+        std::chrono::duration_cast<std::chrono::microseconds>(end - start).count()));
+
+    return results;
+}
+
 /**
  * @brief 打印使用说明
  */
@@ -234,13 +332,16 @@ void print_usage(const char* prog_name)
 {
     std::cout << "Usage: " << prog_name << " [options]\n\n"
               << "Options:\n"
-              << "  -t, --type <type>        Log type: stdout,file,spdlog-file,spdlog-console (default: stdout)\n"
+              << "  -t, --type <type>        Log type: stdout,file,json,null,spdlog-file,spdlog-rotating,spdlog-console (default: stdout)\n"
               << "  -f, --file <path>        Log file path (default: /tmp/perf_test.log)\n"
               << "  -n, --count <number>     Total number of logs (default: 100000)\n"
               << "  -j, --threads <number>   Number of threads for multi-thread test (default: 1)\n"
               << "  -F, --flush              Enable flush on write for file logger (default: off)\n"
+              << "  -b, --burst <number>     Also compare info() and log_batch() in bursts of <number> lines (default: off)\n"
 #ifdef ENABLE_SPDLOG
               << "  -a, --async              Enable async mode for spdlog (default: off)\n"
+              << "  -s, --max-size <bytes>   Max file size for spdlog-rotating (default: 1048576)\n"
+              << "  -r, --max-files <number> Max rotated files for spdlog-rotating (default: 5)\n"
 #endif 
               << "  -l, --level <level>      Log level: trace/debug/info/warning/error (default: info)\n"
               << "  -h, --help               Show this help message\n\n"
@@ -250,7 +351,9 @@ void print_usage(const char* prog_name)
               << "  # Test file with 100k logs, 4 threads, no flush\n"
               << "  " << prog_name << " -t file -n 100000 -j 4\n\n"
               << "  # Test file with 100k logs, 8 threads, with flush\n"
-              << "  " << prog_name << " -t file -n 100000 -j 8 -F\n\n";
+              << "  " << prog_name << " -t file -n 100000 -j 8 -F\n\n"
+              << "  # Compare per-record logging and log_batch() in 10k-line bursts\n"
+              << "  " << prog_name << " -t file -n 100000 -b 10000\n\n";
 }
 
 /**
@@ -269,16 +372,18 @@ bool parse_args(int argc, char* argv[], TestConfig& config)
             if (i + 1 < argc) {
                 config.log_type = argv[++i];
 #ifdef ENABLE_SPDLOG
-                if (config.log_type != "stdout" && config.log_type != "file" 
-                    && config.log_type != "spdlog-file" && config.log_type != "spdlog-console") {
+                if (config.log_type != "stdout" && config.log_type != "file" && config.log_type != "json"
+                    && config.log_type != "null" && config.log_type != "spdlog-file" && config.log_type != "spdlog-rotating"
+                    && config.log_type != "spdlog-console") {
                     std::cerr << "Error: Invalid log type '" << config.log_type 
-                              << "'. Must be 'stdout', 'file', 'spdlog-file', or 'spdlog-console'." << std::endl;
+                              << "'. Must be 'stdout', 'file', 'json', 'null', 'spdlog-file', 'spdlog-rotating', or 'spdlog-console'." << std::endl;
                     return false;
                 }
 #else
-                if (config.log_type != "stdout" && config.log_type != "file") {
+                if (config.log_type != "stdout" && config.log_type != "file" && config.log_type != "json"
+                    && config.log_type != "null") {
                     std::cerr << "Error: Invalid log type '" << config.log_type 
-                              << "'. Must be 'stdout' or 'file'." << std::endl;
+                              << "'. Must be 'stdout', 'file', 'json' or 'null'." << std::endl;
                     return false;
                 }
 #endif
@@ -319,6 +424,18 @@ bool parse_args(int argc, char* argv[], TestConfig& config)
                 return false;
             }
         }
+        else if (arg == "-b" || arg == "--burst") {
+            if (i + 1 < argc) {
+                config.burst_size = std::atoi(argv[++i]);
+                if (config.burst_size <= 0) {
+                    std::cerr << "Error: Invalid burst size" << std::endl;
+                    return false;
+                }
+            } else {
+                std::cerr << "Error: --burst requires an argument" << std::endl;
+                return false;
+            }
+        }
         else if (arg == "-F" || arg == "--flush") {
             config.flush_on_write = true;
         }
@@ -326,6 +443,32 @@ bool parse_args(int argc, char* argv[], TestConfig& config)
         else if (arg == "-a" || arg == "--async") {
             config.async = true;
         }
+        else if (arg == "-s" || arg == "--max-size") {
+            if (i + 1 < argc) {
+                long long size = std::atoll(argv[++i]);
+                if (size <= 0) {
+                    std::cerr << "Error: Invalid max file size" << std::endl;
+                    return false;
+                }
+                config.max_file_size = static_cast<size_t>(size);
+            } else {
+                std::cerr << "Error: --max-size requires an argument" << std::endl;
+                return false;
+            }
+        }
+        else if (arg == "-r" || arg == "--max-files") {
+            if (i + 1 < argc) {
+                int files = std::atoi(argv[++i]);
+                if (files <= 0) {
+                    std::cerr << "Error: Invalid max files" << std::endl;
+                    return false;
+                }
+                config.max_files = static_cast<size_t>(files);
+            } else {
+                std::cerr << "Error: --max-files requires an argument" << std::endl;
+                return false;
+            }
+        }
 #endif 
         else if (arg == "-l" || arg == "--level") {
             if (i + 1 < argc) {
@@ -394,7 +537,7 @@ int main(int argc, char* argv[])
     config.print();
     
     // 清理旧的日志文件（只在测试开始前清理一次）
-    if (config.log_type == "file" || config.log_type == "spdlog-file") {
+    if (config.log_type == "file" || config.log_type == "json" || config.log_type == "spdlog-file" || config.log_type == "spdlog-rotating") {
         struct stat st;
         if (stat(config.log_file.c_str(), &st) == 0) {
             std::remove(config.log_file.c_str());
@@ -417,8 +560,16 @@ int main(int argc, char* argv[])
             multi_result.print();
         }
         
+        // 突发测试（追加到同一文件）
+        if (config.burst_size > 0 && config.burst_size <= config.log_count) {
+            for (auto const & burst_result : test_burst(config)) {
+                results.push_back(burst_result);
+                burst_result.print();
+            }
+        }
+        
         // 如果是文件日志，验证输出
-        if (config.log_type == "file" || config.log_type == "spdlog-file") {
+        if (config.log_type == "file" || config.log_type == "json" || config.log_type == "spdlog-file") {
             // 确保所有logger都已销毁，文件已关闭
             // 短暂延迟以确保文件系统更新
             std::this_thread::sleep_for(std::chrono::milliseconds(100));
@@ -427,6 +578,9 @@ int main(int argc, char* argv[])
             if (config.thread_count > 1) {
                 total_expected += (config.log_count / config.thread_count) * config.thread_count;
             }
+            if (config.burst_size > 0 && config.burst_size <= config.log_count) {
+                total_expected += 2 * (config.log_count / config.burst_size) * config.burst_size;
+            }
             verify_file_output(config.log_file, total_expected);
         }
         
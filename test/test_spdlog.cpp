@@ -18,8 +18,10 @@
 #include <sys/stat.h>
 #include <unistd.h>
 #include <cstdio>
+#include <stdexcept>
 
 #include <slog/slog.hpp>
+#include <slog/sink_spdlog.hpp>
 
 // Test spdlog console logger (synchronous)
 void test_spdlog_console_sync() {
@@ -206,6 +208,71 @@ void test_spdlog_level_filtering() {
     logger->error("Error message (should appear)");
 }
 
+// Test spdlog rotating file logger (async)
+void test_spdlog_rotating_file_async() {
+    std::cout << "\n=== Test 9: Spdlog Rotating File Logger (Async) ===" << std::endl;
+    
+    std::string filepath = "/tmp/test_spdlog_rotating.log";
+    std::string rotated = "/tmp/test_spdlog_rotating.1.log";
+    std::remove(filepath.c_str());
+    std::remove(rotated.c_str());
+    std::remove("/tmp/test_spdlog_rotating.2.log");
+    
+    {
+        // 4KB 一个文件，保留2个旧文件
+        auto logger = slog::make_spdlog_rotating_file_logger("test_rotating_async", filepath,
+            slog::LogLevel::Info, 4096, 2, false, true);
+        if (!logger) {
+            std::cerr << "ERROR: Failed to create rotating logger!" << std::endl;
+            return;
+        }
+        for (int i = 0; i < 200; ++i) {
+            logger->info("Rotating message {} with some padding text", i);
+        }
+        slog::drop_logger("test_rotating_async");
+    }
+    
+    // Wait a bit for async logger to flush
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    
+    struct stat st;
+    if (stat(rotated.c_str(), &st) == 0) {
+        std::cout << "Rotated file created successfully: " << rotated << std::endl;
+    } else {
+        std::cerr << "ERROR: Rotated file was not created!" << std::endl;
+    }
+}
+
+// Test spdlog daily file logger
+void test_spdlog_daily_file() {
+    std::cout << "\n=== Test 10: Spdlog Daily File Logger ===" << std::endl;
+    
+    auto logger = slog::make_spdlog_daily_file_logger("test_daily", "/tmp/test_spdlog_daily.log",
+        slog::LogLevel::Info, 2, 30, 3);
+    if (!logger) {
+        std::cerr << "ERROR: Failed to create daily logger!" << std::endl;
+        return;
+    }
+    logger->info("This is an info message to daily file");
+
+    // 非法的轮转时间会导致 setup 失败
+    auto bad = slog::make_spdlog_daily_file_logger("test_daily_bad", "/tmp/test_spdlog_daily.log",
+        slog::LogLevel::Info, 25, 0);
+    std::cout << "Invalid rotation time rejected: " << (bad ? "no" : "yes") << std::endl;
+
+    // 超过 uint16_t 的文件数量被拒绝，不会被截断
+    auto too_many = slog::make_spdlog_daily_file_logger("test_daily_many", "/tmp/test_spdlog_daily.log",
+        slog::LogLevel::Info, 2, 30, 70000);
+    if (too_many) {
+        throw std::runtime_error("max_files above 65535 accepted");
+    }
+    auto sink = std::make_shared<slog::sink::Spdlog>(slog::LogLevel::Info, slog::sink::SpdlogSinkType::ToDailyFile,
+        "/tmp/test_spdlog_daily.log", false, 0, 70000);
+    if (sink->setup("test_daily_many")) {
+        throw std::runtime_error("Spdlog::setup() accepted max_files above 65535");
+    }
+}
+
 int main() {
     std::cout << "========================================" << std::endl;
     std::cout << "Spdlog Integration Test" << std::endl;
@@ -220,6 +287,8 @@ int main() {
         test_spdlog_async_multithreaded();
         test_spdlog_clone();
         test_spdlog_level_filtering();
+        test_spdlog_rotating_file_async();
+        test_spdlog_daily_file();
         
         std::cout << "\n========================================" << std::endl;
         std::cout << "All tests completed successfully!" << std::endl;
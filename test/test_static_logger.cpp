@@ -0,0 +1,158 @@
+/**
+ * @file test_static_logger.cpp
+ * @author LiuChuansen (179712066@qq.com)
+ * @brief 测试 StaticLogger：规则等级、多sink输出，以及与动态 Logger 的性能对比
+ * @version 0.1
+ * @date 2026-10-17
+ * 
+ * @copyright Copyright (c) 2026
+ * 
+ */
+
+#include <iostream>
+#include <fstream>
+#include <chrono>
+#include <iomanip>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+#include <slog/slog.hpp>
+#include <slog/static_logger.hpp>
+
+static int count_lines(std::string const & path)
+{
+    std::ifstream file(path);
+    std::string line;
+    int count = 0;
+    while (std::getline(file, line)) {
+        count++;
+    }
+    return count;
+}
+
+void test_static_rules()
+{
+    std::cout << "\n=== Test 1: StaticLogger Level Rules ===" << std::endl;
+
+    // 规则先于 logger 创建
+    slog::set_logger_level("static_*", slog::LogLevel::Debug);
+
+    slog::StaticLogger<slog::sink::StaticStdout> logger("static_rules",
+        slog::sink::StaticStdout(slog::LogLevel::Warning));
+
+    std::cout << "Level from rule: " << slog::log_level_name(logger.get_level()) << " (expected DEBUG)" << std::endl;
+    logger.trace("Trace message (should not appear)");
+    logger.debug("Debug message (should appear)");
+
+    // 规则在 logger 创建之后修改
+    slog::set_logger_level("static_rules", slog::LogLevel::Error);
+    std::cout << "Level after rule: " << slog::log_level_name(logger.get_level()) << " (expected ERROR)" << std::endl;
+    logger.warning("Warning message (should not appear)");
+    logger.error("Error message (should appear)");
+
+    bool listed = false;
+    for (auto const & name : slog::get_logger_list()) {
+        if (name == "static_rules") {
+            listed = true;
+        }
+    }
+    std::cout << "Listed in get_logger_list(): " << (listed ? "yes" : "no") << std::endl;
+
+    slog::clear_logger_rules();
+}
+
+void test_static_multi_sink()
+{
+    std::cout << "\n=== Test 2: StaticLogger Multiple Sinks ===" << std::endl;
+
+    const std::string path = "/tmp/test_static_logger.log";
+    std::remove(path.c_str());
+
+    {
+        slog::StaticLogger<slog::sink::StaticStdout, slog::sink::StaticFile> logger("static_multi",
+            slog::sink::StaticStdout(slog::LogLevel::Warning),
+            slog::sink::StaticFile(slog::LogLevel::Debug, path, 0, 1, true));
+
+        logger.debug("Debug {} (file only)", 1);
+        logger.info("Info {} (file only)", 2);
+        logger.warning("Warning {} (stdout and file)", 3);
+    }
+
+    int lines = count_lines(path);
+    std::cout << "File lines: " << lines << " (expected 3)" << std::endl;
+    if (lines != 3) {
+        std::cerr << "ERROR: unexpected line count" << std::endl;
+        std::exit(1);
+    }
+}
+
+template<typename Func>
+double measure_us(int count, Func && func)
+{
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int i = 0; i < count; ++i) {
+        func(i);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    return static_cast<double>(std::chrono::duration_cast<std::chrono::microseconds>(end - start).count());
+}
+
+void print_result(char const * name, int count, double us)
+{
+    std::cout << std::left << std::setw(28) << name
+              << std::right << std::fixed << std::setprecision(0) << std::setw(12) << (count * 1000000.0 / us) << " logs/sec"
+              << std::setprecision(3) << std::setw(10) << (us / count) << " us/log" << std::endl;
+}
+
+void bench_static_vs_dynamic(int count)
+{
+    std::cout << "\n=== Benchmark: StaticLogger vs Logger (" << count << " logs) ===" << std::endl;
+
+    const std::string dynamic_path = "/tmp/bench_dynamic_logger.log";
+    const std::string static_path = "/tmp/bench_static_logger.log";
+    std::remove(dynamic_path.c_str());
+    std::remove(static_path.c_str());
+
+    auto dynamic_logger = slog::make_file_logger("bench_dynamic", dynamic_path, slog::LogLevel::Info, false, false);
+    slog::StaticLogger<slog::sink::StaticFile> static_logger("bench_static",
+        slog::sink::StaticFile(slog::LogLevel::Info, static_path, 0, 1, false));
+
+    double dynamic_us = measure_us(count, [&](int i) {
+        dynamic_logger->info("Benchmark message {} value {:.3f} tag {}", i, i * 0.5, "dynamic");
+    });
+    double static_us = measure_us(count, [&](int i) {
+        static_logger.info("Benchmark message {} value {:.3f} tag {}", i, i * 0.5, "static");
+    });
+
+    // 被过滤的日志：动态 logger 只做等级检查，静态 logger 可被完全内联
+    double dynamic_filtered_us = measure_us(count, [&](int i) {
+        dynamic_logger->debug("Filtered message {}", i);
+    });
+    double static_filtered_us = measure_us(count, [&](int i) {
+        static_logger.debug("Filtered message {}", i);
+    });
+
+    print_result("Logger (file)", count, dynamic_us);
+    print_result("StaticLogger (file)", count, static_us);
+    print_result("Logger (filtered)", count, dynamic_filtered_us);
+    print_result("StaticLogger (filtered)", count, static_filtered_us);
+}
+
+int main(int argc, char * argv[])
+{
+    int count = 200000;
+    if (argc > 1) {
+        count = std::atoi(argv[1]);
+        if (count <= 0) {
+            count = 200000;
+        }
+    }
+
+    test_static_rules();
+    test_static_multi_sink();
+    bench_static_vs_dynamic(count);
+
+    std::cout << "\nAll tests completed!" << std::endl;
+    return 0;
+}
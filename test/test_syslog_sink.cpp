@@ -0,0 +1,174 @@
+/**
+ * @file test_syslog_sink.cpp
+ * @brief 测试 Syslog sink：用临时 Unix 数据报套接字模拟 syslog 守护进程
+ */
+
+#include <iostream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <stdexcept>
+#include <cstring>
+#include <cstdio>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <slog/slog.hpp>
+#include <slog/sink_syslog.hpp>
+
+#include "test_util.hpp"
+
+namespace {
+
+using slog_test::expect;
+
+const char *kSocketPath = "/tmp/test_slog_syslog.sock";
+
+/// 模拟守护进程：绑定到临时路径的数据报套接字
+class FakeDaemon
+{
+public:
+    FakeDaemon()
+    {
+        unlink(kSocketPath);
+        fd_ = socket(AF_UNIX, SOCK_DGRAM, 0);
+        struct sockaddr_un addr;
+        std::memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        std::strncpy(addr.sun_path, kSocketPath, sizeof(addr.sun_path) - 1);
+        if (fd_ < 0 || bind(fd_, reinterpret_cast<struct sockaddr *>(&addr), sizeof(addr)) != 0) {
+            throw std::runtime_error("bind fake syslog socket failed");
+        }
+        struct timeval tv = {1, 0};
+        setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+    }
+
+    ~FakeDaemon()
+    {
+        close(fd_);
+        unlink(kSocketPath);
+    }
+
+    /// 接收一个数据报，超时返回空字符串
+    std::string receive()
+    {
+        char buf[16384];
+        ssize_t size = recv(fd_, buf, sizeof(buf), 0);
+        return (size > 0) ? std::string(buf, static_cast<size_t>(size)) : std::string();
+    }
+
+private:
+    int fd_;
+};
+
+} // namespace
+
+void test_rfc3164()
+{
+    std::cout << "=== Test: RFC 3164 datagrams ===" << std::endl;
+    FakeDaemon daemon;
+
+    auto sink = std::make_shared<slog::sink::Syslog>(slog::LogLevel::Debug, "slogtest",
+        slog::sink::SyslogFacility::Local0, slog::sink::SyslogFormat::Rfc3164, kSocketPath);
+    auto logger = slog::make_logger("syslog3164", sink);
+
+    logger->info("hello {}", 1);
+    logger->error("request failed", slog::kv("code", 503));
+    logger->trace("filtered");
+
+    std::string info = daemon.receive();
+    std::string error = daemon.receive();
+    std::cout << info << std::endl << error << std::endl;
+
+    // local0 = 16: info = 16*8+6 = 134, err = 16*8+3 = 131
+    std::string pid = "[" + std::to_string(getpid()) + "]: ";
+    expect(info.compare(0, 5, "<134>") == 0, "info priority");
+    expect(info.find(" slogtest" + pid + "(syslog3164) hello 1") != std::string::npos, "info layout");
+    expect(error.compare(0, 5, "<131>") == 0, "error priority");
+    expect(error.find("(syslog3164) request failed code=503") != std::string::npos, "fields");
+    expect(sink->dropped() == 0, "no drops");
+}
+
+void test_rfc5424()
+{
+    std::cout << "=== Test: RFC 5424 datagrams ===" << std::endl;
+    FakeDaemon daemon;
+
+    auto sink = std::make_shared<slog::sink::Syslog>(slog::LogLevel::Info, "slogtest",
+        slog::sink::SyslogFacility::User, slog::sink::SyslogFormat::Rfc5424, kSocketPath);
+    auto logger = slog::make_logger("syslog 5424", sink);
+    logger->warning("disk almost full");
+
+    std::string msg = daemon.receive();
+    std::cout << msg << std::endl;
+
+    // user = 1: warning = 8+4 = 12
+    expect(msg.compare(0, 6, "<12>1 ") == 0, "5424 priority/version");
+    expect(msg[16] == 'T', "5424 timestamp");
+    expect(msg.find(" slogtest " + std::to_string(getpid()) + " syslog_5424 - disk almost full") != std::string::npos,
+        "5424 header fields");
+}
+
+void test_batch_and_drop()
+{
+    std::cout << "=== Test: concurrent batching and EAGAIN drops ===" << std::endl;
+    FakeDaemon daemon;
+
+    auto sink = std::make_shared<slog::sink::Syslog>(slog::LogLevel::Info, "slogtest",
+        slog::sink::SyslogFacility::User, slog::sink::SyslogFormat::Rfc3164, kSocketPath);
+    auto logger = slog::make_logger("syslog_burst", sink);
+
+    // 守护进程不接收，接收队列满后发送返回 EAGAIN，消息被丢弃而不是阻塞
+    const int threads = 4;
+    const int per_thread = 2000;
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&logger, t]() {
+            for (int i = 0; i < per_thread; ++i) {
+                logger->info("burst {} {}", t, i);
+            }
+        });
+    }
+    for (auto & worker : workers) {
+        worker.join();
+    }
+
+    int received = 0;
+    while (!daemon.receive().empty()) {
+        received++;
+    }
+    std::cout << "received: " << received << ", dropped: " << sink->dropped() << std::endl;
+    expect(sink->dropped() > 0, "queue overflow should be counted");
+    expect(received + sink->dropped() == static_cast<uint64_t>(threads * per_thread), "every message sent or counted");
+}
+
+void test_daemon_unavailable()
+{
+    std::cout << "=== Test: daemon unavailable ===" << std::endl;
+    unlink(kSocketPath);
+
+    auto sink = std::make_shared<slog::sink::Syslog>(slog::LogLevel::Info, "slogtest",
+        slog::sink::SyslogFacility::User, slog::sink::SyslogFormat::Rfc3164, kSocketPath);
+    auto logger = slog::make_logger("syslog_missing", sink);
+    expect(logger->is_valid(), "logger stays valid without daemon");
+
+    logger->info("nobody listens");
+    expect(sink->dropped() == 1, "message dropped while daemon is missing");
+}
+
+int main()
+{
+    try {
+        test_rfc3164();
+        test_rfc5424();
+        test_batch_and_drop();
+        test_daemon_unavailable();
+    } catch (std::exception const & e) {
+        std::cerr << "Test failed: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << "All syslog sink tests passed" << std::endl;
+    return 0;
+}
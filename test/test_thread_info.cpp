@@ -0,0 +1,134 @@
+/**
+ * @file test_thread_info.cpp
+ * @brief 测试线程 id/名称：按线程缓存、set_thread_name() 同步 pthread 名称、日志行及 JSON 输出、Isolated sink 保留调用线程
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <slog/slog.hpp>
+#include <slog/sink_file.hpp>
+#include <slog/sink_isolated.hpp>
+#include <slog/sink_json_file.hpp>
+
+#include "test_util.hpp"
+
+namespace {
+
+using slog_test::expect;
+using slog_test::read_lines;
+
+std::string gettid_text()
+{
+    return std::to_string(static_cast<long>(::syscall(SYS_gettid)));
+}
+
+} // namespace
+
+void test_header(std::string const & path)
+{
+    std::cout << "=== Test: thread id and name in the header ===" << std::endl;
+    std::remove(path.c_str());
+    auto logger = slog::make_logger("thread_header", std::make_shared<slog::sink::File>(slog::LogLevel::Info, path, 0, 1));
+
+    logger->info("off by default");
+    slog::set_log_thread(true);
+    logger->info("main thread");
+
+    std::string worker_tid;
+    std::string pthread_name;
+    std::thread worker([&]() {
+        worker_tid = gettid_text();
+        slog::set_thread_name("worker-1");
+        char name[16] = {0};
+        pthread_getname_np(pthread_self(), name, sizeof(name));
+        pthread_name = name;
+        logger->info("named thread");
+        slog::set_thread_name("a-very-long-thread-name-over-31-bytes");
+        logger->info("long name");
+    });
+    worker.join();
+    slog::set_log_thread(false);
+    slog::drop_logger("thread_header");
+
+    auto lines = read_lines(path);
+    for (auto const & line : lines) {
+        std::cout << line << std::endl;
+    }
+    expect(lines.size() == 4, "four lines");
+    expect(lines[0].find("(thread_header) off by default") != std::string::npos, "no thread by default");
+    expect(lines[1].find("(thread_header) [" + gettid_text() + "] main thread") != std::string::npos, "main thread id");
+    expect(lines[2].find("(thread_header) [" + worker_tid + ":worker-1] named thread") != std::string::npos, "worker id and name");
+    expect(lines[3].find("[" + worker_tid + ":a-very-long-thread-name-over-31] long name") != std::string::npos,
+           "name kept to 31 bytes");
+    expect(pthread_name == "worker-1", "pthread name set: " + pthread_name);
+}
+
+void test_isolated_json(std::string const & path)
+{
+    std::cout << "=== Test: isolated json sink reports the calling thread ===" << std::endl;
+    std::remove(path.c_str());
+    auto isolated = std::make_shared<slog::sink::Isolated>(std::make_shared<slog::sink::JsonFile>(slog::LogLevel::Info, path, 0, 1), 16);
+    auto logger = slog::make_logger("thread_json", isolated);
+
+    std::string worker_tid;
+    std::thread worker([&]() {
+        worker_tid = gettid_text();
+        slog::set_thread_name("rpc \"io\"");
+        logger->info("from worker");
+    });
+    worker.join();
+    logger->info("from main");
+    isolated->flush();
+    slog::drop_logger("thread_json");
+
+    auto lines = read_lines(path);
+    for (auto const & line : lines) {
+        std::cout << line << std::endl;
+    }
+    expect(lines.size() == 2, "two records");
+    expect(lines[0].find("\"thread\":" + worker_tid + ",\"thread_name\":\"rpc \\\"io\\\"\",\"msg\"") != std::string::npos,
+           "caller id and escaped name");
+    expect(lines[1].find("\"thread\":" + gettid_text() + ",\"msg\"") != std::string::npos, "unnamed main thread");
+}
+
+void bench_capture()
+{
+    std::cout << "=== Capture cost ===" << std::endl;
+    constexpr int kRounds = 10000000;
+    uint64_t sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int n = 0; n < kRounds; ++n) {
+        sum += slog::detail::record_thread().id;
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+    std::printf("  record_thread() %.2f ns/call (%llu)\n", static_cast<double>(elapsed) / kRounds,
+                static_cast<unsigned long long>(sum & 1));
+}
+
+int main()
+{
+    std::string path = "/tmp/slog_test_thread_info_" + std::to_string(getpid()) + ".log";
+    try {
+        test_header(path);
+        test_isolated_json(path);
+        bench_capture();
+    } catch (std::exception const & e) {
+        std::cerr << "Test failed: " << e.what() << std::endl;
+        std::remove(path.c_str());
+        return 1;
+    }
+    std::remove(path.c_str());
+
+    std::cout << "All thread info tests passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,219 @@
+/**
+ * @file test_timestamp.cpp
+ * @brief 测试时间戳精度与时钟：微秒/纳秒、单调时钟、TSC 换算，以及 Isolated sink 保留入队时的时间
+ */
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+#include <slog/slog.hpp>
+#include <slog/sink_file.hpp>
+#include <slog/sink_isolated.hpp>
+
+#include "test_util.hpp"
+
+namespace {
+
+using slog_test::expect;
+using slog_test::read_lines;
+
+int64_t now_ns(bool monotonic)
+{
+    auto since = monotonic ? std::chrono::steady_clock::now().time_since_epoch()
+                           : std::chrono::system_clock::now().time_since_epoch();
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(since).count();
+}
+
+/// "YYYY-mm-dd HH:MM:SS.f..." 转为 epoch 纳秒，digits 为小数位数
+int64_t wall_ns(std::string const & line, int digits)
+{
+    std::tm tm;
+    std::memset(&tm, 0, sizeof(tm));
+    int n = std::sscanf(line.c_str(), "%d-%d-%d %d:%d:%d.",
+        &tm.tm_year, &tm.tm_mon, &tm.tm_mday, &tm.tm_hour, &tm.tm_min, &tm.tm_sec);
+    expect(n == 6, "wall clock timestamp: " + line);
+    expect(line.size() > static_cast<size_t>(20 + digits) && line[20 + digits] == ' ', "fraction digits: " + line);
+    tm.tm_year -= 1900;
+    tm.tm_mon -= 1;
+    tm.tm_isdst = -1;
+    int64_t frac = std::atoll(line.substr(20, static_cast<size_t>(digits)).c_str());
+    for (int i = digits; i < 9; ++i) {
+        frac *= 10;
+    }
+    return static_cast<int64_t>(std::mktime(&tm)) * 1000000000 + frac;
+}
+
+/// 用给定配置写一行日志，返回该行
+std::string log_one(slog::TimestampOptions const & options, std::string const & path)
+{
+    std::remove(path.c_str());
+    slog::set_timestamp_options(options);
+    auto logger = slog::make_logger("ts_test", std::make_shared<slog::sink::File>(slog::LogLevel::Info, path, 0, 1));
+    logger->info("stamped");
+    slog::drop_logger("ts_test");
+    auto lines = read_lines(path);
+    expect(lines.size() == 1, "one line written");
+    std::cout << lines[0] << std::endl;
+    return lines[0];
+}
+
+void restore_defaults()
+{
+    slog::set_timestamp_options(slog::TimestampOptions());
+}
+
+} // namespace
+
+void test_precision(std::string const & path)
+{
+    std::cout << "=== Test: milli/micro/nano precision ===" << std::endl;
+    slog::TimestampOptions options;
+    const int digits[] = {3, 6, 9};
+    const slog::TimestampPrecision precisions[] = {
+        slog::TimestampPrecision::Milli, slog::TimestampPrecision::Micro, slog::TimestampPrecision::Nano};
+    for (int i = 0; i < 3; ++i) {
+        options.precision = precisions[i];
+        int64_t before = now_ns(false);
+        std::string line = log_one(options, path);
+        int64_t after = now_ns(false);
+        int64_t stamped = wall_ns(line, digits[i]);
+        expect(stamped <= after && stamped >= before - 1000000, "timestamp within the call");
+        expect(line.find(" <INFO> (ts_test) stamped") != std::string::npos, "header after the timestamp");
+    }
+
+    // 无效的精度被忽略，保持之前的 Nano
+    options.precision = static_cast<slog::TimestampPrecision>(42);
+    slog::set_timestamp_options(options);
+    expect(slog::get_timestamp_options().precision == slog::TimestampPrecision::Nano, "invalid precision rejected");
+    std::string line = log_one(options, path);
+    expect(line.find(" <INFO>") == 29, "still nine fraction digits");
+    restore_defaults();
+}
+
+void test_monotonic(std::string const & path)
+{
+    std::cout << "=== Test: monotonic clock ===" << std::endl;
+    slog::TimestampOptions options;
+    options.clock = slog::TimestampClock::Monotonic;
+    options.precision = slog::TimestampPrecision::Micro;
+    int64_t before = now_ns(true);
+    std::string line = log_one(options, path);
+    int64_t after = now_ns(true);
+
+    size_t dot = line.find('.');
+    expect(dot != std::string::npos && dot > 0 && line[dot + 7] == ' ', "seconds.micro: " + line);
+    int64_t stamped = std::atoll(line.substr(0, dot).c_str()) * 1000000000 + std::atoll(line.substr(dot + 1, 6).c_str()) * 1000;
+    expect(stamped >= before - 1000 && stamped <= after, "monotonic timestamp within the call");
+    restore_defaults();
+}
+
+void test_tsc(std::string const & path)
+{
+    std::cout << "=== Test: TSC converted to wall clock ===" << std::endl;
+    slog::TimestampOptions options;
+    options.clock = slog::TimestampClock::Tsc;
+    options.precision = slog::TimestampPrecision::Micro;
+    slog::set_timestamp_options(options);
+    expect(slog::get_timestamp_options().clock == slog::TimestampClock::Tsc, "option stored");
+
+    int64_t before = now_ns(false);
+    std::string line = log_one(options, path);
+    int64_t after = now_ns(false);
+    int64_t stamped = wall_ns(line, 6);
+    // 换算误差来自 20ms 的频率校准，允许 2ms
+    expect(stamped >= before - 2000000 && stamped <= after + 2000000, "TSC time close to the system time");
+    restore_defaults();
+}
+
+/// 输出前等待的 File sink，模拟慢 sink
+class SlowFile : public slog::sink::File
+{
+public:
+    using File::File;
+
+protected:
+    void output(const std::string & logger_name, slog::LogLevel level, std::string const & msg) override
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+        File::output(logger_name, level, msg);
+    }
+};
+
+void test_isolated_keeps_capture_time(std::string const & path)
+{
+    std::cout << "=== Test: isolated sink formats the enqueue time ===" << std::endl;
+    std::remove(path.c_str());
+    slog::TimestampOptions options;
+    options.clock = slog::TimestampClock::Tsc;
+    options.precision = slog::TimestampPrecision::Micro;
+    slog::set_timestamp_options(options);
+
+    auto isolated = std::make_shared<slog::sink::Isolated>(std::make_shared<SlowFile>(slog::LogLevel::Info, path, 0, 1), 16);
+    auto logger = slog::make_logger("ts_isolated", isolated);
+    logger->info("first");
+    logger->info("second");
+    isolated->flush();
+    slog::drop_logger("ts_isolated");
+
+    auto lines = read_lines(path);
+    expect(lines.size() == 2, "two lines written");
+    int64_t gap = wall_ns(lines[1], 6) - wall_ns(lines[0], 6);
+    std::cout << "gap between records: " << gap / 1000 << " us" << std::endl;
+    // 工作线程间隔 100ms 输出两条记录，时间戳仍是调用时刻
+    expect(gap >= 0 && gap < 50000000, "timestamps taken by the caller");
+    restore_defaults();
+}
+
+void bench_capture()
+{
+    std::cout << "=== Capture cost ===" << std::endl;
+    const slog::TimestampClock clocks[] = {
+        slog::TimestampClock::Realtime, slog::TimestampClock::Monotonic, slog::TimestampClock::Tsc};
+    const char *names[] = {"realtime", "monotonic", "tsc"};
+    constexpr int kRounds = 2000000;
+    for (int i = 0; i < 3; ++i) {
+        slog::TimestampOptions options;
+        options.clock = clocks[i];
+        slog::set_timestamp_options(options);
+        uint64_t sum = 0;
+        auto start = std::chrono::steady_clock::now();
+        for (int n = 0; n < kRounds; ++n) {
+            sum += slog::detail::capture_timestamp().ticks;
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+        std::printf("  %-10s %.1f ns/capture (%llu)\n", names[i], static_cast<double>(elapsed) / kRounds,
+                    static_cast<unsigned long long>(sum & 1));
+    }
+    restore_defaults();
+}
+
+int main()
+{
+    std::string path = "/tmp/slog_test_timestamp_" + std::to_string(getpid()) + ".log";
+    try {
+        test_precision(path);
+        test_monotonic(path);
+        test_tsc(path);
+        test_isolated_keeps_capture_time(path);
+        bench_capture();
+    } catch (std::exception const & e) {
+        std::cerr << "Test failed: " << e.what() << std::endl;
+        std::remove(path.c_str());
+        return 1;
+    }
+    std::remove(path.c_str());
+
+    std::cout << "All timestamp tests passed" << std::endl;
+    return 0;
+}
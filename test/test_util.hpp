@@ -0,0 +1,48 @@
+/**
+ * @file test_util.hpp
+ * @brief 各测试程序共用的断言和文件读取辅助函数
+ */
+
+#ifndef __SLOG_TEST_UTIL_H__
+#define __SLOG_TEST_UTIL_H__
+
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace slog_test {
+
+/// 条件不成立时抛出 std::runtime_error，由各测试的 main() 统一捕获
+inline void expect(bool condition, std::string const & what)
+{
+    if (!condition) {
+        throw std::runtime_error(what);
+    }
+}
+
+/// 按行读取文件，文件不存在时返回空列表
+inline std::vector<std::string> read_lines(std::string const & path)
+{
+    std::ifstream file(path);
+    std::vector<std::string> lines;
+    std::string line;
+    while (std::getline(file, line)) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+/// 读取整个文件内容（二进制方式）
+inline std::string read_file(std::string const & path)
+{
+    std::ifstream file(path, std::ios::binary);
+    std::ostringstream content;
+    content << file.rdbuf();
+    return content.str();
+}
+
+} // namespace slog_test
+
+#endif // __SLOG_TEST_UTIL_H__
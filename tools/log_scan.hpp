@@ -0,0 +1,299 @@
+#ifndef __SLOG_TOOLS_LOG_SCAN_H__
+#define __SLOG_TOOLS_LOG_SCAN_H__
+
+/**
+ * @file log_scan.hpp
+ * @author LiuChuansen (179712066@qq.com)
+ * @brief 命令行工具共用的日志文件读取工具：mmap、轮转文件集合、行首时间戳、记录边界和子串查找
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * File sink 的日志行格式为 "YYYY-mm-dd HH:MM:SS.mmm <LEVEL> (logger) message"（见 File::append_header()），
+ * 多行消息的后续行没有时间戳。这里把带时间戳的行及其后续行合称为一条记录。
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace slog {
+namespace tools {
+
+/// 行首时间戳 "YYYY-mm-dd HH:MM:SS.mmm" 的长度
+constexpr size_t kStampSize = 23;
+
+/// 时间戳之后 "<LEVEL>" 中 '<' 的最大位置（微秒、纳秒精度多 3 或 6 位小数）
+constexpr size_t kMaxLevelPos = kStampSize + 7;
+
+/// 只读映射的文件
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    MappedFile(MappedFile const &) = delete;
+    MappedFile & operator=(MappedFile const &) = delete;
+
+    ~MappedFile()
+    {
+        if (data_ != nullptr) {
+            munmap(const_cast<char *>(data_), size_);
+        }
+    }
+
+    /// 打开并映射文件，空文件成功但 data() 为 nullptr
+    bool open(std::string const & path)
+    {
+        int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+        if (fd < 0) {
+            return false;
+        }
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            close(fd);
+            return false;
+        }
+        size_ = static_cast<size_t>(st.st_size);
+        if (size_ > 0) {
+            void *addr = mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (addr == MAP_FAILED) {
+                close(fd);
+                return false;
+            }
+            data_ = static_cast<const char *>(addr);
+        }
+        close(fd);
+        return true;
+    }
+
+    /// 提示内核 [offset, offset + len) 将被顺序读取
+    void advise_sequential(size_t offset, size_t len) const
+    {
+        if (data_ == nullptr || len == 0) {
+            return;
+        }
+        size_t page = static_cast<size_t>(getpagesize());
+        size_t start = offset & ~(page - 1);
+        madvise(const_cast<char *>(data_) + start, offset + len - start, MADV_SEQUENTIAL);
+    }
+
+    const char *data() const { return data_; }
+    size_t size() const { return size_; }
+
+private:
+    const char *data_ = nullptr;
+    size_t size_ = 0;
+};
+
+/**
+ * @brief 一个日志文件及其轮转文件，按时间从旧到新排列
+ *
+ * "app.log" 展开为已存在的 "app.log.N" ... "app.log.1"、"app.log"
+ */
+inline std::vector<std::string> rotation_set(std::string const & path)
+{
+    std::vector<std::string> files;
+    struct stat st;
+    for (int i = 1; stat((path + "." + std::to_string(i)).c_str(), &st) == 0; ++i) {
+        files.insert(files.begin(), path + "." + std::to_string(i));
+    }
+    files.push_back(path);
+    return files;
+}
+
+/// 文本格式的行是否以时间戳开头
+inline bool has_stamp(const char *line, size_t len)
+{
+    return len >= kStampSize &&
+        line[4] == '-' && line[7] == '-' && line[10] == ' ' && line[13] == ':' && line[16] == ':' && line[19] == '.' &&
+        static_cast<unsigned>(line[0] - '0') < 10 && static_cast<unsigned>(line[22] - '0') < 10;
+}
+
+/// 文本格式中 "<LEVEL>" 的 '<' 的位置，不是日志行头部时返回 0；line 必须已通过 has_stamp() 检查
+inline size_t level_pos(const char *line, size_t len)
+{
+    size_t pos = kStampSize;
+    while (pos < len && pos + 1 < kMaxLevelPos && static_cast<unsigned>(line[pos] - '0') < 10) {
+        ++pos;
+    }
+    return (pos + 1 < len && line[pos] == ' ' && line[pos + 1] == '<') ? pos + 1 : 0;
+}
+
+/**
+ * @brief 取出行首的时间戳，统一为 "YYYY-mm-dd HH:MM:SS.mmm"
+ *
+ * 支持 File 的文本行和 JsonFile 的 {"ts":"YYYY-mm-ddTHH:MM:SS.mmm",...}
+ *
+ * @return false 行首没有时间戳（如多行消息的后续行）
+ */
+inline bool line_stamp(const char *line, size_t len, char stamp[kStampSize])
+{
+    static const char kJsonPrefix[] = "{\"ts\":\"";
+    constexpr size_t kJsonPrefixSize = sizeof(kJsonPrefix) - 1;
+    if (len >= kJsonPrefixSize && std::memcmp(line, kJsonPrefix, kJsonPrefixSize) == 0) {
+        line += kJsonPrefixSize;
+        len -= kJsonPrefixSize;
+        if (len < kStampSize || line[10] != 'T') {
+            return false;
+        }
+        std::memcpy(stamp, line, kStampSize);
+        stamp[10] = ' ';
+        return has_stamp(stamp, kStampSize);
+    }
+    if (!has_stamp(line, len)) {
+        return false;
+    }
+    std::memcpy(stamp, line, kStampSize);
+    return true;
+}
+
+/**
+ * @brief 按固定位置把时间戳转换为可比较的整数 YYYYmmddHHMMSSmmm
+ *
+ * 不做日历换算，只用于比较先后；stamp 必须已通过 has_stamp() 检查
+ */
+inline uint64_t stamp_key(const char *stamp)
+{
+    // 各字段的起始位置和位数："YYYY-mm-dd HH:MM:SS.mmm"
+    static const unsigned char kFields[][2] = {{0, 4}, {5, 2}, {8, 2}, {11, 2}, {14, 2}, {17, 2}, {20, 3}};
+    uint64_t key = 0;
+    for (auto const & field : kFields) {
+        for (unsigned i = 0; i < field[1]; ++i) {
+            key = key * 10 + static_cast<unsigned>(stamp[field[0] + i] - '0');
+        }
+    }
+    return key;
+}
+
+/// 下一行的开头（p 所在行之后），没有时返回 end
+inline const char *next_line(const char *p, const char *end)
+{
+    const char *eol = static_cast<const char *>(std::memchr(p, '\n', static_cast<size_t>(end - p)));
+    return (eol != nullptr) ? eol + 1 : end;
+}
+
+/// p 所在行的开头
+inline const char *line_start(const char *p, const char *begin)
+{
+    while (p > begin && p[-1] != '\n') {
+        --p;
+    }
+    return p;
+}
+
+/// 行首是否为一条记录的开始（文本或 JSON 格式的时间戳）
+inline bool is_record_start(const char *line, size_t len)
+{
+    char stamp[kStampSize];
+    return has_stamp(line, len) || line_stamp(line, len, stamp);
+}
+
+/// 从 p 所在行之后（p 为行首时包括该行）找到下一条记录的开头，没有时返回 end
+inline const char *next_record(const char *p, const char *begin, const char *end)
+{
+    if (p > begin && p[-1] != '\n') {
+        p = next_line(p, end);
+    }
+    while (p < end && !is_record_start(p, static_cast<size_t>(end - p))) {
+        p = next_line(p, end);
+    }
+    return p;
+}
+
+/// 包含 p 的记录的开头；begin 之后没有带时间戳的行时返回 begin
+inline const char *record_start(const char *p, const char *begin, const char *end)
+{
+    p = line_start(p, begin);
+    while (p > begin && !is_record_start(p, static_cast<size_t>(end - p))) {
+        p = line_start(p - 1, begin);
+    }
+    return p;
+}
+
+/**
+ * @brief 子串查找
+ *
+ * 支持 SSE2/NEON 时每次比较 16 个位置的首尾字节，只对首尾都相同的位置做完整比较；
+ * 日志文本中首尾字节同时命中的位置很少，比逐字节查找快得多。
+ *
+ * @return 第一次出现的位置，没有时返回 nullptr
+ */
+inline const char *find_substring(const char *hay, size_t size, const char *needle, size_t len)
+{
+    if (len == 0) {
+        return hay;
+    }
+    if (len > size) {
+        return nullptr;
+    }
+    if (len == 1) {
+        return static_cast<const char *>(std::memchr(hay, needle[0], size));
+    }
+
+    size_t i = 0;
+    size_t const last = size - len;    // 最后一个可能的起始位置
+#if defined(__SSE2__)
+    const __m128i first_byte = _mm_set1_epi8(needle[0]);
+    const __m128i last_byte = _mm_set1_epi8(needle[len - 1]);
+    for (; i + 16 <= last + 1; i += 16) {
+        __m128i head = _mm_loadu_si128(reinterpret_cast<const __m128i *>(hay + i));
+        __m128i tail = _mm_loadu_si128(reinterpret_cast<const __m128i *>(hay + i + len - 1));
+        unsigned mask = static_cast<unsigned>(_mm_movemask_epi8(
+            _mm_and_si128(_mm_cmpeq_epi8(head, first_byte), _mm_cmpeq_epi8(tail, last_byte))));
+        while (mask != 0) {
+            unsigned bit = static_cast<unsigned>(__builtin_ctz(mask));
+            if (std::memcmp(hay + i + bit + 1, needle + 1, len - 2) == 0) {
+                return hay + i + bit;
+            }
+            mask &= mask - 1;
+        }
+    }
+#elif defined(__aarch64__) && defined(__ARM_NEON)
+    const uint8x16_t first_byte = vdupq_n_u8(static_cast<uint8_t>(needle[0]));
+    const uint8x16_t last_byte = vdupq_n_u8(static_cast<uint8_t>(needle[len - 1]));
+    for (; i + 16 <= last + 1; i += 16) {
+        uint8x16_t head = vld1q_u8(reinterpret_cast<const uint8_t *>(hay + i));
+        uint8x16_t tail = vld1q_u8(reinterpret_cast<const uint8_t *>(hay + i + len - 1));
+        uint8x16_t hit = vandq_u8(vceqq_u8(head, first_byte), vceqq_u8(tail, last_byte));
+        if (vmaxvq_u8(hit) == 0) {
+            continue;
+        }
+        // 块内有候选位置，逐个确认
+        for (size_t k = 0; k < 16; ++k) {
+            if (hay[i + k] == needle[0] && std::memcmp(hay + i + k + 1, needle + 1, len - 1) == 0) {
+                return hay + i + k;
+            }
+        }
+    }
+#endif
+
+    for (; i <= last; ++i) {
+        const char *p = static_cast<const char *>(std::memchr(hay + i, needle[0], last + 1 - i));
+        if (p == nullptr) {
+            return nullptr;
+        }
+        i = static_cast<size_t>(p - hay);
+        if (std::memcmp(p + 1, needle + 1, len - 1) == 0) {
+            return p;
+        }
+    }
+    return nullptr;
+}
+
+} // namespace tools
+} // namespace slog
+
+#endif // __SLOG_TOOLS_LOG_SCAN_H__
@@ -0,0 +1,223 @@
+/**
+ * @file slog_cat.cpp
+ * @author LiuChuansen (179712066@qq.com)
+ * @brief 按时间段输出 File / JsonFile sink 的日志，借助时间索引只读取所需的部分
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * 用法：slog_cat [--from TIME] [--to TIME] [--index FILE] LOGFILE
+ *
+ * 日志文件和 "<LOGFILE>.idx" 均以 mmap 方式读取。索引中二分查找出起止偏移后，
+ * 只扫描这一段并按行首时间戳过滤；没有索引时退化为扫描整个文件。
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <string>
+
+#include <slog/sink_file.hpp>
+
+#include "log_scan.hpp"
+
+namespace {
+
+using slog::tools::MappedFile;
+using slog::tools::kStampSize;
+
+const char kStampPattern[] = "0000-00-00 00:00:00.000";
+const char kStampMin[]     = "0000-01-01 00:00:00.000";
+const char kStampMax[]     = "9999-12-31 23:59:59.999";
+
+void usage()
+{
+    std::cerr <<
+        "usage: slog_cat [--from TIME] [--to TIME] [--index FILE] LOGFILE\n"
+        "\n"
+        "TIME is local time 'YYYY-mm-dd[ HH:MM[:SS[.mmm]]]' or '@<unix seconds>';\n"
+        "--from is inclusive, --to includes the whole unit given (e.g. the whole second).\n"
+        "The index defaults to LOGFILE.idx, written by File::enable_time_index().\n";
+}
+
+/**
+ * @brief 把时间参数转换为定长时间戳文本
+ *
+ * 给出的部分覆盖模板的前缀，其余部分取 fill（kStampMin 或 kStampMax），
+ * 因此 --to "2026-10-17 12:00:05" 包含 12:00:05.999
+ */
+bool parse_time_arg(std::string const & arg, const char *fill, std::string *stamp)
+{
+    if (!arg.empty() && arg[0] == '@') {
+        char *end = nullptr;
+        errno = 0;
+        long long seconds = std::strtoll(arg.c_str() + 1, &end, 10);
+        if (errno != 0 || end == arg.c_str() + 1 || *end != '\0') {
+            return false;
+        }
+        std::time_t tt = static_cast<std::time_t>(seconds);
+        std::tm tm;
+        localtime_r(&tt, &tm);
+        char buf[64];
+        std::snprintf(buf, sizeof(buf), "%04d-%02d-%02d %02d:%02d:%02d",
+            tm.tm_year + 1900, tm.tm_mon + 1, tm.tm_mday, tm.tm_hour, tm.tm_min, tm.tm_sec);
+        *stamp = std::string(buf) + (fill + 19);
+        return true;
+    }
+
+    size_t len = arg.size();
+    if (len != 10 && len != 16 && len != 19 && (len < 21 || len > kStampSize)) {
+        return false;
+    }
+    std::string text = arg;
+    if (len > 10 && text[10] == 'T') {
+        text[10] = ' ';
+    }
+    for (size_t i = 0; i < len; ++i) {
+        bool digit = (text[i] >= '0' && text[i] <= '9');
+        if (kStampPattern[i] == '0' ? !digit : text[i] != kStampPattern[i]) {
+            return false;
+        }
+    }
+    *stamp = text + (fill + len);
+    return true;
+}
+
+/// 时间戳文本转换为 epoch 毫秒（本地时间）
+int64_t stamp_to_ms(std::string const & stamp)
+{
+    std::tm tm;
+    std::memset(&tm, 0, sizeof(tm));
+    tm.tm_year = std::atoi(stamp.substr(0, 4).c_str()) - 1900;
+    tm.tm_mon = std::atoi(stamp.substr(5, 2).c_str()) - 1;
+    tm.tm_mday = std::atoi(stamp.substr(8, 2).c_str());
+    tm.tm_hour = std::atoi(stamp.substr(11, 2).c_str());
+    tm.tm_min = std::atoi(stamp.substr(14, 2).c_str());
+    tm.tm_sec = std::atoi(stamp.substr(17, 2).c_str());
+    tm.tm_isdst = -1;
+    return static_cast<int64_t>(std::mktime(&tm)) * 1000 + std::atoi(stamp.substr(20, 3).c_str());
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::string from = kStampMin;
+    std::string to = kStampMax;
+    bool has_from = false;
+    bool has_to = false;
+    std::string index_path;
+    std::string log_path;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if ((arg == "--from" || arg == "--to" || arg == "--index") && i + 1 < argc) {
+            std::string value = argv[++i];
+            bool ok = true;
+            if (arg == "--from") {
+                ok = has_from = parse_time_arg(value, kStampMin, &from);
+            } else if (arg == "--to") {
+                ok = has_to = parse_time_arg(value, kStampMax, &to);
+            } else {
+                index_path = value;
+            }
+            if (!ok) {
+                std::cerr << "slog_cat: invalid time '" << value << "'" << std::endl;
+                return 2;
+            }
+        } else if (arg == "-h" || arg == "--help") {
+            usage();
+            return 0;
+        } else if (log_path.empty() && !arg.empty() && arg[0] != '-') {
+            log_path = arg;
+        } else {
+            usage();
+            return 2;
+        }
+    }
+    if (log_path.empty()) {
+        usage();
+        return 2;
+    }
+
+    MappedFile log;
+    if (!log.open(log_path)) {
+        std::cerr << "slog_cat: cannot open " << log_path << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+    if (log.size() == 0) {
+        return 0;
+    }
+
+    // 在索引中二分查找扫描范围
+    size_t begin = 0;
+    size_t end = log.size();
+    MappedFile index;
+    if (index_path.empty()) {
+        index_path = log_path + ".idx";
+    }
+    if (index.open(index_path) && index.size() >= sizeof(slog::sink::kTimeIndexMagic) &&
+        std::memcmp(index.data(), slog::sink::kTimeIndexMagic, sizeof(slog::sink::kTimeIndexMagic)) == 0)
+    {
+        auto entries = reinterpret_cast<const slog::sink::TimeIndexEntry *>(index.data() + sizeof(slog::sink::kTimeIndexMagic));
+        size_t count = (index.size() - sizeof(slog::sink::kTimeIndexMagic)) / sizeof(slog::sink::TimeIndexEntry);
+        auto last = entries + count;
+        auto by_time = [](slog::sink::TimeIndexEntry const & entry, int64_t ms) { return entry.timestamp_ms < ms; };
+
+        if (has_from) {
+            // 索引时间是该记录及之前各行日志时间的最大值，前一条记录之前的行必然早于 from
+            auto it = std::lower_bound(entries, last, stamp_to_ms(from), by_time);
+            if (it != entries) {
+                begin = std::min(static_cast<size_t>((it - 1)->offset), log.size());
+            }
+        }
+        if (has_to && count > 0) {
+            // 晚写入的行可能比前面的行早，最多早最后一条记录的 max_lag_ms，
+            // 时间超过 to + max_lag_ms 的记录之后不再有需要输出的行
+            auto it = std::lower_bound(entries, last, stamp_to_ms(to) + (last - 1)->max_lag_ms + 1, by_time);
+            if (it != last) {
+                end = std::min(static_cast<size_t>(it->offset), log.size());
+            }
+        }
+    } else if (index.size() > 0) {
+        std::cerr << "slog_cat: " << index_path << " is not a slog time index, scanning the whole file" << std::endl;
+    }
+    if (begin >= end) {
+        return 0;
+    }
+    log.advise_sequential(begin, end - begin);
+
+    // 逐行过滤，连续的命中行合并成一次写出；没有时间戳的行跟随上一行
+    const char *data = log.data();
+    bool selected = false;
+    size_t run = begin;
+    size_t pos = begin;
+    char stamp[kStampSize];
+    while (pos < end) {
+        const char *eol = static_cast<const char *>(std::memchr(data + pos, '\n', end - pos));
+        size_t next = (eol != nullptr) ? static_cast<size_t>(eol - data) + 1 : end;
+
+        bool keep = selected;
+        if (slog::tools::line_stamp(data + pos, next - pos, stamp)) {
+            keep = std::memcmp(stamp, from.data(), kStampSize) >= 0 && std::memcmp(stamp, to.data(), kStampSize) <= 0;
+        }
+        if (keep != selected) {
+            if (selected) {
+                std::fwrite(data + run, 1, pos - run, stdout);
+            }
+            run = pos;
+            selected = keep;
+        }
+        pos = next;
+    }
+    if (selected) {
+        std::fwrite(data + run, 1, end - run, stdout);
+    }
+    return std::fflush(stdout) == 0 ? 0 : 1;
+}
@@ -0,0 +1,391 @@
+/**
+ * @file slog_grep.cpp
+ * @author LiuChuansen (179712066@qq.com)
+ * @brief 在 File sink 的文本日志中查找记录，可按等级和 logger 过滤
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * 用法：slog_grep [-l LEVEL[+]] [-g LOGGER[*]] [-c] [-j N] [--no-rotated] PATTERN FILE...
+ *
+ * 与通用的 grep 相比利用了日志格式：
+ * - 等级和 logger 位于行首固定位置，只需比较几个字节；没有 PATTERN 时直接查找 "<ERROR> (name) " 这样的头部子串
+ * - 以记录为单位输出，多行消息的后续行与首行一起命中
+ * - 文件按记录边界切块，多线程查找，按原顺序输出
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <slog/slog.hpp>
+
+#include "log_scan.hpp"
+
+namespace {
+
+using slog::tools::MappedFile;
+using slog::tools::kMaxLevelPos;
+
+/// 每块至少 4MB，块太小时线程调度的开销超过查找本身
+constexpr size_t kMinChunkSize = 4 * 1024 * 1024;
+
+void usage()
+{
+    std::cerr <<
+        "usage: slog_grep [options] PATTERN FILE...\n"
+        "\n"
+        "Print log records (a header line and its continuation lines) containing PATTERN.\n"
+        "PATTERN is a plain string and may be empty when filtering by level or logger.\n"
+        "Each FILE is searched together with its rotated files, oldest first.\n"
+        "\n"
+        "options:\n"
+        "  -l LEVEL      only records of LEVEL (trace/debug/info/warn/error)\n"
+        "  -l LEVEL+     only records of LEVEL or above\n"
+        "  -g NAME       only records of logger NAME; NAME* matches a prefix\n"
+        "  -c            print the number of matching records\n"
+        "  -j N          number of threads (default: hardware concurrency)\n"
+        "  --no-rotated  do not search FILE.1, FILE.2, ...\n";
+}
+
+/// 日志行头部中的等级名（log_level_name() 的输出）
+slog::LogLevel header_level(const char *name, size_t len)
+{
+    for (int i = static_cast<int>(slog::LogLevel::Trace); i <= static_cast<int>(slog::LogLevel::Error); ++i) {
+        const char *text = slog::log_level_name(static_cast<slog::LogLevel>(i));
+        if (std::strlen(text) == len && std::memcmp(text, name, len) == 0) {
+            return static_cast<slog::LogLevel>(i);
+        }
+    }
+    return slog::LogLevel::Unknown;
+}
+
+/// 按日志行头部过滤
+struct HeaderFilter
+{
+    slog::LogLevel level = slog::LogLevel::Unknown;
+    bool at_least = false;          ///< level 及以上
+    std::string logger;
+    bool logger_prefix = false;
+
+    bool empty() const
+    {
+        return level == slog::LogLevel::Unknown && logger.empty();
+    }
+
+    /// rec 为带时间戳的行首
+    bool match(const char *rec, const char *end) const
+    {
+        if (empty()) {
+            return true;
+        }
+        size_t avail = static_cast<size_t>(end - rec);
+        if (!slog::tools::has_stamp(rec, avail)) {
+            return false;
+        }
+        size_t pos = slog::tools::level_pos(rec, avail);
+        if (pos == 0) {
+            return false;
+        }
+        // "<LEVEL> (" 中的 '>'，等级名最长 5 个字符
+        const char *name = rec + pos + 1;
+        const char *limit = rec + std::min(avail, pos + 8);
+        const char *gt = static_cast<const char *>(std::memchr(name, '>', static_cast<size_t>(limit - name)));
+        if (gt == nullptr) {
+            return false;
+        }
+
+        if (level != slog::LogLevel::Unknown) {
+            slog::LogLevel found = header_level(name, static_cast<size_t>(gt - name));
+            if (found == slog::LogLevel::Unknown) {
+                return false;
+            }
+            if (at_least ? found < level : found != level) {
+                return false;
+            }
+        }
+
+        if (!logger.empty()) {
+            const char *p = gt + 1;
+            size_t need = 2 + logger.size() + (logger_prefix ? 0 : 2);
+            if (static_cast<size_t>(end - p) < need || p[0] != ' ' || p[1] != '(' ||
+                std::memcmp(p + 2, logger.data(), logger.size()) != 0)
+            {
+                return false;
+            }
+            if (!logger_prefix && (p[2 + logger.size()] != ')' || p[3 + logger.size()] != ' ')) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+struct Options
+{
+    std::string pattern;
+    HeaderFilter filter;
+    bool count_only = false;
+    bool rotated = true;
+    unsigned threads = 0;
+};
+
+/// 查找方式
+enum class Mode
+{
+    Pattern,    ///< 查找 PATTERN，再检查所在记录的头部
+    Header,     ///< 没有 PATTERN，直接查找头部子串，再确认它位于行首的固定位置
+    Scan,       ///< 逐条记录检查头部
+};
+
+struct Chunk
+{
+    const MappedFile *file;
+    const char *begin;
+    const char *end;
+
+    // 结果：合并后的命中区间（指向映射内存）和记录数
+    std::vector<std::pair<const char *, const char *>> spans;
+    size_t records = 0;
+    bool done = false;
+};
+
+class Searcher
+{
+public:
+    explicit Searcher(Options const & options)
+        : options_(options)
+        , mode_(Mode::Scan)
+    {
+        HeaderFilter const & filter = options_.filter;
+        if (!options_.pattern.empty()) {
+            mode_ = Mode::Pattern;
+            needle_ = options_.pattern;
+        } else if (filter.level != slog::LogLevel::Unknown && !filter.at_least) {
+            mode_ = Mode::Header;
+            needle_ = std::string("<") + slog::log_level_name(filter.level) + "> ";
+            if (!filter.logger.empty()) {
+                needle_ += "(" + filter.logger + (filter.logger_prefix ? "" : ") ");
+            }
+        } else if (!filter.logger.empty()) {
+            mode_ = Mode::Header;
+            needle_ = "> (" + filter.logger + (filter.logger_prefix ? "" : ") ");
+        }
+    }
+
+    void search(Chunk & chunk) const
+    {
+        if (mode_ == Mode::Scan) {
+            scan(chunk);
+            return;
+        }
+
+        const char *begin = chunk.begin;
+        const char *end = chunk.end;
+        const char *p = begin;
+        while (p < end) {
+            const char *hit = slog::tools::find_substring(p, static_cast<size_t>(end - p), needle_.data(), needle_.size());
+            if (hit == nullptr) {
+                break;
+            }
+
+            const char *rec;
+            if (mode_ == Mode::Header) {
+                // 头部子串必须落在带时间戳的行的等级位置附近，否则是消息中的文本
+                rec = slog::tools::line_start(hit, begin);
+                if (static_cast<size_t>(hit - rec) > kMaxLevelPos + 7 || !options_.filter.match(rec, end)) {
+                    p = hit + 1;
+                    continue;
+                }
+            } else {
+                rec = slog::tools::record_start(hit, begin, end);
+            }
+
+            const char *rec_end = slog::tools::next_record(slog::tools::next_line(hit, end), begin, end);
+            if (mode_ == Mode::Header || options_.filter.match(rec, end)) {
+                add(chunk, rec, rec_end);
+            }
+            p = rec_end;
+        }
+    }
+
+private:
+    Options const & options_;
+    Mode mode_;
+    std::string needle_;
+
+    void scan(Chunk & chunk) const
+    {
+        const char *p = chunk.begin;
+        while (p < chunk.end) {
+            const char *rec_end = slog::tools::next_record(slog::tools::next_line(p, chunk.end), chunk.begin, chunk.end);
+            if (options_.filter.match(p, chunk.end)) {
+                add(chunk, p, rec_end);
+            }
+            p = rec_end;
+        }
+    }
+
+    static void add(Chunk & chunk, const char *begin, const char *end)
+    {
+        chunk.records++;
+        if (!chunk.spans.empty() && chunk.spans.back().second == begin) {
+            chunk.spans.back().second = end;
+        } else {
+            chunk.spans.emplace_back(begin, end);
+        }
+    }
+};
+
+/// 把文件切成若干块，块边界移到下一条记录的开头
+void split(MappedFile const & file, size_t parts, std::vector<std::unique_ptr<Chunk>> & chunks)
+{
+    if (file.size() == 0) {
+        return;
+    }
+    const char *data = file.data();
+    const char *end = data + file.size();
+    parts = std::max<size_t>(1, std::min(parts, file.size() / kMinChunkSize));
+
+    const char *begin = data;
+    for (size_t i = 1; i <= parts; ++i) {
+        const char *cut = (i == parts) ? end : slog::tools::next_record(data + file.size() / parts * i, data, end);
+        if (cut > begin) {
+            chunks.emplace_back(new Chunk{&file, begin, cut, {}, 0, false});
+            begin = cut;
+        }
+    }
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    Options options;
+    std::vector<std::string> args;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "-l" && i + 1 < argc) {
+            std::string value = argv[++i];
+            options.filter.at_least = (!value.empty() && value.back() == '+');
+            if (options.filter.at_least) {
+                value.pop_back();
+            }
+            options.filter.level = slog::log_level_from_name(value);
+            if (options.filter.level == slog::LogLevel::Unknown || options.filter.level == slog::LogLevel::Off) {
+                std::cerr << "slog_grep: invalid level '" << argv[i] << "'" << std::endl;
+                return 2;
+            }
+        } else if (arg == "-g" && i + 1 < argc) {
+            options.filter.logger = argv[++i];
+            options.filter.logger_prefix = (!options.filter.logger.empty() && options.filter.logger.back() == '*');
+            if (options.filter.logger_prefix) {
+                options.filter.logger.pop_back();
+            }
+        } else if (arg == "-j" && i + 1 < argc) {
+            options.threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        } else if (arg == "-c") {
+            options.count_only = true;
+        } else if (arg == "--no-rotated") {
+            options.rotated = false;
+        } else if (arg == "-h" || arg == "--help") {
+            usage();
+            return 0;
+        } else if (arg == "--") {
+            args.insert(args.end(), argv + i + 1, argv + argc);
+            break;
+        } else if (arg.size() > 1 && arg[0] == '-') {
+            usage();
+            return 2;
+        } else {
+            args.push_back(arg);
+        }
+    }
+    if (args.size() < 2) {
+        usage();
+        return 2;
+    }
+    options.pattern = args[0];
+    if (options.threads == 0) {
+        options.threads = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    // 映射所有文件（含轮转文件），按时间顺序切块
+    std::vector<std::unique_ptr<MappedFile>> files;
+    std::vector<std::unique_ptr<Chunk>> chunks;
+    bool open_failed = false;
+    for (size_t i = 1; i < args.size(); ++i) {
+        std::vector<std::string> paths = options.rotated ? slog::tools::rotation_set(args[i]) : std::vector<std::string>{args[i]};
+        for (auto const & path : paths) {
+            std::unique_ptr<MappedFile> file(new MappedFile);
+            if (!file->open(path)) {
+                std::cerr << "slog_grep: cannot open " << path << ": " << std::strerror(errno) << std::endl;
+                open_failed = true;
+                continue;
+            }
+            file->advise_sequential(0, file->size());
+            split(*file, options.threads * 4, chunks);
+            files.push_back(std::move(file));
+        }
+    }
+
+    // 工作线程按顺序领取块；主线程按块的顺序等待并输出
+    Searcher searcher(options);
+    std::atomic<size_t> next(0);
+    std::mutex mutex;
+    std::condition_variable cond;
+    std::vector<std::thread> workers;
+    unsigned thread_count = static_cast<unsigned>(std::min<size_t>(options.threads, chunks.size()));
+    for (unsigned t = 0; t < thread_count; ++t) {
+        workers.emplace_back([&]() {
+            for (size_t i = next++; i < chunks.size(); i = next++) {
+                searcher.search(*chunks[i]);
+                std::lock_guard<std::mutex> lock(mutex);
+                chunks[i]->done = true;
+                cond.notify_all();
+            }
+        });
+    }
+
+    size_t total = 0;
+    for (auto & chunk : chunks) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            cond.wait(lock, [&chunk]() { return chunk->done; });
+        }
+        total += chunk->records;
+        if (!options.count_only) {
+            for (auto const & span : chunk->spans) {
+                std::fwrite(span.first, 1, static_cast<size_t>(span.second - span.first), stdout);
+                if (span.second[-1] != '\n') {
+                    std::fputc('\n', stdout);
+                }
+            }
+        }
+        // 输出完即释放结果
+        std::vector<std::pair<const char *, const char *>>().swap(chunk->spans);
+    }
+    for (auto & worker : workers) {
+        worker.join();
+    }
+
+    if (options.count_only) {
+        std::printf("%zu\n", total);
+    }
+    if (std::fflush(stdout) != 0 || open_failed) {
+        return 2;
+    }
+    return (total > 0) ? 0 : 1;
+}
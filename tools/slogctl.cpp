@@ -0,0 +1,80 @@
+/**
+ * @file slogctl.cpp
+ * @author LiuChuansen (179712066@qq.com)
+ * @brief 通过控制套接字查看和调整运行中进程的日志
+ * @version 0.1
+ * @date 2026-10-17
+ *
+ * @copyright Copyright (c) 2026
+ *
+ * 用法：slogctl (-p PID | -s SOCKET) COMMAND [ARGS...]
+ */
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+#include <slog/control.hpp>
+
+namespace {
+
+void usage()
+{
+    std::cerr <<
+        "usage: slogctl (-p PID | -s SOCKET) COMMAND [ARGS...]\n"
+        "\n"
+        "commands:\n"
+        "  list                    list loggers and their effective levels\n"
+        "  get <name>              show the effective level of a logger\n"
+        "  set <pattern> <level>   add a level rule (exact, wildcard or regex)\n"
+        "  apply <rules>           apply rule text, e.g. \"net_*:debug;db:trace\"\n"
+        "  rules                   list level rules\n"
+        "  clear-rules             remove all level rules\n"
+        "  flush [name]            flush one or all loggers\n"
+        "  stats [name]            show sinks, levels and counters\n";
+}
+
+} // namespace
+
+int main(int argc, char **argv)
+{
+    std::string socket_path;
+    int i = 1;
+    for (; i < argc; ++i) {
+        if (std::strcmp(argv[i], "-p") == 0 && i + 1 < argc) {
+            socket_path = slog::default_control_socket_path(std::atol(argv[++i]));
+        } else if (std::strcmp(argv[i], "-s") == 0 && i + 1 < argc) {
+            socket_path = argv[++i];
+        } else if (std::strcmp(argv[i], "-h") == 0 || std::strcmp(argv[i], "--help") == 0) {
+            usage();
+            return 0;
+        } else {
+            break;
+        }
+    }
+    if (socket_path.empty() || i >= argc) {
+        usage();
+        return 2;
+    }
+
+    std::string command = argv[i++];
+    for (; i < argc; ++i) {
+        command += ' ';
+        command += argv[i];
+    }
+
+    std::string response;
+    if (!slog::control_request(socket_path, command, &response)) {
+        std::cerr << "slogctl: cannot talk to " << socket_path << ": " << std::strerror(errno) << std::endl;
+        return 1;
+    }
+
+    if (response.compare(0, 3, "OK\n") == 0) {
+        std::cout << response.substr(3);
+        return 0;
+    }
+    std::cerr << "slogctl: " << response;
+    return 1;
+}